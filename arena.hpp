@@ -0,0 +1,265 @@
+/**
+ * 实现arena
+ * basic_arena / arena / monotonic_arena
+ * arena_delete
+ *
+ * 按块做指针递增分配，请求结束时release()一次性归还全部内存；
+ * arena中构造的对象通过unique_ptr<T, arena_delete<T>>持有，析构时只调用析构函数，
+ * arena只在释放的是最近一次分配时回退指针，monotonic_arena的释放为空操作
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef ARENA_HPP_
+#define ARENA_HPP_
+
+#include "memory.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ycstl {
+
+//每块内存的头部，块之间单向链接，最新的块在表头
+struct ArenaBlock {
+    ArenaBlock* next_;
+    std::size_t size_;
+};
+
+template<bool Monotonic>
+class basic_arena {
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type kDefaultBlockSize = 4096;
+
+    explicit basic_arena(size_type block_size = kDefaultBlockSize) noexcept
+        : head_(nullptr), cur_(nullptr), end_(nullptr),
+          next_block_size_(block_size < kMinBlockSize ? kMinBlockSize : block_size), used_(0) {}
+
+    ~basic_arena() {
+        free_blocks(head_);
+    }
+
+    basic_arena(const basic_arena&) = delete;
+    basic_arena& operator=(const basic_arena&) = delete;
+
+    // align必须是2的幂
+    void* allocate(size_type bytes, size_type align = alignof(std::max_align_t)) {
+        //先比较补齐量再比较bytes，补齐后越过end_时不能算出负的剩余空间
+        size_type padding = align_padding(cur_, align);
+        size_type available = static_cast<size_type>(end_ - cur_);
+        if (nullptr == cur_ || padding > available || bytes > available - padding) {
+            grow(bytes + align);
+            padding = align_padding(cur_, align);
+        }
+        char* p = cur_ + padding;
+        cur_ = p + bytes;
+        used_ += bytes;
+        return p;
+    }
+
+    //释放的是最后一次分配时回退指针，其余情况内存留到release()时统一归还
+    void deallocate(void* p, size_type bytes, size_type = alignof(std::max_align_t)) noexcept {
+        if constexpr (!Monotonic) {
+            if (static_cast<char*>(p) + bytes == cur_) {
+                cur_ = static_cast<char*>(p);
+            }
+        }
+        used_ -= bytes;
+    }
+
+    //保留最新(最大)的一块，其余全部释放；arena中的对象此后不能再访问
+    void release() noexcept {
+        if (nullptr == head_) {
+            return;
+        }
+        free_blocks(head_->next_);
+        head_->next_ = nullptr;
+        cur_ = block_begin(head_);
+        end_ = reinterpret_cast<char*>(head_) + head_->size_;
+        used_ = 0;
+    }
+
+    //当前未释放的字节数
+    size_type used() const noexcept {
+        return used_;
+    }
+
+    //向系统申请的总字节数
+    size_type capacity() const noexcept {
+        size_type total = 0;
+        for (ArenaBlock* block = head_; nullptr != block; block = block->next_) {
+            total += block->size_;
+        }
+        return total;
+    }
+
+private:
+    static constexpr size_type kHeaderSize =
+        (sizeof(ArenaBlock) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    static constexpr size_type kMinBlockSize = 256;
+
+    static size_type align_padding(char* p, size_type align) noexcept {
+        std::uintptr_t v = reinterpret_cast<std::uintptr_t>(p);
+        return static_cast<size_type>(((v + align - 1) & ~(std::uintptr_t(align) - 1)) - v);
+    }
+
+    static char* block_begin(ArenaBlock* block) noexcept {
+        return reinterpret_cast<char*>(block) + kHeaderSize;
+    }
+
+    static void free_blocks(ArenaBlock* block) noexcept {
+        while (nullptr != block) {
+            ArenaBlock* next = block->next_;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+
+    //块大小按2倍增长，保证大对象也能放下
+    void grow(size_type min_bytes) {
+        size_type size = next_block_size_;
+        while (size - kHeaderSize < min_bytes) {
+            size *= 2;
+        }
+        ArenaBlock* block = static_cast<ArenaBlock*>(::operator new(size));
+        block->next_ = head_;
+        block->size_ = size;
+        head_ = block;
+        cur_ = block_begin(block);
+        end_ = reinterpret_cast<char*>(block) + size;
+        next_block_size_ = size * 2;
+    }
+
+    ArenaBlock* head_;
+    char* cur_;
+    char* end_;
+    size_type next_block_size_;
+    size_type used_;
+};
+
+using arena = basic_arena<false>;
+using monotonic_arena = basic_arena<true>;
+
+//析构对象后把内存交还给arena
+template<typename T, typename Arena = arena>
+class arena_delete {
+public:
+    arena_delete() noexcept : arena_(nullptr) {}
+
+    explicit arena_delete(Arena& a) noexcept : arena_(&a) {}
+
+    void operator()(T* ptr) const noexcept {
+        if (nullptr != ptr) {
+            std::destroy_at(ptr);
+            arena_->deallocate(ptr, sizeof(T), alignof(T));
+        }
+    }
+
+    Arena* get_arena() const noexcept {
+        return arena_;
+    }
+
+private:
+    Arena* arena_;
+};
+
+template<typename T, typename Arena>
+class arena_delete<T[], Arena> {
+public:
+    arena_delete() noexcept : arena_(nullptr), size_(0) {}
+
+    arena_delete(Arena& a, std::size_t size) noexcept : arena_(&a), size_(size) {}
+
+    void operator()(T* ptr) const noexcept {
+        if (nullptr != ptr) {
+            std::destroy(ptr, ptr + size_);
+            arena_->deallocate(ptr, sizeof(T) * size_, alignof(T));
+        }
+    }
+
+    Arena* get_arena() const noexcept {
+        return arena_;
+    }
+
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+private:
+    Arena* arena_;
+    std::size_t size_;
+};
+
+template<typename T, typename Arena = arena>
+using arena_unique_ptr = unique_ptr<T, arena_delete<T, Arena>>;
+
+//在arena中构造对象
+template<typename T, bool Monotonic, typename... Args, typename = std::enable_if_t<!std::is_array<T>::value>>
+arena_unique_ptr<T, basic_arena<Monotonic>> make_arena_unique(basic_arena<Monotonic>& a, Args&&... args) {
+    void* mem = a.allocate(sizeof(T), alignof(T));
+    T* p;
+    try {
+        p = ::new (mem) T(std::forward<Args>(args)...);
+    } catch (...) {
+        a.deallocate(mem, sizeof(T), alignof(T));
+        throw;
+    }
+    return arena_unique_ptr<T, basic_arena<Monotonic>>(p, arena_delete<T, basic_arena<Monotonic>>(a));
+}
+
+template<typename T, bool Monotonic, typename = std::enable_if_t<std::is_array_v<T>>>
+arena_unique_ptr<T, basic_arena<Monotonic>> make_arena_unique(basic_arena<Monotonic>& a, std::size_t size) {
+    using ElementType = std::remove_extent_t<T>;
+    ElementType* p = static_cast<ElementType*>(a.allocate(sizeof(ElementType) * size, alignof(ElementType)));
+    std::size_t i = 0;
+    try {
+        for (; i != size; ++i) {
+            ::new (static_cast<void*>(p + i)) ElementType();
+        }
+    } catch (...) {
+        std::destroy(p, p + i);
+        a.deallocate(p, sizeof(ElementType) * size, alignof(ElementType));
+        throw;
+    }
+    return arena_unique_ptr<T, basic_arena<Monotonic>>(p, arena_delete<T, basic_arena<Monotonic>>(a, size));
+}
+
+template<typename T, bool Monotonic, typename = std::enable_if_t<!std::is_array<T>::value>>
+arena_unique_ptr<T, basic_arena<Monotonic>> make_arena_unique_for_overwrite(basic_arena<Monotonic>& a) {
+    void* mem = a.allocate(sizeof(T), alignof(T));
+    T* p;
+    try {
+        p = ::new (mem) T;
+    } catch (...) {
+        a.deallocate(mem, sizeof(T), alignof(T));
+        throw;
+    }
+    return arena_unique_ptr<T, basic_arena<Monotonic>>(p, arena_delete<T, basic_arena<Monotonic>>(a));
+}
+
+template<typename T, bool Monotonic, typename = std::enable_if_t<std::is_array_v<T>>>
+arena_unique_ptr<T, basic_arena<Monotonic>> make_arena_unique_for_overwrite(basic_arena<Monotonic>& a, std::size_t size) {
+    using ElementType = std::remove_extent_t<T>;
+    ElementType* p = static_cast<ElementType*>(a.allocate(sizeof(ElementType) * size, alignof(ElementType)));
+    std::size_t i = 0;
+    try {
+        for (; i != size; ++i) {
+            ::new (static_cast<void*>(p + i)) ElementType;
+        }
+    } catch (...) {
+        std::destroy(p, p + i);
+        a.deallocate(p, sizeof(ElementType) * size, alignof(ElementType));
+        throw;
+    }
+    return arena_unique_ptr<T, basic_arena<Monotonic>>(p, arena_delete<T, basic_arena<Monotonic>>(a, size));
+}
+
+}   //ycstl
+
+#endif
@@ -1,18 +1,27 @@
 /**
  * 实现array
  * 
+ * 所有操作都是constexpr，可以在编译期生成查表数据
+ * 
  * @author YC奕晨 
  * */ 
-
+ 
  #ifndef ARRAY_HPP_
  #define ARRAY_HPP_
  
+ #include <algorithm>
+ #include <functional>
  #include <iostream>
- #include <memory>
+ #include <iterator>
  #include <stdexcept>
+ #include <type_traits>
+ #include <utility>
  
  namespace ycstl {
  
+ template<typename E>
+ struct vector_expression;
+ 
  template<class T, std::size_t N> 
  
  class array {
@@ -23,156 +32,199 @@
      using const_pointer          = const T*;
      using reference              = T&;
      using const_reference        = const T&;
-     using size_type              = size_t;
-     using difference_type        = ptrdiff_t;
+     using size_type              = std::size_t;
+     using difference_type        = std::ptrdiff_t;
      using iterator               = T*;
      using const_iterator         = const T*;
      using reverse_iterator       = std::reverse_iterator<iterator>;
-     using const_reverse_iterator = const std::reverse_iterator<iterator>;
+     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
  
-     void fill(const T& u) {
-         for (size_t i = 0; i < N; ++i) {
+     constexpr void fill(const T& u) {
+         for (std::size_t i = 0; i < N; ++i) {
              data_[i] = u;
          }
      }
  
-     void swap(array<T,N>& arr) noexcept {
-         for (size_t i = 0; i < N; ++i) {
-             T temp = arr[i];
-             arr[i] = data_[i];
-             data_[i] = temp;
+     constexpr void swap(array<T,N>& arr) noexcept(std::is_nothrow_swappable_v<T>) {
+         for (std::size_t i = 0; i < N; ++i) {
+             using std::swap;
+             swap(data_[i], arr.data_[i]);
          }
      }
  
-     T& operator[](std::size_t pos) {
+     //numeric.hpp中的表达式，长度不是N时抛出std::length_error
+     template<typename E>
+     constexpr array& operator=(const vector_expression<E>& e) {
+         if (e.size() != N) {
+             throw std::length_error("expression length differs from array size");
+         }
+         e.assign_to(data_);
+         return *this;
+     }
+ 
+     //std::sort在C++20中是constexpr，常量求值中同样可用
+     constexpr void sort() {
+         sort(std::less<>());
+     }
+ 
+     template<typename Compare>
+     constexpr void sort(Compare comp) {
+         std::sort(begin(), end(), comp);
+     }
+ 
+     constexpr T& operator[](std::size_t pos) {
          return data_[pos];
      } 
  
-     const T& operator[](std::size_t pos) const {
+     constexpr const T& operator[](std::size_t pos) const {
          return data_[pos];
      }
  
-     T& at(std::size_t pos) {
+     constexpr T& at(std::size_t pos) {
          if (pos >= N) {
              throw std::out_of_range("out of range");
          }
          return data_[pos];
      }
  
-     const T& at(std::size_t pos) const {
+     constexpr const T& at(std::size_t pos) const {
          if (pos >= N) {
              throw std::out_of_range("out of range");
          }
          return data_[pos];
      }
  
-     T& front() {
+     constexpr T& front() {
          return data_[0];
      }
  
-     const T& front() const {
+     constexpr const T& front() const {
          return data_[0];
      }
  
-     T& back() {
+     constexpr T& back() {
          return data_[N-1];
      }
  
-     const T& back() const {
+     constexpr const T& back() const {
          return data_[N-1];
      }
  
-     T* begin() noexcept {
-         return &data_[0];
+     constexpr T* begin() noexcept {
+         return data();
      }
  
-     T* end() noexcept {
-         return &data_[N];
+     constexpr T* end() noexcept {
+         return data() + N;
      }
  
-     const T* begin() const noexcept {
-         return &data_[0];
+     constexpr const T* begin() const noexcept {
+         return data();
      }
  
-     const T* end() const noexcept {
-         return &data_[N];
+     constexpr const T* end() const noexcept {
+         return data() + N;
      }
  
-     reverse_iterator rbegin() noexcept {
-         if (0 == N) {
-             return std::reverse_iterator<iterator>(nullptr);
-         } 
-         return std::reverse_iterator<iterator>(&data_[N]);
+     constexpr reverse_iterator rbegin() noexcept {
+         return reverse_iterator(end());
      }
  
-     reverse_iterator rend() noexcept {
-         if (0 == N) {
-             return std::reverse_iterator<iterator>(nullptr);
-         } 
-         return std::reverse_iterator<iterator>(&data_[0]);
+     constexpr reverse_iterator rend() noexcept {
+         return reverse_iterator(begin());
      }
  
-     const_reverse_iterator rbegin() const noexcept {
-         if (0 == N) {
-             return std::reverse_iterator<iterator>(nullptr);
-         } 
-         return std::reverse_iterator<iterator>(&data_[N]);
+     constexpr const_reverse_iterator rbegin() const noexcept {
+         return const_reverse_iterator(end());
      }
  
-     const_reverse_iterator rend() const noexcept {
-         if (0 == N) {
-             return std::reverse_iterator<iterator>(nullptr);
-         } 
-         return std::reverse_iterator<iterator>(&data_[0]);
+     constexpr const_reverse_iterator rend() const noexcept {
+         return const_reverse_iterator(begin());
      }
  
-     const_iterator cbegin() const noexcept {
-         return &data_[0];
+     constexpr const_iterator cbegin() const noexcept {
+         return begin();
      }
  
-     const_iterator cend() const noexcept {
-         return &data_[N];
+     constexpr const_iterator cend() const noexcept {
+         return end();
      }
  
-     const_reverse_iterator crbegin() const noexcept {
-         if (0 == N) {
-             return std::reverse_iterator<iterator>(nullptr);
-         } 
-         return std::reverse_iterator<iterator>(&data_[N]);
+     constexpr const_reverse_iterator crbegin() const noexcept {
+         return rbegin();
      }
  
-     const_reverse_iterator crend() const noexcept {
-         if (0 == N) {
-             return std::reverse_iterator<iterator>(nullptr);
-         } 
-         return std::reverse_iterator<iterator>(&data_[0]);
+     constexpr const_reverse_iterator crend() const noexcept {
+         return rend();
      }
  
-     std::size_t size() {
+     constexpr std::size_t size() const noexcept {
          return N;
      }
  
-     bool empty() const noexcept {
+     constexpr std::size_t max_size() const noexcept {
+         return N;
+     }
+ 
+     constexpr bool empty() const noexcept {
          return N == 0;
      }
  
-     T* data() noexcept {
-         if (0 == N) {
+     constexpr T* data() noexcept {
+         if constexpr (0 == N) {
              return nullptr;
+         } else {
+             return data_;
          }
-         return &data_[0];
      }
  
-     const T* data() const noexcept {
-         if (0 == N) {
+     constexpr const T* data() const noexcept {
+         if constexpr (0 == N) {
              return nullptr;
+         } else {
+             return data_;
          }
-         return &data_[0];
      }
  
-     T data_[N];
+     //N为0时仍保留一个元素，避免零长数组
+     T data_[N == 0 ? 1 : N];
  };
  
+ template<typename T, std::size_t N>
+ constexpr void swap(array<T,N>& lhs, array<T,N>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+     lhs.swap(rhs);
+ }
+ 
+ template<typename T, std::size_t N>
+ constexpr bool operator==(const array<T,N>& lhs, const array<T,N>& rhs) {
+     return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+ }
+ 
+ template<typename T, std::size_t N>
+ constexpr bool operator!=(const array<T,N>& lhs, const array<T,N>& rhs) {
+     return !(lhs == rhs);
+ }
+ 
+ template<typename T, std::size_t N>
+ constexpr bool operator<(const array<T,N>& lhs, const array<T,N>& rhs) {
+     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+ }
+ 
+ template<typename T, std::size_t N>
+ constexpr bool operator>(const array<T,N>& lhs, const array<T,N>& rhs) {
+     return rhs < lhs;
+ }
+ 
+ template<typename T, std::size_t N>
+ constexpr bool operator<=(const array<T,N>& lhs, const array<T,N>& rhs) {
+     return !(rhs < lhs);
+ }
+ 
+ template<typename T, std::size_t N>
+ constexpr bool operator>=(const array<T,N>& lhs, const array<T,N>& rhs) {
+     return !(lhs < rhs);
+ }
+ 
  template<typename T, std::size_t N>
  std::ostream& operator<<(std::ostream& os, const array<T,N>& arr) {
      os << "{";
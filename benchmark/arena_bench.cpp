@@ -0,0 +1,99 @@
+/**
+ * make_unique / make_unique_for_overwrite / arena 分配对比
+ *
+ * 编译: g++ -std=c++20 -O2 -I.. arena_bench.cpp -o arena_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "arena.hpp"
+#include "memory.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+constexpr std::size_t kBufferSize = 1 << 16;
+constexpr std::size_t kBufferRounds = 1 << 14;
+constexpr std::size_t kRequests = 1 << 16;
+constexpr std::size_t kObjectsPerRequest = 32;
+
+struct Node {
+    std::uint64_t key_;
+    std::uint64_t value_;
+    Node* next_;
+};
+
+template<typename Function>
+double time_ms(Function f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//分配缓冲区后立即整体写入，值初始化的清零是多余的
+template<typename Make>
+void bench_buffer(const char* name, Make make) {
+    std::uint64_t sink = 0;
+    double ms = time_ms([&] {
+        for (std::size_t i = 0; i != kBufferRounds; ++i) {
+            auto buffer = make();
+            std::memset(buffer.get(), static_cast<int>(i), kBufferSize);
+            sink += static_cast<unsigned char>(buffer[i % kBufferSize]);
+        }
+    });
+    std::cout << name << "  " << ms << " ms  (" << sink << ")\n";
+}
+
+//每个请求构造一批小对象，请求结束时全部释放
+void bench_heap_request() {
+    std::uint64_t sink = 0;
+    double ms = time_ms([&] {
+        for (std::size_t r = 0; r != kRequests; ++r) {
+            ycstl::unique_ptr<Node> objects[kObjectsPerRequest];
+            for (std::size_t i = 0; i != kObjectsPerRequest; ++i) {
+                objects[i] = ycstl::make_unique<Node>(Node{r, i, nullptr});
+                sink += objects[i]->value_;
+            }
+        }
+    });
+    std::cout << "request make_unique           " << ms << " ms  (" << sink << ")\n";
+}
+
+template<typename Arena>
+void bench_arena_request(const char* name) {
+    Arena a;
+    std::uint64_t sink = 0;
+    double ms = time_ms([&] {
+        for (std::size_t r = 0; r != kRequests; ++r) {
+            {
+                ycstl::arena_unique_ptr<Node, Arena> objects[kObjectsPerRequest];
+                for (std::size_t i = 0; i != kObjectsPerRequest; ++i) {
+                    objects[i] = ycstl::make_arena_unique<Node>(a, Node{r, i, nullptr});
+                    sink += objects[i]->value_;
+                }
+            }
+            a.release();
+        }
+    });
+    std::cout << name << ms << " ms  (" << sink << ")\n";
+}
+
+}
+
+int main() {
+    bench_buffer("buffer make_unique<char[]>    ", [] {
+        return ycstl::make_unique<char[]>(kBufferSize);
+    });
+    bench_buffer("buffer for_overwrite<char[]>  ", [] {
+        return ycstl::make_unique_for_overwrite<char[]>(kBufferSize);
+    });
+    bench_heap_request();
+    bench_arena_request<ycstl::arena>("request arena                 ");
+    bench_arena_request<ycstl::monotonic_arena>("request monotonic_arena       ");
+    return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * atomic_shared_ptr 与 互斥锁保护的shared_ptr 的读吞吐对比，同时有一个写线程持续发布新版本
+ *
+ * 编译: g++ -std=c++20 -O2 -pthread -I.. atomic_shared_ptr_bench.cpp -o atomic_shared_ptr_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "memory.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::chrono::milliseconds kDuration(200);
+constexpr std::size_t kMaxReaders = 64;
+
+struct RoutingTable {
+    explicit RoutingTable(long v) : version(v) {}
+    long version;
+    long routes[16] = {};
+};
+
+class MutexSlot {
+public:
+    ycstl::shared_ptr<RoutingTable> load() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return ptr_;
+    }
+
+    void store(ycstl::shared_ptr<RoutingTable> p) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ptr_ = std::move(p);
+    }
+
+private:
+    std::mutex mutex_;
+    ycstl::shared_ptr<RoutingTable> ptr_;
+};
+
+//返回每秒读取次数(百万)
+template<typename Slot>
+double run(std::size_t readers) {
+    Slot slot;
+    slot.store(ycstl::make_shared<RoutingTable>(0));
+    std::atomic<bool> stop(false);
+    std::atomic<std::size_t> total_reads(0);
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i != readers; ++i) {
+        workers.emplace_back([&] {
+            std::size_t reads = 0;
+            long sum = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                sum += slot.load()->version;
+                ++reads;
+            }
+            total_reads.fetch_add(reads + (sum < 0 ? 1 : 0));
+        });
+    }
+    std::thread writer([&] {
+        long version = 1;
+        while (!stop.load(std::memory_order_relaxed)) {
+            slot.store(ycstl::make_shared<RoutingTable>(version++));
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(kDuration);
+    stop = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    writer.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return total_reads.load() / elapsed.count() / 1e6;
+}
+
+}
+
+int main() {
+    for (std::size_t readers = 1; readers <= kMaxReaders; readers *= 2) {
+        double lock_free = run<ycstl::atomic_shared_ptr<RoutingTable>>(readers);
+        double locked = run<MutexSlot>(readers);
+        std::cout << "readers " << readers << "  atomic_shared_ptr " << lock_free
+                  << " Mreads/s  mutex+shared_ptr " << locked << " Mreads/s\n";
+    }
+    return 0;
+}
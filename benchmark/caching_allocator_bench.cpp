@@ -0,0 +1,75 @@
+/**
+ * caching_allocator 与 std::allocator 在多线程容器负载下的吞吐
+ *
+ * 编译: g++ -std=c++20 -O2 -pthread -I.. caching_allocator_bench.cpp -o caching_allocator_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "caching_allocator.hpp"
+#include "list.hpp"
+#include "vector.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kRoundsPerThread = 1 << 10;
+constexpr std::size_t kListNodes = 512;
+constexpr std::size_t kVectorSize = 1024;
+
+std::atomic<std::uint64_t> g_sink{0};     //防止循环被优化掉
+
+//每轮：list逐个push_back，vector逐个push_back触发多次expand，最后全部释放
+template<template<typename> class Alloc>
+std::uint64_t round(std::size_t seed) {
+    ycstl::list<std::uint64_t, Alloc<std::uint64_t>> items;
+    for (std::size_t i = 0; i != kListNodes; ++i) {
+        items.push_back(seed + i);
+    }
+    ycstl::vector<std::uint64_t, Alloc<std::uint64_t>> row;
+    for (std::size_t i = 0; i != kVectorSize; ++i) {
+        row.push_back(seed ^ i);
+    }
+    return items.back() + row.back();
+}
+
+template<template<typename> class Alloc>
+void run(const char* name, std::size_t threads) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t != threads; ++t) {
+        workers.emplace_back([t] {
+            std::uint64_t sink = 0;
+            for (std::size_t r = 0; r != kRoundsPerThread; ++r) {
+                sink += round<Alloc>(t * kRoundsPerThread + r);
+            }
+            g_sink.fetch_add(sink, std::memory_order_relaxed);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << "  threads " << threads << "  " << elapsed.count() << " ms\n";
+}
+
+}
+
+int main() {
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    if (0 == max_threads) {
+        max_threads = 1;
+    }
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        run<std::allocator>("std::allocator          ", threads);
+        run<ycstl::caching_allocator>("ycstl::caching_allocator", threads);
+    }
+    return 0;
+}
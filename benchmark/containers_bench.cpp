@@ -0,0 +1,283 @@
+/**
+ * ycstl::vector / list / array / unique_ptr 与 std 对应实现的成对比较
+ * 框架见harness.hpp，例如:
+ *   ./containers_bench --json=containers.json --max-ratio=1.5
+ *
+ * 编译: g++ -std=c++20 -O2 -I.. containers_bench.cpp -o containers_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "harness.hpp"
+
+#include "array.hpp"
+#include "list.hpp"
+#include "memory.hpp"
+#include "vector.hpp"
+
+#include <array>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using ycstl::bench::clobber_memory;
+using ycstl::bench::do_not_optimize;
+
+constexpr std::size_t kPushBack = 1 << 12;
+constexpr std::size_t kMiddle = 1 << 10;
+constexpr std::size_t kIterate = 1 << 14;
+constexpr std::size_t kCopy = 1 << 12;
+constexpr std::size_t kSplice = 1 << 10;
+constexpr std::size_t kArray = 1 << 10;
+constexpr std::size_t kPointers = 1 << 10;
+
+template<typename Container>
+Container make_filled(std::size_t n) {
+    Container c;
+    for (std::size_t i = 0; i != n; ++i) {
+        c.push_back(int(i));
+    }
+    return c;
+}
+
+//从空容器开始逐个push_back，包含所有扩容
+template<typename Container>
+void push_back(std::size_t iterations) {
+    for (std::size_t it = 0; it != iterations; ++it) {
+        Container c;
+        for (std::size_t i = 0; i != kPushBack; ++i) {
+            c.push_back(int(i));
+        }
+        do_not_optimize(c);
+    }
+}
+
+template<typename Container>
+void reserve_push_back(std::size_t iterations) {
+    for (std::size_t it = 0; it != iterations; ++it) {
+        Container c;
+        c.reserve(kPushBack);
+        for (std::size_t i = 0; i != kPushBack; ++i) {
+            c.push_back(int(i));
+        }
+        do_not_optimize(c);
+    }
+}
+
+//在中间插入一个再删除，长度保持不变
+template<typename Vector>
+void vector_insert_erase(std::size_t iterations) {
+    Vector v = make_filled<Vector>(kMiddle);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        v.insert(v.begin() + kMiddle / 2, int(it));
+        v.erase(v.begin() + kMiddle / 2);
+        clobber_memory();
+    }
+    do_not_optimize(v);
+}
+
+template<typename List>
+void list_insert_erase(std::size_t iterations) {
+    List l = make_filled<List>(kMiddle);
+    auto middle = l.begin();
+    for (std::size_t i = 0; i != kMiddle / 2; ++i) {
+        ++middle;
+    }
+    for (std::size_t it = 0; it != iterations; ++it) {
+        auto inserted = l.insert(middle, int(it));
+        l.erase(inserted);
+        clobber_memory();
+    }
+    do_not_optimize(l);
+}
+
+template<typename Container>
+void iterate(std::size_t iterations) {
+    Container c = make_filled<Container>(kIterate);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        long long sum = 0;
+        for (auto i = c.begin(); i != c.end(); ++i) {
+            sum += *i;
+        }
+        do_not_optimize(sum);
+    }
+}
+
+template<typename Container>
+void copy(std::size_t iterations) {
+    Container c = make_filled<Container>(kCopy);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        Container copied(c);
+        do_not_optimize(copied);
+    }
+}
+
+//移动过去再移动回来
+template<typename Container>
+void move(std::size_t iterations) {
+    Container a = make_filled<Container>(kCopy);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        Container b(std::move(a));
+        a = std::move(b);
+        do_not_optimize(a);
+    }
+}
+
+//整个链表接到另一个后面，再接回来
+template<typename List>
+void splice(std::size_t iterations) {
+    List a = make_filled<List>(kSplice);
+    List b = make_filled<List>(kSplice);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        b.splice(b.end(), a);
+        a.splice(a.end(), b);
+        do_not_optimize(a);
+    }
+}
+
+template<typename Array>
+void array_fill_sum(std::size_t iterations) {
+    Array a{};
+    for (std::size_t it = 0; it != iterations; ++it) {
+        a.fill(int(it));
+        long long sum = 0;
+        for (int x : a) {
+            sum += x;
+        }
+        do_not_optimize(sum);
+    }
+}
+
+template<typename Array>
+void array_copy(std::size_t iterations) {
+    Array a{};
+    a.fill(7);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        Array b = a;
+        do_not_optimize(b);
+    }
+}
+
+template<typename Array>
+void array_swap(std::size_t iterations) {
+    Array a{};
+    Array b{};
+    a.fill(1);
+    b.fill(2);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        a.swap(b);
+        do_not_optimize(a);
+    }
+}
+
+struct YcstlPointer {
+    template<typename T>
+    using unique = ycstl::unique_ptr<T>;
+
+    template<typename T, typename... Args>
+    static unique<T> make(Args&&... args) {
+        return ycstl::make_unique<T>(std::forward<Args>(args)...);
+    }
+};
+
+struct StdPointer {
+    template<typename T>
+    using unique = std::unique_ptr<T>;
+
+    template<typename T, typename... Args>
+    static unique<T> make(Args&&... args) {
+        return std::make_unique<T>(std::forward<Args>(args)...);
+    }
+};
+
+template<typename Pointer>
+void pointer_make_destroy(std::size_t iterations) {
+    for (std::size_t it = 0; it != iterations; ++it) {
+        auto p = Pointer::template make<int>(int(it));
+        do_not_optimize(p);
+    }
+}
+
+template<typename Pointer>
+void pointer_move(std::size_t iterations) {
+    auto a = Pointer::template make<int>(1);
+    typename Pointer::template unique<int> b;
+    for (std::size_t it = 0; it != iterations; ++it) {
+        b = std::move(a);
+        a = std::move(b);
+        do_not_optimize(a);
+    }
+}
+
+//一组指针逐个解引用求和
+template<typename Pointer>
+void pointer_deref(std::size_t iterations) {
+    std::vector<typename Pointer::template unique<int>> pointers;
+    for (std::size_t i = 0; i != kPointers; ++i) {
+        pointers.push_back(Pointer::template make<int>(int(i)));
+    }
+    for (std::size_t it = 0; it != iterations; ++it) {
+        long long sum = 0;
+        for (const auto& p : pointers) {
+            if (p) {
+                sum += *p.get();
+            }
+        }
+        do_not_optimize(sum);
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    using YVector = ycstl::vector<int>;
+    using SVector = std::vector<int>;
+    using YList = ycstl::list<int>;
+    using SList = std::list<int>;
+    using YArray = ycstl::array<int, kArray>;
+    using SArray = std::array<int, kArray>;
+
+    ycstl::bench::Harness harness(argc, argv);
+    harness.add("vector/push_back", "ycstl", kPushBack, push_back<YVector>);
+    harness.add("vector/push_back", "std", kPushBack, push_back<SVector>);
+    harness.add("vector/reserve_push_back", "ycstl", kPushBack, reserve_push_back<YVector>);
+    harness.add("vector/reserve_push_back", "std", kPushBack, reserve_push_back<SVector>);
+    harness.add("vector/insert_erase_mid", "ycstl", 1, vector_insert_erase<YVector>);
+    harness.add("vector/insert_erase_mid", "std", 1, vector_insert_erase<SVector>);
+    harness.add("vector/iterate", "ycstl", kIterate, iterate<YVector>);
+    harness.add("vector/iterate", "std", kIterate, iterate<SVector>);
+    harness.add("vector/copy", "ycstl", kCopy, copy<YVector>);
+    harness.add("vector/copy", "std", kCopy, copy<SVector>);
+    harness.add("vector/move", "ycstl", 1, move<YVector>);
+    harness.add("vector/move", "std", 1, move<SVector>);
+
+    harness.add("list/push_back", "ycstl", kPushBack, push_back<YList>);
+    harness.add("list/push_back", "std", kPushBack, push_back<SList>);
+    harness.add("list/insert_erase_mid", "ycstl", 1, list_insert_erase<YList>);
+    harness.add("list/insert_erase_mid", "std", 1, list_insert_erase<SList>);
+    harness.add("list/iterate", "ycstl", kIterate, iterate<YList>);
+    harness.add("list/iterate", "std", kIterate, iterate<SList>);
+    harness.add("list/copy", "ycstl", kCopy, copy<YList>);
+    harness.add("list/copy", "std", kCopy, copy<SList>);
+    harness.add("list/move", "ycstl", 1, move<YList>);
+    harness.add("list/move", "std", 1, move<SList>);
+    harness.add("list/splice_all", "ycstl", 1, splice<YList>);
+    harness.add("list/splice_all", "std", 1, splice<SList>);
+
+    harness.add("array/fill_sum", "ycstl", kArray, array_fill_sum<YArray>);
+    harness.add("array/fill_sum", "std", kArray, array_fill_sum<SArray>);
+    harness.add("array/copy", "ycstl", kArray, array_copy<YArray>);
+    harness.add("array/copy", "std", kArray, array_copy<SArray>);
+    harness.add("array/swap", "ycstl", kArray, array_swap<YArray>);
+    harness.add("array/swap", "std", kArray, array_swap<SArray>);
+
+    harness.add("unique_ptr/make_destroy", "ycstl", 1, pointer_make_destroy<YcstlPointer>);
+    harness.add("unique_ptr/make_destroy", "std", 1, pointer_make_destroy<StdPointer>);
+    harness.add("unique_ptr/move", "ycstl", 1, pointer_move<YcstlPointer>);
+    harness.add("unique_ptr/move", "std", 1, pointer_move<StdPointer>);
+    harness.add("unique_ptr/deref", "ycstl", kPointers, pointer_deref<YcstlPointer>);
+    harness.add("unique_ptr/deref", "std", kPointers, pointer_deref<StdPointer>);
+    return harness.run();
+}
@@ -0,0 +1,150 @@
+/**
+ * 队列式负载下 ycstl::deque 与 ycstl::list 的比较，std::deque作为基准
+ * allocs一列能看出deque的空块复用：稳定的FIFO里几乎不再调用分配器
+ * 框架见harness.hpp，例如:
+ *   ./deque_bench --filter=fifo
+ *
+ * 编译: g++ -std=c++20 -O2 -I.. deque_bench.cpp -o deque_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "harness.hpp"
+
+#include "deque.hpp"
+#include "list.hpp"
+
+#include <deque>
+
+namespace {
+
+using ycstl::bench::clobber_memory;
+using ycstl::bench::do_not_optimize;
+
+constexpr std::size_t kQueue = 1 << 10;
+constexpr std::size_t kBurst = 1 << 12;
+constexpr std::size_t kWindow = 1 << 8;
+constexpr std::size_t kIterate = 1 << 14;
+
+template<typename Queue>
+Queue make_filled(std::size_t n) {
+    Queue q;
+    for (std::size_t i = 0; i != n; ++i) {
+        q.push_back(int(i));
+    }
+    return q;
+}
+
+//长度保持kQueue的先进先出队列，每次操作一进一出
+template<typename Queue>
+void fifo(std::size_t iterations) {
+    Queue q = make_filled<Queue>(kQueue);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        q.push_back(int(it));
+        do_not_optimize(q.front());
+        q.pop_front();
+    }
+    do_not_optimize(q);
+}
+
+//一次压入kBurst个再全部弹出，队列反复从空到满
+template<typename Queue>
+void fifo_burst(std::size_t iterations) {
+    Queue q;
+    for (std::size_t it = 0; it != iterations; ++it) {
+        for (std::size_t i = 0; i != kBurst; ++i) {
+            q.push_back(int(i));
+        }
+        long long sum = 0;
+        while (!q.empty()) {
+            sum += q.front();
+            q.pop_front();
+        }
+        do_not_optimize(sum);
+    }
+}
+
+//栈：从后端压入再从后端弹出
+template<typename Queue>
+void lifo_burst(std::size_t iterations) {
+    Queue q;
+    for (std::size_t it = 0; it != iterations; ++it) {
+        for (std::size_t i = 0; i != kBurst; ++i) {
+            q.push_back(int(i));
+        }
+        long long sum = 0;
+        while (!q.empty()) {
+            sum += q.back();
+            q.pop_back();
+        }
+        do_not_optimize(sum);
+    }
+}
+
+//工作窃取式：自己从前端压入弹出，偶尔从后端被取走一个
+template<typename Queue>
+void both_ends(std::size_t iterations) {
+    Queue q = make_filled<Queue>(kQueue);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        q.push_front(int(it));
+        q.push_front(int(it));
+        q.pop_front();
+        q.pop_back();
+        clobber_memory();
+    }
+    do_not_optimize(q);
+}
+
+//滑动窗口求和：窗口长度kWindow，每步进一个出一个并读两端
+template<typename Queue>
+void sliding_window(std::size_t iterations) {
+    Queue q = make_filled<Queue>(kWindow);
+    long long sum = 0;
+    for (std::size_t it = 0; it != iterations; ++it) {
+        sum += q.back() - q.front();
+        q.pop_front();
+        q.push_back(int(it));
+    }
+    do_not_optimize(sum);
+}
+
+template<typename Queue>
+void iterate(std::size_t iterations) {
+    Queue q = make_filled<Queue>(kIterate);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        long long sum = 0;
+        for (auto i = q.begin(); i != q.end(); ++i) {
+            sum += *i;
+        }
+        do_not_optimize(sum);
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    using YDeque = ycstl::deque<int>;
+    using YList = ycstl::list<int>;
+    using SDeque = std::deque<int>;
+
+    ycstl::bench::Harness harness(argc, argv);
+    harness.add("queue/fifo", "deque", 1, fifo<YDeque>);
+    harness.add("queue/fifo", "list", 1, fifo<YList>);
+    harness.add("queue/fifo", "std", 1, fifo<SDeque>);
+    harness.add("queue/fifo_burst", "deque", kBurst, fifo_burst<YDeque>);
+    harness.add("queue/fifo_burst", "list", kBurst, fifo_burst<YList>);
+    harness.add("queue/fifo_burst", "std", kBurst, fifo_burst<SDeque>);
+    harness.add("queue/lifo_burst", "deque", kBurst, lifo_burst<YDeque>);
+    harness.add("queue/lifo_burst", "list", kBurst, lifo_burst<YList>);
+    harness.add("queue/lifo_burst", "std", kBurst, lifo_burst<SDeque>);
+    harness.add("queue/both_ends", "deque", 1, both_ends<YDeque>);
+    harness.add("queue/both_ends", "list", 1, both_ends<YList>);
+    harness.add("queue/both_ends", "std", 1, both_ends<SDeque>);
+    harness.add("queue/sliding_window", "deque", 1, sliding_window<YDeque>);
+    harness.add("queue/sliding_window", "list", 1, sliding_window<YList>);
+    harness.add("queue/sliding_window", "std", 1, sliding_window<SDeque>);
+    harness.add("queue/iterate", "deque", kIterate, iterate<YDeque>);
+    harness.add("queue/iterate", "list", kIterate, iterate<YList>);
+    harness.add("queue/iterate", "std", kIterate, iterate<SDeque>);
+    return harness.run();
+}
@@ -0,0 +1,395 @@
+/**
+ * 基准测试框架
+ *
+ * 每个用例先预热，再把迭代次数翻倍直到单次运行超过min_time，然后重复reps次，
+ * 报告每个操作耗时的中位数、MAD、最小值，以及每个操作的分配次数和字节数；
+ * 同一group下的ycstl和std实现放在一起比较，给出中位数之比；
+ * 运行前把进程绑定到一个CPU上，减少迁移带来的抖动；
+ * 计时结束后在perf_scope中再跑一次，给出每个元素的硬件计数，计数器不可用时只输出计时
+ *
+ * 这个头文件替换了全局operator new来统计分配，只能被一个翻译单元包含
+ *
+ * 命令行参数:
+ *   --filter=子串       只运行名字包含子串的用例
+ *   --reps=N            重复次数，默认15
+ *   --min-time-ms=N     每次重复的最短时间，默认20
+ *   --cpu=N             绑定的CPU，-1表示不绑定，默认绑定到当前CPU
+ *   --json=路径         结果写成JSON，路径为-时写到标准输出
+ *   --max-ratio=R       任一ycstl/std中位数之比超过R时返回1，可以用来卡版本升级
+ *   --no-counters       不读取硬件计数器
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef BENCHMARK_HARNESS_HPP_
+#define BENCHMARK_HARNESS_HPP_
+
+#include "perf_counter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace ycstl {
+namespace bench {
+
+struct AllocationCounters {
+    std::size_t count;
+    std::size_t bytes;
+};
+
+//常量初始化，静态对象构造之前的分配也能安全计数
+inline AllocationCounters g_allocations{0, 0};
+
+//让编译器认为value被读写过，计算结果不会被删掉
+template<typename T>
+inline void do_not_optimize(T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<volatile char*>(&value);
+#endif
+}
+
+inline void clobber_memory() {
+#if defined(__GNUC__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+struct Options {
+    std::string filter;
+    std::size_t reps = 15;
+    double min_time_ms = 20;
+    int cpu = -2;          // -2: 当前CPU，-1: 不绑定
+    std::string json;
+    double max_ratio = 0;
+    bool counters = true;
+};
+
+struct Result {
+    std::string group;
+    std::string impl;
+    std::size_t iterations;
+    double median_ns;
+    double mad_ns;
+    double min_ns;
+    double mean_ns;
+    double allocations;
+    double bytes;
+    std::vector<double> samples;
+    perf_reading counters;         //fn(iterations)一次的总计数
+    double elements;               //counters对应的元素个数
+};
+
+class Harness {
+public:
+    //fn(iterations)执行iterations次被测操作，每次操作处理items个元素，结果按元素折算
+    using Function = std::function<void(std::size_t)>;
+
+    Harness(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (0 == arg.rfind("--filter=", 0)) {
+                options_.filter = arg.substr(9);
+            } else if (0 == arg.rfind("--reps=", 0)) {
+                options_.reps = std::max<std::size_t>(1, std::strtoul(arg.c_str() + 7, nullptr, 10));
+            } else if (0 == arg.rfind("--min-time-ms=", 0)) {
+                options_.min_time_ms = std::strtod(arg.c_str() + 14, nullptr);
+            } else if (0 == arg.rfind("--cpu=", 0)) {
+                options_.cpu = std::atoi(arg.c_str() + 6);
+            } else if (0 == arg.rfind("--json=", 0)) {
+                options_.json = arg.substr(7);
+            } else if (0 == arg.rfind("--max-ratio=", 0)) {
+                options_.max_ratio = std::strtod(arg.c_str() + 12, nullptr);
+            } else if ("--no-counters" == arg) {
+                options_.counters = false;
+            } else {
+                std::cerr << "unknown option " << arg << "\n";
+            }
+        }
+    }
+
+    void add(std::string group, std::string impl, std::size_t items, Function fn) {
+        cases_.push_back(Case{std::move(group), std::move(impl), items, std::move(fn)});
+    }
+
+    int run() {
+        int pinned = pin();
+        std::cout << "cpu " << (pinned < 0 ? std::string("unpinned") : std::to_string(pinned))
+                  << "  reps " << options_.reps << "  min-time " << options_.min_time_ms << " ms\n\n";
+        std::printf("%-28s %-6s %12s %8s %12s %10s %10s %8s\n",
+                    "group", "impl", "median ns", "mad %", "min ns", "allocs", "bytes", "ratio");
+        for (Case& c : cases_) {
+            std::string name = c.group + "/" + c.impl;
+            if (!options_.filter.empty() && std::string::npos == name.find(options_.filter)) {
+                continue;
+            }
+            results_.push_back(measure(c));
+        }
+        //std的结果可能排在后面，全部测完再输出比值
+        for (const Result& r : results_) {
+            print(r);
+        }
+        if (options_.counters) {
+            print_counters();
+        }
+        int status = check_ratios();
+        if (!options_.json.empty()) {
+            write_json(pinned);
+        }
+        return status;
+    }
+
+private:
+    struct Case {
+        std::string group;
+        std::string impl;
+        std::size_t items;
+        Function fn;
+    };
+
+    int pin() {
+#if defined(__linux__)
+        int cpu = options_.cpu;
+        if (-1 == cpu) {
+            return -1;
+        }
+        if (-2 == cpu) {
+            cpu = sched_getcpu();
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (0 == sched_setaffinity(0, sizeof(set), &set)) {
+            return cpu;
+        }
+#endif
+        return -1;
+    }
+
+    static double elapsed_ns(const Function& fn, std::size_t iterations) {
+        auto start = std::chrono::steady_clock::now();
+        fn(iterations);
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    Result measure(const Case& c) {
+        c.fn(1);
+        std::size_t iterations = 1;
+        double min_ns = options_.min_time_ms * 1e6;
+        while (elapsed_ns(c.fn, iterations) < min_ns && iterations < (std::size_t(1) << 40)) {
+            iterations *= 2;
+        }
+
+        Result r{c.group, c.impl, iterations, 0, 0, 0, 0, 0, 0, {}, {}, 0};
+        double per_op = double(iterations) * double(c.items);
+        AllocationCounters before = g_allocations;
+        for (std::size_t rep = 0; rep != options_.reps; ++rep) {
+            r.samples.push_back(elapsed_ns(c.fn, iterations) / per_op);
+        }
+        r.allocations = double(g_allocations.count - before.count) / (per_op * double(options_.reps));
+        r.bytes = double(g_allocations.bytes - before.bytes) / (per_op * double(options_.reps));
+        if (options_.counters && counters_.any_available()) {
+            perf_scope scope(counters_, r.counters);
+            c.fn(iterations);
+        }
+        r.elements = per_op;
+
+        std::vector<double> sorted = r.samples;
+        std::sort(sorted.begin(), sorted.end());
+        r.median_ns = median(sorted);
+        r.min_ns = sorted.front();
+        double sum = 0;
+        for (double s : sorted) {
+            sum += s;
+        }
+        r.mean_ns = sum / double(sorted.size());
+        std::vector<double> deviations;
+        for (double s : sorted) {
+            deviations.push_back(std::fabs(s - r.median_ns));
+        }
+        std::sort(deviations.begin(), deviations.end());
+        r.mad_ns = median(deviations);
+        return r;
+    }
+
+    static double median(const std::vector<double>& sorted) {
+        std::size_t n = sorted.size();
+        return 0 == n % 2 ? (sorted[n / 2 - 1] + sorted[n / 2]) / 2 : sorted[n / 2];
+    }
+
+    //同一group中std实现的结果，没有时返回nullptr
+    const Result* baseline(const Result& r) const {
+        for (const Result& other : results_) {
+            if (other.group == r.group && other.impl == "std") {
+                return &other;
+            }
+        }
+        return nullptr;
+    }
+
+    void print(const Result& r) const {
+        const Result* base = baseline(r);
+        std::string ratio = "";
+        if (nullptr != base && &r != base) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.2f", r.median_ns / base->median_ns);
+            ratio = buffer;
+        }
+        std::printf("%-28s %-6s %12.2f %8.1f %12.2f %10.3f %10.1f %8s\n",
+                    r.group.c_str(), r.impl.c_str(), r.median_ns, 100 * r.mad_ns / r.median_ns,
+                    r.min_ns, r.allocations, r.bytes, ratio.c_str());
+    }
+
+    void print_counters() const {
+        if (!counters_.any_available()) {
+            std::printf("\nhardware counters unavailable: %s\n", std::strerror(counters_.error(perf_event::cycles)));
+            return;
+        }
+        std::printf("\n%-28s %-6s %10s %10s %6s %10s %10s %10s %10s\n", "per element", "impl",
+                    "cycles", "instr", "ipc", "l1d miss", "llc miss", "br miss", "dtlb miss");
+        for (const Result& r : results_) {
+            std::printf("%-28s %-6s", r.group.c_str(), r.impl.c_str());
+            for (perf_event e : {perf_event::cycles, perf_event::instructions}) {
+                print_counter(r, e, "%10.2f");
+            }
+            if (r.counters.has(perf_event::cycles) && r.counters.has(perf_event::instructions) &&
+                0 != r.counters[perf_event::cycles]) {
+                std::printf(" %6.2f", double(r.counters[perf_event::instructions]) / double(r.counters[perf_event::cycles]));
+            } else {
+                std::printf(" %6s", "-");
+            }
+            for (perf_event e : {perf_event::l1d_misses, perf_event::llc_misses,
+                                 perf_event::branch_misses, perf_event::dtlb_misses}) {
+                print_counter(r, e, "%10.4f");
+            }
+            std::printf("\n");
+        }
+    }
+
+    static void print_counter(const Result& r, perf_event e, const char* format) {
+        if (!r.counters.has(e)) {
+            std::printf(" %10s", "-");
+            return;
+        }
+        std::printf(" ");
+        std::printf(format, r.counters.per(e, r.elements));
+    }
+
+    int check_ratios() const {
+        if (options_.max_ratio <= 0) {
+            return 0;
+        }
+        int status = 0;
+        for (const Result& r : results_) {
+            const Result* base = baseline(r);
+            if (nullptr != base && &r != base && r.median_ns / base->median_ns > options_.max_ratio) {
+                std::cerr << "regression: " << r.group << " " << r.impl << " is "
+                          << r.median_ns / base->median_ns << "x std\n";
+                status = 1;
+            }
+        }
+        return status;
+    }
+
+    void write_json(int pinned) const {
+        std::FILE* out = "-" == options_.json ? stdout : std::fopen(options_.json.c_str(), "w");
+        if (nullptr == out) {
+            std::cerr << "cannot open " << options_.json << "\n";
+            return;
+        }
+        std::fprintf(out, "{\n  \"context\": {\"compiler\": \"%s\", \"cpu\": %d, \"reps\": %zu, \"min_time_ms\": %g},\n",
+#if defined(__VERSION__)
+                     __VERSION__,
+#else
+                     "unknown",
+#endif
+                     pinned, options_.reps, options_.min_time_ms);
+        std::fprintf(out, "  \"results\": [\n");
+        for (std::size_t i = 0; i != results_.size(); ++i) {
+            const Result& r = results_[i];
+            const Result* base = baseline(r);
+            std::fprintf(out, "    {\"group\": \"%s\", \"impl\": \"%s\", \"iterations\": %zu, "
+                              "\"median_ns\": %.4f, \"mad_ns\": %.4f, \"min_ns\": %.4f, \"mean_ns\": %.4f, "
+                              "\"allocations\": %.4f, \"bytes\": %.2f, \"ratio_to_std\": %.4f, \"samples_ns\": [",
+                         r.group.c_str(), r.impl.c_str(), r.iterations, r.median_ns, r.mad_ns, r.min_ns,
+                         r.mean_ns, r.allocations, r.bytes, nullptr == base ? 0.0 : r.median_ns / base->median_ns);
+            for (std::size_t s = 0; s != r.samples.size(); ++s) {
+                std::fprintf(out, "%s%.4f", 0 == s ? "" : ", ", r.samples[s]);
+            }
+            //每个元素的计数，只列出可用的事件，全部不可用时为null
+            std::fprintf(out, "], \"counters\": ");
+            if (!r.counters.any()) {
+                std::fprintf(out, "null");
+            } else {
+                const char* separator = "{";
+                for (std::size_t e = 0; e != kPerfEventCount; ++e) {
+                    if (r.counters.valid[e]) {
+                        std::fprintf(out, "%s\"%s\": %.4f", separator, perf_event_name(static_cast<perf_event>(e)),
+                                     r.counters.per(static_cast<perf_event>(e), r.elements));
+                        separator = ", ";
+                    }
+                }
+                std::fprintf(out, "}");
+            }
+            std::fprintf(out, "}%s\n", i + 1 == results_.size() ? "" : ",");
+        }
+        std::fprintf(out, "  ]\n}\n");
+        if (stdout != out) {
+            std::fclose(out);
+        }
+    }
+
+    Options options_;
+    perf_counters counters_;
+    std::vector<Case> cases_;
+    std::vector<Result> results_;
+};
+
+}   //bench
+}   //ycstl
+
+//GCC内联替换后的new/delete时会误报malloc/free与new/delete不匹配
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    ++ycstl::bench::g_allocations.count;
+    ycstl::bench::g_allocations.bytes += size;
+    if (void* p = std::malloc(0 == size ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
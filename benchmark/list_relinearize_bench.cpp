@@ -0,0 +1,143 @@
+/**
+ * list::relinearize 前后遍历耗时对比
+ *
+ * 链表经过多轮随机erase和随机位置insert，新节点落进之前erase留下的空闲块，
+ * 遍历顺序与内存顺序不再一致；之后调用relinearize()，比较前后的遍历耗时，
+ * 并统计相邻节点在内存中也相邻(地址差不超过kNear)的比例
+ * 分别用默认分配器(堆)、unsynchronized_pool_resource和monotonic_buffer_resource各跑一次
+ *
+ * 编译: g++ -std=c++20 -O2 -I.. list_relinearize_bench.cpp -o list_relinearize_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "list.hpp"
+#include "memory_resource.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kElements = 1 << 20;
+constexpr int kChurnRounds = 4;
+constexpr int kRounds = 5;
+constexpr std::ptrdiff_t kNear = 64;
+
+//每轮随机erase一半元素，再在随机位置插回同样多的元素，插入时复用刚释放的块
+template<typename List>
+void churn(List& l, std::mt19937_64& rng) {
+    using Iterator = typename List::iterator;
+    std::vector<Iterator> its;
+    its.reserve(l.size());
+    for (int round = 0; round < kChurnRounds; ++round) {
+        its.clear();
+        for (auto it = l.begin(); it != l.end(); ++it) {
+            its.push_back(it);
+        }
+        std::shuffle(its.begin(), its.end(), rng);
+        std::size_t half = its.size() / 2;
+        for (std::size_t i = 0; i != half; ++i) {
+            l.erase(its[i]);
+        }
+        for (std::size_t i = 0; i != half; ++i) {
+            Iterator pos = its[half + rng() % (its.size() - half)];
+            l.insert(pos, std::uint64_t(rng()));
+        }
+    }
+}
+
+//遍历中下一个元素与当前元素地址差在(0, kNear]内的比例
+template<typename List>
+double near_links(const List& l) {
+    std::size_t near = 0;
+    const std::uint64_t* pre = nullptr;
+    for (auto it = l.begin(); it != l.end(); ++it) {
+        const std::uint64_t* cur = &*it;
+        if (nullptr != pre) {
+            std::ptrdiff_t diff = reinterpret_cast<const char*>(cur) - reinterpret_cast<const char*>(pre);
+            near += diff > 0 && diff <= kNear;
+        }
+        pre = cur;
+    }
+    return l.size() < 2 ? 1.0 : double(near) / double(l.size() - 1);
+}
+
+template<typename Traverse>
+double best_ms(Traverse traverse) {
+    double best = 1e100;
+    for (int round = 0; round < kRounds; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        traverse();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+template<typename List>
+void run(const char* name, List& l) {
+    std::mt19937_64 rng(42);
+    for (std::size_t i = 0; i != kElements; ++i) {
+        l.push_back(i);
+    }
+    churn(l, rng);
+
+    volatile std::uint64_t sink = 0;
+    auto plain = [&] {
+        std::uint64_t sum = 0;
+        for (auto it = l.begin(); it != l.end(); ++it) {
+            sum += *it;
+        }
+        sink = sum;
+    };
+    auto prefetched = [&] {
+        std::uint64_t sum = 0;
+        l.prefetch_for_each([&sum](std::uint64_t x) { sum += x; });
+        sink = sum;
+    };
+
+    double fragmented = best_ms(plain);
+    double fragmented_prefetch = best_ms(prefetched);
+    double fragmented_near = near_links(l);
+
+    auto start = std::chrono::steady_clock::now();
+    l.relinearize();
+    std::chrono::duration<double, std::milli> relinearize_ms = std::chrono::steady_clock::now() - start;
+
+    double relinearized = best_ms(plain);
+    double relinearized_prefetch = best_ms(prefetched);
+    double relinearized_near = near_links(l);
+
+    std::cout << name << " (" << l.size() << " elements)\n"
+              << "  fragmented traversal:    " << fragmented << " ms, near links " << 100 * fragmented_near << "%\n"
+              << "  fragmented + prefetch:   " << fragmented_prefetch << " ms\n"
+              << "  relinearize():           " << relinearize_ms.count() << " ms\n"
+              << "  relinearized traversal:  " << relinearized << " ms, near links " << 100 * relinearized_near << "%\n"
+              << "  relinearized + prefetch: " << relinearized_prefetch << " ms\n";
+    (void)sink;
+}
+
+}
+
+int main() {
+    {
+        ycstl::list<std::uint64_t> l;
+        run("heap", l);
+    }
+    {
+        ycstl::unsynchronized_pool_resource pool;
+        ycstl::pmr::list<std::uint64_t> l{ycstl::polymorphic_allocator<std::uint64_t>(&pool)};
+        run("unsynchronized_pool_resource", l);
+    }
+    {
+        ycstl::monotonic_buffer_resource arena;
+        ycstl::pmr::list<std::uint64_t> l{ycstl::polymorphic_allocator<std::uint64_t>(&arena)};
+        run("monotonic_buffer_resource", l);
+    }
+    return 0;
+}
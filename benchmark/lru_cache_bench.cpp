@@ -0,0 +1,65 @@
+/**
+ * lru_cache 多线程get/put吞吐
+ *
+ * 编译: g++ -std=c++20 -O2 -pthread -I.. lru_cache_bench.cpp -o lru_cache_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "lru_cache.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kCapacity = 1 << 16;
+constexpr std::size_t kKeySpace = 1 << 18;
+constexpr std::size_t kOpsPerThread = 1 << 20;
+
+//每次get未命中就put，key集中在较小的热点区间上
+double run(std::size_t threads, std::size_t shards) {
+    ycstl::lru_cache<std::uint64_t, std::uint64_t> cache(kCapacity, shards);
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t != threads; ++t) {
+        workers.emplace_back([&cache, t] {
+            std::mt19937_64 rng(t + 1);
+            for (std::size_t i = 0; i != kOpsPerThread; ++i) {
+                std::uint64_t r = rng();
+                std::uint64_t key = (r & 3) ? (r >> 8) % (kCapacity / 2) : (r >> 8) % kKeySpace;
+                if (!cache.get(key)) {
+                    cache.put(key, key);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    ycstl::lru_cache_stats stats = cache.stats();
+    double mops = threads * kOpsPerThread / elapsed.count() / 1e6;
+    std::cout << "threads " << threads << "  shards " << shards << "  " << mops << " Mops/s"
+              << "  hit rate " << double(stats.hits) / (stats.hits + stats.misses)
+              << "  evictions " << stats.evictions << "\n";
+    return mops;
+}
+
+}
+
+int main() {
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    if (0 == max_threads) {
+        max_threads = 1;
+    }
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        run(threads, 1);
+        run(threads, 16);
+    }
+    return 0;
+}
@@ -0,0 +1,207 @@
+/**
+ * 布局对矩阵转置和GEMM的影响
+ * 转置：行主序逐元素、行主序分块循环、两边都是layout_blocked按块转置
+ * GEMM：B行主序(ijk内层跨行)、B列主序(内层连续)、行主序ikj、layout_blocked分块
+ *
+ * 编译: g++ -std=c++20 -O2 -I.. mdspan_bench.cpp -o mdspan_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "mdspan.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+namespace {
+
+constexpr std::size_t kTransposeN = 2048;
+constexpr std::size_t kGemmN = 512;
+constexpr std::size_t kTile = 32;
+constexpr std::size_t kRepeats = 4;
+
+using Extents = ycstl::dextents<std::size_t, 2>;
+using RowMajor = ycstl::mdarray<float, Extents>;
+using ColMajor = ycstl::mdarray<float, Extents, ycstl::layout_left>;
+using Blocked = ycstl::mdarray<float, Extents, ycstl::layout_blocked<kTile, kTile>>;
+
+std::atomic<std::uint64_t> g_sink{0};     //防止循环被优化掉
+
+template<typename Matrix>
+void fill(Matrix& m) {
+    for (std::size_t i = 0; i != m.extent(0); ++i) {
+        for (std::size_t j = 0; j != m.extent(1); ++j) {
+            m(i, j) = float((i * 7 + j * 3) % 17);
+        }
+    }
+}
+
+template<typename Matrix>
+void consume(const Matrix& m) {
+    float sum = 0;
+    for (std::size_t i = 0; i < m.extent(0); i += 7) {
+        sum += m(i, m.extent(1) - 1 - i % m.extent(1));
+    }
+    g_sink.fetch_add(std::uint64_t(sum), std::memory_order_relaxed);
+}
+
+template<typename Function>
+double time_ms(Function f) {
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r != kRepeats; ++r) {
+        f();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / kRepeats;
+}
+
+void bench_transpose() {
+    constexpr std::size_t n = kTransposeN;
+    RowMajor in(n, n);
+    RowMajor out(n, n);
+    fill(in);
+
+    double naive = time_ms([&] {
+        for (std::size_t i = 0; i != n; ++i) {
+            for (std::size_t j = 0; j != n; ++j) {
+                out(j, i) = in(i, j);
+            }
+        }
+    });
+    consume(out);
+
+    double tiled = time_ms([&] {
+        for (std::size_t ii = 0; ii < n; ii += kTile) {
+            for (std::size_t jj = 0; jj < n; jj += kTile) {
+                for (std::size_t i = ii; i != ii + kTile; ++i) {
+                    for (std::size_t j = jj; j != jj + kTile; ++j) {
+                        out(j, i) = in(i, j);
+                    }
+                }
+            }
+        }
+    });
+    consume(out);
+
+    //块(ti, tj)整体转置到块(tj, ti)，两个块各自是一段连续内存
+    Blocked bin(n, n);
+    Blocked bout(n, n);
+    fill(bin);
+    double blocked = time_ms([&] {
+        const auto& map = bin.mapping();
+        for (std::size_t ti = 0; ti != n / kTile; ++ti) {
+            for (std::size_t tj = 0; tj != n / kTile; ++tj) {
+                const float* src = bin.data() + map.tile_offset(ti, tj);
+                float* dst = bout.data() + map.tile_offset(tj, ti);
+                for (std::size_t i = 0; i != kTile; ++i) {
+                    for (std::size_t j = 0; j != kTile; ++j) {
+                        dst[j * kTile + i] = src[i * kTile + j];
+                    }
+                }
+            }
+        }
+    });
+    consume(bout);
+
+    std::cout << "transpose " << n << "x" << n << "\n"
+              << "  layout_right naive       " << naive << " ms\n"
+              << "  layout_right tiled loops " << tiled << " ms\n"
+              << "  layout_blocked<32,32>    " << blocked << " ms\n";
+}
+
+template<typename MatrixA, typename MatrixB>
+void gemm_ijk(const MatrixA& a, const MatrixB& b, RowMajor& c) {
+    std::size_t n = a.extent(0);
+    for (std::size_t i = 0; i != n; ++i) {
+        for (std::size_t j = 0; j != n; ++j) {
+            float sum = 0;
+            for (std::size_t k = 0; k != n; ++k) {
+                sum += a(i, k) * b(k, j);
+            }
+            c(i, j) = sum;
+        }
+    }
+}
+
+void bench_gemm() {
+    constexpr std::size_t n = kGemmN;
+    constexpr double flops = 2.0 * n * n * n;
+    RowMajor a(n, n);
+    RowMajor b(n, n);
+    ColMajor b_col(n, n);
+    RowMajor c(n, n);
+    fill(a);
+    fill(b);
+    fill(b_col);
+
+    double row = time_ms([&] { gemm_ijk(a, b, c); });
+    consume(c);
+
+    double col = time_ms([&] { gemm_ijk(a, b_col, c); });
+    consume(c);
+
+    double ikj = time_ms([&] {
+        for (std::size_t i = 0; i != n; ++i) {
+            for (std::size_t j = 0; j != n; ++j) {
+                c(i, j) = 0;
+            }
+            for (std::size_t k = 0; k != n; ++k) {
+                float aik = a(i, k);
+                for (std::size_t j = 0; j != n; ++j) {
+                    c(i, j) += aik * b(k, j);
+                }
+            }
+        }
+    });
+    consume(c);
+
+    //三个矩阵都按块存放，最内层是两个连续块的乘加
+    Blocked ba(n, n);
+    Blocked bb(n, n);
+    Blocked bc(n, n);
+    fill(ba);
+    fill(bb);
+    double blocked = time_ms([&] {
+        const auto& map = ba.mapping();
+        constexpr std::size_t tiles = n / kTile;
+        for (std::size_t ti = 0; ti != tiles; ++ti) {
+            for (std::size_t tj = 0; tj != tiles; ++tj) {
+                //在局部块里累加，避免和输入块可能重叠导致无法向量化
+                float acc[kTile * kTile] = {};
+                for (std::size_t tk = 0; tk != tiles; ++tk) {
+                    const float* at = ba.data() + map.tile_offset(ti, tk);
+                    const float* bt = bb.data() + map.tile_offset(tk, tj);
+                    for (std::size_t i = 0; i != kTile; ++i) {
+                        for (std::size_t k = 0; k != kTile; ++k) {
+                            float aik = at[i * kTile + k];
+                            for (std::size_t j = 0; j != kTile; ++j) {
+                                acc[i * kTile + j] += aik * bt[k * kTile + j];
+                            }
+                        }
+                    }
+                }
+                float* ct = bc.data() + map.tile_offset(ti, tj);
+                for (std::size_t e = 0; e != kTile * kTile; ++e) {
+                    ct[e] = acc[e];
+                }
+            }
+        }
+    });
+    consume(bc);
+
+    std::cout << "gemm " << n << "x" << n << "\n"
+              << "  ijk, B layout_right      " << row << " ms  " << flops / row / 1e6 << " GFLOP/s\n"
+              << "  ijk, B layout_left       " << col << " ms  " << flops / col / 1e6 << " GFLOP/s\n"
+              << "  ikj, layout_right        " << ikj << " ms  " << flops / ikj / 1e6 << " GFLOP/s\n"
+              << "  layout_blocked<32,32>    " << blocked << " ms  " << flops / blocked / 1e6 << " GFLOP/s\n";
+}
+
+}
+
+int main() {
+    bench_transpose();
+    bench_gemm();
+    return 0;
+}
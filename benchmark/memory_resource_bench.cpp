@@ -0,0 +1,76 @@
+/**
+ * 每个请求构造一批容器时，不同memory_resource的开销
+ *
+ * 编译: g++ -std=c++20 -O2 -I.. memory_resource_bench.cpp -o memory_resource_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "list.hpp"
+#include "memory_resource.hpp"
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+namespace {
+
+constexpr std::size_t kRequests = 1 << 14;
+constexpr std::size_t kListNodes = 256;
+constexpr std::size_t kVectors = 16;
+constexpr std::size_t kVectorSize = 64;
+
+//一个请求：一个list加若干个逐个push_back的小vector
+std::uint64_t handle_request(ycstl::memory_resource* resource, std::uint64_t seed) {
+    ycstl::pmr::list<std::uint64_t> items(resource);
+    for (std::size_t i = 0; i != kListNodes; ++i) {
+        items.push_back(seed + i);
+    }
+    std::uint64_t sum = 0;
+    for (std::size_t v = 0; v != kVectors; ++v) {
+        ycstl::pmr::vector<std::uint64_t> row(resource);
+        for (std::size_t i = 0; i != kVectorSize; ++i) {
+            row.push_back(seed ^ i);
+        }
+        sum += row[v % kVectorSize];
+    }
+    return sum + items.back();
+}
+
+template<typename Function>
+void bench(const char* name, Function f) {
+    std::uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r != kRequests; ++r) {
+        sink += f(r);
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << elapsed.count() << " ms  (" << sink << ")\n";
+}
+
+}
+
+int main() {
+    bench("new_delete_resource           ", [](std::uint64_t r) {
+        return handle_request(ycstl::new_delete_resource(), r);
+    });
+
+    ycstl::unsynchronized_pool_resource pool;
+    bench("unsynchronized_pool_resource  ", [&pool](std::uint64_t r) {
+        return handle_request(&pool, r);
+    });
+
+    ycstl::synchronized_pool_resource shared_pool;
+    bench("synchronized_pool_resource    ", [&shared_pool](std::uint64_t r) {
+        return handle_request(&shared_pool, r);
+    });
+
+    //每个请求一个栈上缓冲区，请求结束时整体丢弃
+    bench("monotonic_buffer_resource     ", [](std::uint64_t r) {
+        alignas(std::max_align_t) static char buffer[64 * 1024];
+        ycstl::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+        return handle_request(&arena, r);
+    });
+    return 0;
+}
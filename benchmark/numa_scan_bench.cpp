@@ -0,0 +1,91 @@
+/**
+ * 不同NUMA/大页策略下大vector的顺序扫描带宽
+ * 单节点机器上bind/interleave等价于local，仍然可以比较大页的效果
+ *
+ * 编译: g++ -std=c++20 -O2 -pthread -I.. numa_scan_bench.cpp -o numa_scan_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "numa_allocator.hpp"
+#include "vector.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kElements = std::size_t(32) << 20;    // 256MiB
+constexpr std::size_t kPasses = 8;
+
+std::atomic<std::uint64_t> g_sink{0};     //防止循环被优化掉
+
+//多线程各扫一段，返回GB/s
+template<typename Vector>
+double scan(const Vector& v, std::size_t threads) {
+    std::vector<std::uint64_t> sums(threads);
+    std::vector<std::thread> workers;
+    std::size_t per_thread = v.size() / threads;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t != threads; ++t) {
+        workers.emplace_back([&v, &sums, t, per_thread] {
+            const std::uint64_t* p = v.data() + t * per_thread;
+            std::uint64_t sum = 0;
+            for (std::size_t pass = 0; pass != kPasses; ++pass) {
+                for (std::size_t i = 0; i != per_thread; ++i) {
+                    sum += p[i];
+                }
+            }
+            sums[t] = sum;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    for (std::uint64_t s : sums) {
+        g_sink.fetch_add(s, std::memory_order_relaxed);
+    }
+    return double(per_thread * threads * sizeof(std::uint64_t) * kPasses) / elapsed.count() / 1e9;
+}
+
+void run(const char* name, const ycstl::numa_policy& policy, std::size_t threads) {
+    ycstl::numa_resource resource(policy);
+    ycstl::vector<std::uint64_t, ycstl::numa_allocator<std::uint64_t>> v(
+        kElements, std::uint64_t(1), ycstl::numa_allocator<std::uint64_t>(&resource));
+    double gbps = scan(v, threads);
+    ycstl::numa_stats stats = resource.stats();
+    std::cout << name << "  threads " << threads << "  " << gbps << " GB/s"
+              << "  (bound " << stats.bound_mappings << ", hugetlb " << stats.hugetlb_mappings
+              << ", fallbacks " << stats.fallbacks << ")\n";
+}
+
+void run_std(std::size_t threads) {
+    ycstl::vector<std::uint64_t> v(kElements, std::uint64_t(1));
+    std::cout << "std::allocator               threads " << threads << "  " << scan(v, threads) << " GB/s\n";
+}
+
+}
+
+int main() {
+    using ycstl::huge_page_mode;
+    using ycstl::numa_mode;
+    std::cout << "numa nodes " << ycstl::numa_node_count() << "\n";
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    if (0 == max_threads) {
+        max_threads = 1;
+    }
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        run_std(threads);
+        run("local                      ", {numa_mode::local, 0, huge_page_mode::none}, threads);
+        run("bind node 0                ", {numa_mode::bind, 1, huge_page_mode::none}, threads);
+        run("interleave                 ", {numa_mode::interleave, 0, huge_page_mode::none}, threads);
+        run("local + transparent huge   ", {numa_mode::local, 0, huge_page_mode::transparent}, threads);
+        run("interleave + hugetlb       ", {numa_mode::interleave, 0, huge_page_mode::hugetlb}, threads);
+    }
+    return 0;
+}
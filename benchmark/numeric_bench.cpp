@@ -0,0 +1,121 @@
+/**
+ * 表达式模板与逐个运算都生成临时vector的写法对比
+ * 小向量主要差在分配，大向量主要差在中间结果来回读写内存
+ *
+ * 编译: g++ -std=c++20 -O2 -I.. numeric_bench.cpp -o numeric_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "numeric.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+namespace {
+
+constexpr std::size_t kTotalElements = std::size_t(1) << 27;     //每种长度都处理这么多元素
+
+std::atomic<std::uint64_t> g_sink{0};     //防止循环被优化掉
+
+using Vec = ycstl::vector<double>;
+
+//朴素写法：每个运算返回一个新vector
+Vec naive_add(const Vec& a, const Vec& b) {
+    Vec r(a.size());
+    for (std::size_t i = 0; i != a.size(); ++i) {
+        r[i] = a[i] + b[i];
+    }
+    return r;
+}
+
+Vec naive_sub(const Vec& a, const Vec& b) {
+    Vec r(a.size());
+    for (std::size_t i = 0; i != a.size(); ++i) {
+        r[i] = a[i] - b[i];
+    }
+    return r;
+}
+
+Vec naive_mul(const Vec& a, const Vec& b) {
+    Vec r(a.size());
+    for (std::size_t i = 0; i != a.size(); ++i) {
+        r[i] = a[i] * b[i];
+    }
+    return r;
+}
+
+Vec naive_scale(const Vec& a, double s) {
+    Vec r(a.size());
+    for (std::size_t i = 0; i != a.size(); ++i) {
+        r[i] = a[i] * s;
+    }
+    return r;
+}
+
+double naive_sum(const Vec& a) {
+    double s = 0;
+    for (std::size_t i = 0; i != a.size(); ++i) {
+        s += a[i];
+    }
+    return s;
+}
+
+template<typename Function>
+double time_ms(std::size_t rounds, Function f) {
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r != rounds; ++r) {
+        f();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void run(std::size_t n) {
+    std::size_t rounds = kTotalElements / n;
+    Vec a(n);
+    Vec b(n);
+    Vec c(n);
+    Vec d(n);
+    Vec e(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        b[i] = double(i % 13);
+        c[i] = double(i % 7) + 0.5;
+        d[i] = double(i % 5);
+        e[i] = 1.25;
+    }
+
+    //a = b * c + d * e - b * 0.5
+    double naive = time_ms(rounds, [&] {
+        a = naive_sub(naive_add(naive_mul(b, c), naive_mul(d, e)), naive_scale(b, 0.5));
+        g_sink.fetch_add(std::uint64_t(a[n / 2]), std::memory_order_relaxed);
+    });
+    double fused = time_ms(rounds, [&] {
+        a = b * c + d * e - b * 0.5;
+        g_sink.fetch_add(std::uint64_t(a[n / 2]), std::memory_order_relaxed);
+    });
+
+    //sum(b * c + d)
+    double naive_reduce = time_ms(rounds, [&] {
+        g_sink.fetch_add(std::uint64_t(naive_sum(naive_add(naive_mul(b, c), d))), std::memory_order_relaxed);
+    });
+    double fused_reduce = time_ms(rounds, [&] {
+        g_sink.fetch_add(std::uint64_t(ycstl::sum(b * c + d)), std::memory_order_relaxed);
+    });
+
+    std::cout << "n " << n << "\n"
+              << "  a = b*c + d*e - b*0.5   temporaries " << naive << " ms   expression " << fused << " ms\n"
+              << "  sum(b*c + d)            temporaries " << naive_reduce << " ms   expression " << fused_reduce << " ms\n";
+}
+
+}
+
+int main() {
+    run(std::size_t(1) << 8);
+    run(std::size_t(1) << 12);
+    run(std::size_t(1) << 16);
+    run(std::size_t(1) << 22);
+    return 0;
+}
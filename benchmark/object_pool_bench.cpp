@@ -0,0 +1,83 @@
+/**
+ * object_pool::make 与 make_unique 的构造/销毁吞吐
+ *
+ * 编译: g++ -std=c++20 -O2 -pthread -I.. object_pool_bench.cpp -o object_pool_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "object_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kOpsPerThread = 1 << 21;
+constexpr std::size_t kLive = 64;
+
+std::atomic<std::uint64_t> g_sink{0};     //防止循环被优化掉
+
+//模拟一个解析器对象：几个指针加一段状态
+struct Parser {
+    explicit Parser(std::uint64_t seed) : state_{seed, seed + 1, seed + 2, seed + 3} {}
+
+    std::uint64_t state_[4];
+    const char* cursor_ = nullptr;
+    const char* end_ = nullptr;
+    std::uint32_t depth_ = 0;
+    char scratch_[128] = {};
+};
+
+//每个线程保持kLive个存活对象，轮流替换，最老的对象可能由另一个线程创建
+template<typename Make>
+double run(const char* name, std::size_t threads, Make make) {
+    using Handle = decltype(make(0));
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t != threads; ++t) {
+        workers.emplace_back([&make] {
+            std::vector<Handle> live(kLive);
+            std::uint64_t sink = 0;
+            for (std::size_t i = 0; i != kOpsPerThread; ++i) {
+                Handle& slot = live[i % kLive];
+                slot = make(i);
+                sink += slot->state_[i & 3];
+            }
+            g_sink.fetch_add(sink, std::memory_order_relaxed);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double mops = threads * kOpsPerThread / elapsed.count() / 1e6;
+    std::cout << name << "  threads " << threads << "  " << mops << " Mops/s\n";
+    return mops;
+}
+
+}
+
+int main() {
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    if (0 == max_threads) {
+        max_threads = 1;
+    }
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        run("make_unique        ", threads, [](std::uint64_t i) {
+            return ycstl::make_unique<Parser>(i);
+        });
+        ycstl::object_pool<Parser> pool(threads * kLive);
+        run("object_pool::make  ", threads, [&pool](std::uint64_t i) {
+            return pool.make(i);
+        });
+        ycstl::object_pool_stats stats = pool.stats();
+        std::cout << "    hit rate " << pool.hit_rate() << "  misses " << stats.misses
+                  << "  outstanding " << stats.outstanding << "  capacity " << stats.capacity << "\n";
+    }
+    return 0;
+}
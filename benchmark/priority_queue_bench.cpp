@@ -0,0 +1,225 @@
+/**
+ * 优先队列在10^7次操作下的对比：
+ *   std::priority_queue 与 2/4/8叉的ycstl::priority_queue 的push/pop混合和批量建堆；
+ *   随机图上的Dijkstra：std::priority_queue懒删除、indexed_priority_queue的decrease-key、radix_heap
+ *
+ * 编译: g++ -std=c++20 -O2 -I.. priority_queue_bench.cpp -o priority_queue_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "priority_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kOperations = 10'000'000;
+constexpr std::size_t kHeapSize = 1 << 20;           // push/pop时堆中常驻的元素，远大于L2
+constexpr std::uint32_t kNodes = 1 << 20;
+constexpr std::uint32_t kDegree = 10;                // kNodes * kDegree 约等于10^7次松弛
+constexpr std::uint32_t kMaxWeight = 1000;
+
+std::atomic<std::uint64_t> g_sink{0};     //防止循环被优化掉
+
+template<typename Function>
+double time_ms(Function f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//先放入kHeapSize个元素，再做kOperations次操作：一半pop一半push
+template<typename Queue>
+void push_pop(const char* name, const std::vector<std::uint64_t>& keys) {
+    Queue q;
+    for (std::size_t i = 0; i != kHeapSize; ++i) {
+        q.push(keys[i]);
+    }
+    double ms = time_ms([&] {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i != kOperations / 2; ++i) {
+            sum += q.top();
+            q.pop();
+            q.push(keys[i] ^ sum);
+        }
+        g_sink.fetch_add(sum, std::memory_order_relaxed);
+    });
+    std::cout << name << "  push/pop  " << ms << " ms  " << ms * 1e6 / kOperations << " ns/op\n";
+}
+
+template<typename Build>
+void heapify(const char* name, const std::vector<std::uint64_t>& keys, Build build) {
+    double ms = time_ms([&] { g_sink.fetch_add(build(keys), std::memory_order_relaxed); });
+    std::cout << name << "  heapify   " << ms << " ms  " << ms * 1e6 / keys.size() << " ns/element\n";
+}
+
+template<std::size_t Arity>
+std::uint64_t ycstl_heapify(const std::vector<std::uint64_t>& keys) {
+    ycstl::vector<std::uint64_t> c(keys.begin(), keys.end());
+    ycstl::priority_queue<std::uint64_t, ycstl::vector<std::uint64_t>, std::less<std::uint64_t>, Arity> q(
+        std::less<std::uint64_t>(), std::move(c));
+    return q.top();
+}
+
+std::uint64_t std_heapify(const std::vector<std::uint64_t>& keys) {
+    std::priority_queue<std::uint64_t> q(keys.begin(), keys.end());
+    return q.top();
+}
+
+//邻接表，按起点连续存放
+struct Graph {
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> targets;
+    std::vector<std::uint32_t> weights;
+};
+
+Graph make_graph() {
+    Graph g;
+    std::mt19937 rng(11);
+    g.offsets.reserve(kNodes + 1);
+    for (std::uint32_t u = 0; u != kNodes; ++u) {
+        g.offsets.push_back(std::uint32_t(g.targets.size()));
+        //保证连通
+        g.targets.push_back((u + 1) % kNodes);
+        g.weights.push_back(1 + rng() % kMaxWeight);
+        for (std::uint32_t e = 1; e != kDegree; ++e) {
+            g.targets.push_back(rng() % kNodes);
+            g.weights.push_back(1 + rng() % kMaxWeight);
+        }
+    }
+    g.offsets.push_back(std::uint32_t(g.targets.size()));
+    return g;
+}
+
+constexpr std::uint64_t kInfinity = ~std::uint64_t(0);
+
+//同一个节点可能多次入队，出队时发现距离已经过期就跳过
+std::vector<std::uint64_t> dijkstra_lazy(const Graph& g) {
+    using Item = std::pair<std::uint64_t, std::uint32_t>;
+    std::vector<std::uint64_t> dist(kNodes, kInfinity);
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> q;
+    dist[0] = 0;
+    q.push({0, 0});
+    while (!q.empty()) {
+        auto [d, u] = q.top();
+        q.pop();
+        if (d != dist[u]) {
+            continue;
+        }
+        for (std::uint32_t e = g.offsets[u]; e != g.offsets[u + 1]; ++e) {
+            std::uint64_t nd = d + g.weights[e];
+            if (nd < dist[g.targets[e]]) {
+                dist[g.targets[e]] = nd;
+                q.push({nd, g.targets[e]});
+            }
+        }
+    }
+    return dist;
+}
+
+//每个节点最多在堆中出现一次，距离变短时按句柄上浮
+template<std::size_t Arity>
+std::vector<std::uint64_t> dijkstra_indexed(const Graph& g) {
+    using Queue = ycstl::indexed_priority_queue<std::uint64_t, std::greater<std::uint64_t>, Arity>;
+    std::vector<std::uint64_t> dist(kNodes, kInfinity);
+    std::vector<typename Queue::handle> handles(kNodes, Queue::npos);
+    std::vector<std::uint32_t> owner;
+    Queue q;
+    dist[0] = 0;
+    owner.push_back(0);
+    handles[0] = q.push(0);
+    while (!q.empty()) {
+        std::uint32_t u = owner[q.top_handle()];
+        std::uint64_t d = q.top();
+        q.pop();
+        handles[u] = Queue::npos;
+        for (std::uint32_t e = g.offsets[u]; e != g.offsets[u + 1]; ++e) {
+            std::uint32_t v = g.targets[e];
+            std::uint64_t nd = d + g.weights[e];
+            if (nd >= dist[v]) {
+                continue;
+            }
+            dist[v] = nd;
+            if (Queue::npos != handles[v]) {
+                q.update(handles[v], nd);
+            } else {
+                handles[v] = q.push(nd);
+                if (owner.size() <= handles[v]) {
+                    owner.resize(handles[v] + 1);
+                }
+                owner[handles[v]] = v;
+            }
+        }
+    }
+    return dist;
+}
+
+//距离单调不减，可以直接用radix_heap，同样懒删除
+std::vector<std::uint64_t> dijkstra_radix(const Graph& g) {
+    std::vector<std::uint64_t> dist(kNodes, kInfinity);
+    ycstl::radix_heap<std::uint64_t, std::uint32_t> q;
+    dist[0] = 0;
+    q.push(0, 0);
+    while (!q.empty()) {
+        auto [d, u] = q.top();
+        q.pop();
+        if (d != dist[u]) {
+            continue;
+        }
+        for (std::uint32_t e = g.offsets[u]; e != g.offsets[u + 1]; ++e) {
+            std::uint64_t nd = d + g.weights[e];
+            if (nd < dist[g.targets[e]]) {
+                dist[g.targets[e]] = nd;
+                q.push(nd, g.targets[e]);
+            }
+        }
+    }
+    return dist;
+}
+
+template<typename Function>
+void dijkstra(const char* name, const Graph& g, const std::vector<std::uint64_t>& expected, Function f) {
+    std::vector<std::uint64_t> dist;
+    double ms = time_ms([&] { dist = f(g); });
+    std::cout << name << "  dijkstra  " << ms << " ms" << (dist == expected ? "" : "  WRONG RESULT") << "\n";
+}
+
+}
+
+int main() {
+    std::vector<std::uint64_t> keys(kOperations);
+    std::mt19937_64 rng(7);
+    for (auto& key : keys) {
+        key = rng();
+    }
+
+    push_pop<std::priority_queue<std::uint64_t>>("std::priority_queue      ", keys);
+    push_pop<ycstl::priority_queue<std::uint64_t, ycstl::vector<std::uint64_t>, std::less<std::uint64_t>, 2>>(
+        "ycstl::priority_queue<2> ", keys);
+    push_pop<ycstl::priority_queue<std::uint64_t, ycstl::vector<std::uint64_t>, std::less<std::uint64_t>, 4>>(
+        "ycstl::priority_queue<4> ", keys);
+    push_pop<ycstl::priority_queue<std::uint64_t, ycstl::vector<std::uint64_t>, std::less<std::uint64_t>, 8>>(
+        "ycstl::priority_queue<8> ", keys);
+
+    heapify("std::priority_queue      ", keys, std_heapify);
+    heapify("ycstl::priority_queue<2> ", keys, ycstl_heapify<2>);
+    heapify("ycstl::priority_queue<4> ", keys, ycstl_heapify<4>);
+    heapify("ycstl::priority_queue<8> ", keys, ycstl_heapify<8>);
+
+    Graph g = make_graph();
+    std::vector<std::uint64_t> expected = dijkstra_lazy(g);
+    dijkstra("std::priority_queue lazy ", g, expected, dijkstra_lazy);
+    dijkstra("indexed_priority_queue<2>", g, expected, dijkstra_indexed<2>);
+    dijkstra("indexed_priority_queue<4>", g, expected, dijkstra_indexed<4>);
+    dijkstra("indexed_priority_queue<8>", g, expected, dijkstra_indexed<8>);
+    dijkstra("radix_heap               ", g, expected, dijkstra_radix);
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * 报表生成式的管道：每步物化一个vector 与 views串起来最后to<vector>()
+ * 替换全局operator new统计每条管道的分配次数
+ *
+ * 编译: g++ -std=c++20 -O2 -I.. ranges_bench.cpp -o ranges_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "ranges.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace {
+
+std::size_t g_allocations = 0;
+
+}
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+constexpr std::size_t kRecords = 1 << 14;
+constexpr std::size_t kRounds = 1 << 9;
+constexpr std::size_t kTop = 100;
+
+std::atomic<std::uint64_t> g_sink{0};     //防止循环被优化掉
+
+struct Record {
+    std::uint32_t id;
+    std::uint32_t region;
+    double price;
+    std::uint32_t quantity;
+};
+
+struct Line {
+    std::uint32_t id;
+    double total;
+};
+
+Line to_line(const Record& r) {
+    return Line{r.id, r.price * r.quantity};
+}
+
+bool in_region(const Record& r) {
+    return r.region == 3;
+}
+
+//filter -> transform -> take，每步一个vector
+ycstl::vector<Line> eager_report(const ycstl::vector<Record>& records) {
+    ycstl::vector<Record> selected;
+    for (const Record& r : records) {
+        if (in_region(r)) {
+            selected.push_back(r);
+        }
+    }
+    ycstl::vector<Line> lines;
+    for (const Record& r : selected) {
+        lines.push_back(to_line(r));
+    }
+    ycstl::vector<Line> top;
+    for (std::size_t i = 0; i != kTop && i != lines.size(); ++i) {
+        top.push_back(lines[i]);
+    }
+    return top;
+}
+
+ycstl::vector<Line> lazy_report(const ycstl::vector<Record>& records) {
+    return records | ycstl::views::filter(in_region) | ycstl::views::transform(to_line)
+                   | ycstl::views::take(kTop) | ycstl::to<ycstl::vector>();
+}
+
+//长度已知的管道：transform -> drop
+ycstl::vector<Line> eager_sized(const ycstl::vector<Record>& records) {
+    ycstl::vector<Line> lines;
+    for (const Record& r : records) {
+        lines.push_back(to_line(r));
+    }
+    ycstl::vector<Line> rest;
+    for (std::size_t i = 1; i < lines.size(); ++i) {
+        rest.push_back(lines[i]);
+    }
+    return rest;
+}
+
+ycstl::vector<Line> lazy_sized(const ycstl::vector<Record>& records) {
+    return records | ycstl::views::transform(to_line) | ycstl::views::drop(1) | ycstl::to<ycstl::vector>();
+}
+
+template<typename Function>
+void bench(const char* name, const ycstl::vector<Record>& records, Function f) {
+    std::size_t before = g_allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r != kRounds; ++r) {
+        ycstl::vector<Line> result = f(records);
+        g_sink.fetch_add(std::uint64_t(result.back().total) + result.size(), std::memory_order_relaxed);
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << double(g_allocations - before) / kRounds << " allocations/pipeline  "
+              << elapsed.count() / kRounds * 1000 << " us/pipeline\n";
+}
+
+}
+
+int main() {
+    ycstl::vector<Record> records;
+    records.reserve(kRecords);
+    for (std::uint32_t i = 0; i != kRecords; ++i) {
+        records.push_back(Record{i, i % 8, 1.0 + i % 100, i % 7 + 1});
+    }
+    bench("filter|transform|take  eager vectors  ", records, eager_report);
+    bench("filter|transform|take  views + to     ", records, lazy_report);
+    bench("transform|drop         eager vectors  ", records, eager_sized);
+    bench("transform|drop         views + to     ", records, lazy_sized);
+    return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * skip_list 与 std::map 的插入、查找、区间扫描对比，以及多线程无锁插入
+ *
+ * 编译: g++ -std=c++20 -O2 -pthread -I.. skip_list_bench.cpp -o skip_list_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "skip_list.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kElements = 1 << 20;
+constexpr std::size_t kScanLength = 100;
+
+template<typename Function>
+double time_ms(Function f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+template<typename Map>
+void run(const char* name, const std::vector<std::uint64_t>& keys) {
+    Map m;
+    volatile std::uint64_t sink = 0;
+    double insert_ms = time_ms([&] {
+        for (std::uint64_t key : keys) {
+            m.insert({key, key});
+        }
+    });
+    double find_ms = time_ms([&] {
+        std::uint64_t sum = 0;
+        for (std::uint64_t key : keys) {
+            sum += m.find(key)->second;
+        }
+        sink = sum;
+    });
+    double scan_ms = time_ms([&] {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < keys.size(); i += 64) {
+            auto it = m.lower_bound(keys[i]);
+            for (std::size_t n = 0; n != kScanLength && it != m.end(); ++n, ++it) {
+                sum += it->second;
+            }
+        }
+        sink = sum;
+    });
+    double iterate_ms = time_ms([&] {
+        std::uint64_t sum = 0;
+        for (auto it = m.begin(); it != m.end(); ++it) {
+            sum += it->second;
+        }
+        sink = sum;
+    });
+    (void)sink;
+    std::cout << name << "  insert " << insert_ms << " ms  find " << find_ms << " ms  scan "
+              << scan_ms << " ms  iterate " << iterate_ms << " ms\n";
+}
+
+//多线程插入互不相同的key：skip_list无锁，std::map用一把互斥锁保护
+void run_concurrent(std::size_t threads, const std::vector<std::uint64_t>& keys) {
+    ycstl::skip_list<std::uint64_t, std::uint64_t> sl;
+    std::map<std::uint64_t, std::uint64_t> m;
+    std::mutex mutex;
+    auto spawn = [&](auto body) {
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t != threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (std::size_t i = t; i < keys.size(); i += threads) {
+                    body(keys[i]);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    };
+    double sl_ms = time_ms([&] { spawn([&](std::uint64_t key) { sl.insert({key, key}); }); });
+    double map_ms = time_ms([&] {
+        spawn([&](std::uint64_t key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            m.insert({key, key});
+        });
+    });
+    std::cout << "threads " << threads << "  skip_list lock-free insert " << sl_ms
+              << " ms  std::map+mutex insert " << map_ms << " ms\n";
+}
+
+}
+
+int main() {
+    std::vector<std::uint64_t> keys(kElements);
+    std::mt19937_64 rng(7);
+    for (auto& key : keys) {
+        key = rng();
+    }
+    run<std::map<std::uint64_t, std::uint64_t>>("std::map        ", keys);
+    run<ycstl::skip_list<std::uint64_t, std::uint64_t>>("ycstl::skip_list", keys);
+
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    for (std::size_t threads = 1; threads <= (0 == max_threads ? 1 : max_threads); threads *= 2) {
+        run_concurrent(threads, keys);
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * ycstl::sort / stable_sort / radix_sort / stable_radix_sort 与 std::sort / std::stable_sort 的对比，
+ * 在ycstl::vector<uint64_t>、vector<double>、vector<pair<key, payload>>上按几种分布各排一次；
+ * 每个结果都和std::stable_sort的结果核对
+ *
+ * 编译: g++ -std=c++20 -O2 -I.. sort_bench.cpp -o sort_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "sort.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+
+namespace {
+
+constexpr std::size_t kElements = 1 << 22;
+
+template<typename Function>
+double time_ms(Function f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+struct Record {
+    std::uint64_t key;
+    std::uint64_t payload;
+};
+
+struct RecordKey {
+    std::uint64_t operator()(const Record& r) const noexcept {
+        return r.key;
+    }
+};
+
+struct RecordLess {
+    bool operator()(const Record& a, const Record& b) const noexcept {
+        return a.key < b.key;
+    }
+};
+
+bool operator==(const Record& a, const Record& b) {
+    return a.key == b.key && a.payload == b.payload;
+}
+
+ycstl::vector<std::uint64_t> make_keys(const std::string& distribution) {
+    ycstl::vector<std::uint64_t> keys(kElements);
+    std::mt19937_64 rng(42);
+    for (std::size_t i = 0; i != kElements; ++i) {
+        if ("random" == distribution) {
+            keys[i] = rng();
+        } else if ("random_32bit" == distribution) {
+            keys[i] = rng() >> 32;
+        } else if ("few_unique" == distribution) {
+            keys[i] = rng() % 16;
+        } else if ("sorted" == distribution) {
+            keys[i] = i;
+        } else if ("reversed" == distribution) {
+            keys[i] = kElements - i;
+        } else if ("organ_pipe" == distribution) {
+            keys[i] = i < kElements / 2 ? i : kElements - i;
+        } else {
+            //有序序列中随机交换1%
+            keys[i] = i;
+        }
+    }
+    if ("nearly_sorted" == distribution) {
+        for (std::size_t i = 0; i != kElements / 100; ++i) {
+            std::swap(keys[rng() % kElements], keys[rng() % kElements]);
+        }
+    }
+    return keys;
+}
+
+}
+
+int main() {
+    const char* distributions[] = {"random", "random_32bit", "few_unique", "sorted", "reversed", "organ_pipe", "nearly_sorted"};
+    for (const char* distribution : distributions) {
+        ycstl::vector<std::uint64_t> keys = make_keys(distribution);
+        ycstl::vector<std::uint64_t> expected = keys;
+        std::stable_sort(expected.begin(), expected.end());
+        ycstl::vector<std::uint64_t> buffer(kElements);
+
+        std::cout << "uint64_t  " << distribution << "\n";
+        auto run_u64 = [&](const char* name, auto sort) {
+            ycstl::vector<std::uint64_t> v = keys;
+            double ms = time_ms([&] { sort(v); });
+            bool ok = std::equal(v.begin(), v.end(), expected.begin(), expected.end());
+            std::cout << "    " << name << ms << " ms" << (ok ? "" : "  WRONG RESULT") << "\n";
+        };
+        run_u64("std::sort                ", [](auto& v) { std::sort(v.begin(), v.end()); });
+        run_u64("ycstl::sort              ", [](auto& v) { ycstl::sort(v); });
+        run_u64("std::stable_sort         ", [](auto& v) { std::stable_sort(v.begin(), v.end()); });
+        run_u64("ycstl::stable_sort       ", [&](auto& v) { ycstl::stable_sort(v, std::less<>(), buffer.data()); });
+        run_u64("ycstl::radix_sort        ", [](auto& v) { ycstl::radix_sort(v); });
+        run_u64("ycstl::stable_radix_sort ", [&](auto& v) { ycstl::stable_radix_sort(v, ycstl::identity_key(), buffer.data()); });
+
+        if (std::string("random") != distribution && std::string("few_unique") != distribution) {
+            continue;
+        }
+
+        //键值对：key相同的记录保持原来的相对顺序才算对
+        ycstl::vector<Record> records(kElements);
+        for (std::size_t i = 0; i != kElements; ++i) {
+            records[i] = Record{keys[i], i};
+        }
+        ycstl::vector<Record> expected_records = records;
+        std::stable_sort(expected_records.begin(), expected_records.end(), RecordLess());
+        ycstl::vector<Record> record_buffer(kElements);
+
+        std::cout << "pair<key, payload>  " << distribution << "\n";
+        auto run_records = [&](const char* name, bool stable, auto sort) {
+            ycstl::vector<Record> v = records;
+            double ms = time_ms([&] { sort(v); });
+            bool ok = stable ? std::equal(v.begin(), v.end(), expected_records.begin(), expected_records.end())
+                             : std::is_sorted(v.begin(), v.end(), RecordLess());
+            std::cout << "    " << name << ms << " ms" << (ok ? "" : "  WRONG RESULT") << "\n";
+        };
+        run_records("std::sort                ", false, [](auto& v) { std::sort(v.begin(), v.end(), RecordLess()); });
+        run_records("ycstl::sort              ", false, [](auto& v) { ycstl::sort(v, RecordLess()); });
+        run_records("ycstl::sort_branchless   ", false, [](auto& v) { ycstl::sort_branchless(v, RecordLess()); });
+        run_records("std::stable_sort         ", true, [](auto& v) { std::stable_sort(v.begin(), v.end(), RecordLess()); });
+        run_records("ycstl::stable_sort       ", true, [&](auto& v) { ycstl::stable_sort(v, RecordLess(), record_buffer.data()); });
+        run_records("ycstl::radix_sort        ", false, [](auto& v) { ycstl::radix_sort(v, RecordKey()); });
+        run_records("ycstl::stable_radix_sort ", true, [&](auto& v) { ycstl::stable_radix_sort(v, RecordKey(), record_buffer.data()); });
+    }
+
+    //浮点key，包含负数
+    ycstl::vector<double> doubles(kElements);
+    std::mt19937_64 rng(5);
+    std::normal_distribution<double> normal(0.0, 1e6);
+    for (double& d : doubles) {
+        d = normal(rng);
+    }
+    ycstl::vector<double> expected_doubles = doubles;
+    std::sort(expected_doubles.begin(), expected_doubles.end());
+    std::cout << "double  normal\n";
+    auto run_doubles = [&](const char* name, auto sort) {
+        ycstl::vector<double> v = doubles;
+        double ms = time_ms([&] { sort(v); });
+        bool ok = std::equal(v.begin(), v.end(), expected_doubles.begin(), expected_doubles.end());
+        std::cout << "    " << name << ms << " ms" << (ok ? "" : "  WRONG RESULT") << "\n";
+    };
+    run_doubles("std::sort                ", [](auto& v) { std::sort(v.begin(), v.end()); });
+    run_doubles("ycstl::sort              ", [](auto& v) { ycstl::sort(v); });
+    run_doubles("std::stable_sort         ", [](auto& v) { std::stable_sort(v.begin(), v.end()); });
+    run_doubles("ycstl::stable_sort       ", [](auto& v) { ycstl::stable_sort(v); });
+    run_doubles("ycstl::radix_sort        ", [](auto& v) { ycstl::radix_sort(v); });
+    run_doubles("ycstl::stable_radix_sort ", [](auto& v) { ycstl::stable_radix_sort(v); });
+    return 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * ycstl::string 与 std::string 的比较
+ * 拼接记录的key：23字节以内的key在ycstl::string里不分配，std::string超过15字节就要分配，allocs一列可以直接看出；
+ * 更长的key用small_string<31>；另外是排序(只有移动)、在长文本里find、长字符串和短key的比较
+ * 框架见harness.hpp，例如:
+ *   ./string_bench --filter=key
+ *
+ * 编译: g++ -std=c++20 -O2 -I.. string_bench.cpp -o string_bench
+ *
+ * @author YC奕晨
+ * */
+
+#include "harness.hpp"
+
+#include "string.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using ycstl::bench::do_not_optimize;
+
+constexpr std::size_t kKeys = 1 << 12;
+constexpr std::size_t kText = 1 << 14;
+constexpr std::size_t kCompare = 256;
+
+//prefix + 编号 + ':' + field
+template<typename String>
+String make_key(std::string_view prefix, std::size_t id, std::string_view field) {
+    String key;
+    key.append(prefix.data(), prefix.size());
+    char digits[20];
+    auto result = std::to_chars(digits, digits + sizeof(digits), id);
+    key.append(digits, result.ptr - digits);
+    key.push_back(':');
+    key.append(field.data(), field.size());
+    return key;
+}
+
+//key形如"user:12345678:profile"，21字节
+template<typename String>
+void key_build(std::size_t iterations) {
+    std::vector<String> keys;
+    keys.reserve(kKeys);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        keys.clear();
+        for (std::size_t i = 0; i != kKeys; ++i) {
+            keys.push_back(make_key<String>("user:", 10'000'000 + i * 7919, "profile"));
+        }
+        do_not_optimize(keys);
+    }
+}
+
+//key形如"session:12345678:last_login_at"，30字节
+template<typename String>
+void key_build_long(std::size_t iterations) {
+    std::vector<String> keys;
+    keys.reserve(kKeys);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        keys.clear();
+        for (std::size_t i = 0; i != kKeys; ++i) {
+            keys.push_back(make_key<String>("session:", 10'000'000 + i * 7919, "last_login_at"));
+        }
+        do_not_optimize(keys);
+    }
+}
+
+//每轮打乱后排序，只有比较和移动
+template<typename String>
+void sort_keys(std::size_t iterations) {
+    std::vector<String> keys;
+    for (std::size_t i = 0; i != kKeys; ++i) {
+        keys.push_back(make_key<String>("user:", 10'000'000 + i * 7919, "profile"));
+    }
+    std::mt19937 rng(3);
+    for (std::size_t it = 0; it != iterations; ++it) {
+        std::shuffle(keys.begin(), keys.end(), rng);
+        std::sort(keys.begin(), keys.end());
+        do_not_optimize(keys);
+    }
+}
+
+std::string make_text() {
+    std::string text(kText, ' ');
+    std::mt19937 rng(9);
+    for (char& c : text) {
+        c = char('a' + rng() % 26);
+    }
+    return text;
+}
+
+//needle不在文本里，每次都扫描全部kText个字节
+template<typename String>
+void find_substring(std::size_t iterations) {
+    std::string source = make_text();
+    String text(source.data(), source.size());
+    for (std::size_t it = 0; it != iterations; ++it) {
+        do_not_optimize(text);
+        std::size_t pos = text.find("zqxjzqxj", 0);
+        do_not_optimize(pos);
+    }
+}
+
+template<typename String>
+void find_char(std::size_t iterations) {
+    std::string source = make_text();
+    String text(source.data(), source.size());
+    for (std::size_t it = 0; it != iterations; ++it) {
+        do_not_optimize(text);
+        std::size_t pos = text.find('#', 0);
+        do_not_optimize(pos);
+    }
+}
+
+//只有最后一个字符不同
+template<typename String>
+void compare_long(std::size_t iterations) {
+    String a(kCompare, 'k');
+    String b(kCompare, 'k');
+    b.back() = 'l';
+    for (std::size_t it = 0; it != iterations; ++it) {
+        do_not_optimize(a);
+        bool equal = a == b;
+        int order = a.compare(b);
+        do_not_optimize(equal);
+        do_not_optimize(order);
+    }
+}
+
+//短key上的比较和找分隔符，每次操作一对key
+template<typename String>
+void compare_key(std::size_t iterations) {
+    std::vector<String> keys;
+    for (std::size_t i = 0; i != kKeys; ++i) {
+        keys.push_back(make_key<String>("user:", 10'000'000 + i, "profile"));
+    }
+    std::size_t equal = 0;
+    for (std::size_t it = 0; it != iterations; ++it) {
+        const String& a = keys[it % kKeys];
+        const String& b = keys[(it + 1) % kKeys];
+        equal += a == b;
+        equal += a.compare(b) < 0;
+        equal += a.find(':', 5);
+        do_not_optimize(equal);
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    using YString = ycstl::string;
+    using YString31 = ycstl::small_string<31>;
+    using SString = std::string;
+
+    ycstl::bench::Harness harness(argc, argv);
+    harness.add("string/key_build", "string", kKeys, key_build<YString>);
+    harness.add("string/key_build", "std", kKeys, key_build<SString>);
+    harness.add("string/key_build_long", "string", kKeys, key_build_long<YString>);
+    harness.add("string/key_build_long", "small", kKeys, key_build_long<YString31>);
+    harness.add("string/key_build_long", "std", kKeys, key_build_long<SString>);
+    harness.add("string/sort", "string", kKeys, sort_keys<YString>);
+    harness.add("string/sort", "std", kKeys, sort_keys<SString>);
+    harness.add("string/find", "string", kText, find_substring<YString>);
+    harness.add("string/find", "std", kText, find_substring<SString>);
+    harness.add("string/find_char", "string", kText, find_char<YString>);
+    harness.add("string/find_char", "std", kText, find_char<SString>);
+    harness.add("string/compare", "string", kCompare, compare_long<YString>);
+    harness.add("string/compare", "std", kCompare, compare_long<SString>);
+    harness.add("string/compare_key", "string", 1, compare_key<YString>);
+    harness.add("string/compare_key", "std", 1, compare_key<SString>);
+    return harness.run();
+}
@@ -0,0 +1,264 @@
+/**
+ * 实现caching_allocator
+ *
+ * 按大小分档的线程缓存分配器：
+ * 每个线程每档一条空闲链表，分配和释放都不加锁；
+ * 链表为空时从中心链表整批取回，超过上限时整批还给中心链表，每档中心链表一把锁；
+ * 别的线程释放的内存直接进入释放线程自己的缓存，多出来的部分同样整批回到中心链表，
+ * 所以跨线程释放不需要额外的同步；
+ * 超过kMaxSmallSize或对齐要求超过16字节的分配直接交给operator new
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef CACHING_ALLOCATOR_HPP_
+#define CACHING_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace ycstl {
+
+//空闲块：next_串起同一批中的块，next_batch_只在每批的第一个块中有效
+struct CachingFreeBlock {
+    CachingFreeBlock* next_;
+    CachingFreeBlock* next_batch_;
+};
+
+struct CachingSizeClass {
+    static constexpr std::size_t kAlignment = 16;
+    static constexpr std::size_t kMaxSmallSize = 32 * 1024;
+    static constexpr std::size_t kClassCount = 23;     // 16..256每16字节一档，之后每档翻倍到32KiB
+    static constexpr std::size_t kBatchBytes = 8 * 1024;
+    static constexpr std::size_t kSpanBytes = 64 * 1024;
+
+    static std::size_t index(std::size_t bytes) noexcept {
+        if (bytes <= 256) {
+            return bytes <= 16 ? 0 : (bytes + 15) / 16 - 1;
+        }
+        std::size_t i = 16;
+        std::size_t size = 512;
+        while (size < bytes) {
+            size <<= 1;
+            ++i;
+        }
+        return i;
+    }
+
+    static constexpr std::size_t size(std::size_t index) noexcept {
+        return index < 16 ? (index + 1) * 16 : std::size_t(512) << (index - 16);
+    }
+
+    //中心链表和线程缓存之间一次转移的块数
+    static constexpr std::size_t batch(std::size_t index) noexcept {
+        std::size_t n = kBatchBytes / size(index);
+        return n < 4 ? 4 : (n > 64 ? 64 : n);
+    }
+};
+
+//每档一条按批组织的中心链表，从中取出或放回都是一整批
+class CachingCentralList {
+public:
+    //取走一批，没有时切一块新的span
+    CachingFreeBlock* fetch(std::size_t index) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (nullptr == batches_) {
+            carve(index);
+        }
+        CachingFreeBlock* batch = batches_;
+        batches_ = batch->next_batch_;
+        return batch;
+    }
+
+    void give_back(CachingFreeBlock* batch) noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batch->next_batch_ = batches_;
+        batches_ = batch;
+    }
+
+private:
+    //span不归还给系统，只在各线程和中心链表之间循环使用
+    void carve(std::size_t index) {
+        std::size_t size = CachingSizeClass::size(index);
+        std::size_t per_batch = CachingSizeClass::batch(index);
+        std::size_t batch_bytes = size * per_batch;
+        std::size_t count = CachingSizeClass::kSpanBytes > batch_bytes ? CachingSizeClass::kSpanBytes / batch_bytes : 1;
+        char* span = static_cast<char*>(::operator new(count * batch_bytes));
+        for (std::size_t b = 0; b != count; ++b) {
+            char* base = span + b * batch_bytes;
+            for (std::size_t i = 0; i != per_batch; ++i) {
+                CachingFreeBlock* block = reinterpret_cast<CachingFreeBlock*>(base + i * size);
+                block->next_ = i + 1 == per_batch ? nullptr : reinterpret_cast<CachingFreeBlock*>(base + (i + 1) * size);
+            }
+            CachingFreeBlock* head = reinterpret_cast<CachingFreeBlock*>(base);
+            head->next_batch_ = batches_;
+            batches_ = head;
+        }
+    }
+
+    std::mutex mutex_;
+    CachingFreeBlock* batches_ = nullptr;
+};
+
+//进程内唯一，故意不析构，静态对象析构时仍可以释放内存
+inline CachingCentralList* caching_central_lists() {
+    static CachingCentralList* lists = new CachingCentralList[CachingSizeClass::kClassCount];
+    return lists;
+}
+
+class CachingThreadCache {
+public:
+    explicit CachingThreadCache(bool* dead) noexcept : dead_(dead) {}
+
+    //线程退出时把缓存全部还给中心链表
+    ~CachingThreadCache() {
+        for (std::size_t i = 0; i != CachingSizeClass::kClassCount; ++i) {
+            if (nullptr != lists_[i].head_) {
+                caching_central_lists()[i].give_back(lists_[i].head_);
+            }
+        }
+        *dead_ = true;
+    }
+
+    CachingThreadCache(const CachingThreadCache&) = delete;
+    CachingThreadCache& operator=(const CachingThreadCache&) = delete;
+
+    void* allocate(std::size_t index) {
+        List& list = lists_[index];
+        if (nullptr == list.head_) {
+            list.head_ = caching_central_lists()[index].fetch(index);
+            //线程退出时还回来的批可能不满，按实际长度计数
+            list.count_ = 0;
+            for (CachingFreeBlock* block = list.head_; nullptr != block; block = block->next_) {
+                ++list.count_;
+            }
+        }
+        CachingFreeBlock* block = list.head_;
+        list.head_ = block->next_;
+        --list.count_;
+        return block;
+    }
+
+    //超过两批时把表头的一批还回去
+    void deallocate(void* p, std::size_t index) noexcept {
+        List& list = lists_[index];
+        CachingFreeBlock* block = static_cast<CachingFreeBlock*>(p);
+        block->next_ = list.head_;
+        list.head_ = block;
+        ++list.count_;
+        std::size_t per_batch = CachingSizeClass::batch(index);
+        if (list.count_ > 2 * per_batch) {
+            CachingFreeBlock* first = list.head_;
+            CachingFreeBlock* last = first;
+            for (std::size_t i = 1; i != per_batch; ++i) {
+                last = last->next_;
+            }
+            list.head_ = last->next_;
+            last->next_ = nullptr;
+            list.count_ -= per_batch;
+            caching_central_lists()[index].give_back(first);
+        }
+    }
+
+private:
+    struct List {
+        CachingFreeBlock* head_ = nullptr;
+        std::size_t count_ = 0;
+    };
+
+    List lists_[CachingSizeClass::kClassCount];
+    bool* dead_;
+};
+
+//本线程的缓存已经析构(线程退出阶段)时返回nullptr
+inline CachingThreadCache* caching_thread_cache() noexcept {
+    thread_local bool dead = false;
+    if (dead) {
+        return nullptr;
+    }
+    thread_local CachingThreadCache cache(&dead);
+    return &cache;
+}
+
+inline void* caching_allocate(std::size_t bytes, std::size_t align) {
+    if (align > CachingSizeClass::kAlignment) {
+        return ::operator new(bytes, std::align_val_t(align));
+    }
+    if (bytes > CachingSizeClass::kMaxSmallSize) {
+        return ::operator new(bytes);
+    }
+    std::size_t index = CachingSizeClass::index(bytes);
+    if (CachingThreadCache* cache = caching_thread_cache()) {
+        return cache->allocate(index);
+    }
+    //线程缓存已经析构，单个块直接从中心链表取
+    CachingFreeBlock* batch = caching_central_lists()[index].fetch(index);
+    if (nullptr != batch->next_) {
+        batch->next_->next_batch_ = nullptr;
+        caching_central_lists()[index].give_back(batch->next_);
+    }
+    return batch;
+}
+
+inline void caching_deallocate(void* p, std::size_t bytes, std::size_t align) noexcept {
+    if (align > CachingSizeClass::kAlignment) {
+        ::operator delete(p, std::align_val_t(align));
+        return;
+    }
+    if (bytes > CachingSizeClass::kMaxSmallSize) {
+        ::operator delete(p);
+        return;
+    }
+    std::size_t index = CachingSizeClass::index(bytes);
+    if (CachingThreadCache* cache = caching_thread_cache()) {
+        cache->deallocate(p, index);
+        return;
+    }
+    CachingFreeBlock* block = static_cast<CachingFreeBlock*>(p);
+    block->next_ = nullptr;
+    caching_central_lists()[index].give_back(block);
+}
+
+//无状态，所有实例共享同一组线程缓存，可以互相释放
+template<typename T>
+class caching_allocator {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using is_always_equal = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    constexpr caching_allocator() noexcept = default;
+
+    template<typename U>
+    constexpr caching_allocator(const caching_allocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        if (n > std::size_t(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(caching_allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        caching_deallocate(p, n * sizeof(T), alignof(T));
+    }
+};
+
+template<typename T, typename U>
+constexpr bool operator==(const caching_allocator<T>&, const caching_allocator<U>&) noexcept {
+    return true;
+}
+
+template<typename T, typename U>
+constexpr bool operator!=(const caching_allocator<T>&, const caching_allocator<U>&) noexcept {
+    return false;
+}
+
+}   //ycstl
+
+#endif
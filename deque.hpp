@@ -0,0 +1,731 @@
+/**
+ * 实现deque
+ *
+ * 元素存放在固定大小的块里，map_是一张块指针表，已用的块在map_中连续；
+ * 两端都没有空位时先把已用部分挪到map_中间，已用部分超过一半才把map_扩大一倍，
+ * 所以push_front / push_back都是均摊O(1)，并且不会移动已有元素；
+ * 空出来的块先放进spare_，下次需要新块时直接复用，队列式的使用不再反复向分配器要内存
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef DEQUE_HPP_
+#define DEQUE_HPP_
+
+#include "memory.hpp"
+#include "memory_resource.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ycstl {
+
+template<typename T, typename Allocator = std::allocator<T>>
+class deque {
+    template<bool Const>
+    class BasicIterator;
+
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using MapAllocator = typename AllocTraits::template rebind_alloc<T*>;
+
+    //每块约4KB，元素较大时至少16个；取2的幂，下标换算只需要移位
+    static constexpr std::size_t kBlockSize = sizeof(T) <= 256 ? std::bit_floor(4096 / sizeof(T)) : 16;
+    static constexpr std::size_t kSpareBlocks = 2;
+    static constexpr std::size_t kMinMapSize = 8;
+
+public:
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using iterator               = BasicIterator<false>;
+    using const_iterator         = BasicIterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    deque() noexcept : deque(Allocator()) {}
+
+    explicit deque(const Allocator& alloc) noexcept : alloc_(alloc) {}
+
+    explicit deque(size_type n, const Allocator& alloc = Allocator()) : deque(alloc) {
+        resize(n);
+    }
+
+    deque(size_type n, const T& value, const Allocator& alloc = Allocator()) : deque(alloc) {
+        resize(n, value);
+    }
+
+    template<typename InputIter, typename = std::void_t<
+        decltype(*std::declval<InputIter>()),
+        decltype(++std::declval<InputIter&>())
+    >>
+    deque(InputIter first, InputIter last, const Allocator& alloc = Allocator()) : deque(alloc) {
+        append(first, last);
+    }
+
+    deque(std::initializer_list<T> il, const Allocator& alloc = Allocator()) : deque(il.begin(), il.end(), alloc) {}
+
+    //拷贝构造，分配器由select_on_container_copy_construction决定
+    deque(const deque& d) : deque(d, AllocTraits::select_on_container_copy_construction(d.alloc_)) {}
+
+    deque(const deque& d, const Allocator& alloc) : deque(alloc) {
+        append(d.begin(), d.end());
+    }
+
+    deque(deque&& d) noexcept : alloc_(std::move(d.alloc_)) {
+        steal(d);
+    }
+
+    //分配器不相等时不能接管d的块，逐个移动元素
+    deque(deque&& d, const Allocator& alloc) : deque(alloc) {
+        if (alloc_ == d.alloc_) {
+            steal(d);
+        } else {
+            append(std::make_move_iterator(d.begin()), std::make_move_iterator(d.end()));
+            d.clear();
+        }
+    }
+
+    ~deque() {
+        release_storage();
+    }
+
+    deque& operator=(const deque& d) {
+        if (this == &d) {
+            return *this;
+        }
+        clear();
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+            if (!(alloc_ == d.alloc_)) {
+                release_storage();
+            }
+            alloc_ = d.alloc_;
+        }
+        append(d.begin(), d.end());
+        return *this;
+    }
+
+    //分配器传播或相等时直接接管d的块，否则只能在自己的分配器上逐个移动元素
+    deque& operator=(deque&& d) noexcept(AllocTraits::propagate_on_container_move_assignment::value ||
+                                         AllocTraits::is_always_equal::value) {
+        if (this == &d) {
+            return *this;
+        }
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            release_storage();
+            alloc_ = std::move(d.alloc_);
+        } else if (!(alloc_ == d.alloc_)) {
+            clear();
+            append(std::make_move_iterator(d.begin()), std::make_move_iterator(d.end()));
+            d.clear();
+            return *this;
+        } else {
+            release_storage();
+        }
+        steal(d);
+        return *this;
+    }
+
+    deque& operator=(std::initializer_list<T> ilist) {
+        assign(ilist);
+        return *this;
+    }
+
+    void assign(size_type n, const T& value) {
+        clear();
+        resize(n, value);
+    }
+
+    template<typename InputIter, typename = std::void_t<
+        decltype(*std::declval<InputIter>()),
+        decltype(++std::declval<InputIter&>())
+    >>
+    void assign(InputIter first, InputIter last) {
+        clear();
+        append(first, last);
+    }
+
+    void assign(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return alloc_;
+    }
+
+    reference at(size_type pos) {
+        if (pos >= size_) {
+            throw std::out_of_range("index out of range");
+        }
+        return *element(start_ + pos);
+    }
+
+    const_reference at(size_type pos) const {
+        if (pos >= size_) {
+            throw std::out_of_range("index out of range");
+        }
+        return *element(start_ + pos);
+    }
+
+    reference operator[](size_type pos) {
+        return *element(start_ + pos);
+    }
+
+    const_reference operator[](size_type pos) const {
+        return *element(start_ + pos);
+    }
+
+    reference front() {
+        return *element(start_);
+    }
+
+    const_reference front() const {
+        return *element(start_);
+    }
+
+    reference back() {
+        return *element(start_ + size_ - 1);
+    }
+
+    const_reference back() const {
+        return *element(start_ + size_ - 1);
+    }
+
+    iterator begin() noexcept {
+        return make_iterator<false>(start_);
+    }
+
+    const_iterator begin() const noexcept {
+        return make_iterator<true>(start_);
+    }
+
+    iterator end() noexcept {
+        return make_iterator<false>(start_ + size_);
+    }
+
+    const_iterator end() const noexcept {
+        return make_iterator<true>(start_ + size_);
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    bool empty() const noexcept {
+        return 0 == size_;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    size_type max_size() const noexcept {
+        return AllocTraits::max_size(alloc_);
+    }
+
+    //把留作复用的空块还给分配器，map_本身不缩小
+    void shrink_to_fit() noexcept {
+        while (0 != spare_count_) {
+            AllocTraits::deallocate(alloc_, spare_[--spare_count_], kBlockSize);
+        }
+    }
+
+    //析构所有元素，块进入spare_或还给分配器，map_保留并把起点放回中间
+    void clear() noexcept {
+        if (nullptr == map_) {
+            return;
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type pos = start_; pos != start_ + size_; ++pos) {
+                AllocTraits::destroy(alloc_, element(pos));
+            }
+        }
+        for (size_type node = start_ / kBlockSize; node <= (start_ + size_) / kBlockSize; ++node) {
+            if (nullptr != map_[node]) {
+                release_block(map_[node]);
+                map_[node] = nullptr;
+            }
+        }
+        start_ = map_size_ / 2 * kBlockSize;
+        size_ = 0;
+    }
+
+    template<typename... Args>
+    reference emplace_back(Args&&... args) {
+        if ((start_ + size_ + 1) / kBlockSize >= map_size_) {
+            reserve_map(false);
+        }
+        //构造失败时新块留在末尾那一格，仍然满足已用块连续的约定
+        T* p = acquire(start_ + size_);
+        AllocTraits::construct(alloc_, p, std::forward<Args>(args)...);
+        ++size_;
+        return *p;
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    template<typename... Args>
+    reference emplace_front(Args&&... args) {
+        if (0 == start_) {
+            reserve_map(true);
+        }
+        size_type pos = start_ - 1;
+        bool fresh = nullptr == map_[pos / kBlockSize];
+        T* p = acquire(pos);
+        try {
+            AllocTraits::construct(alloc_, p, std::forward<Args>(args)...);
+        } catch (...) {
+            if (fresh) {
+                release_block(map_[pos / kBlockSize]);
+                map_[pos / kBlockSize] = nullptr;
+            }
+            throw;
+        }
+        start_ = pos;
+        ++size_;
+        return *p;
+    }
+
+    void push_front(const T& value) {
+        emplace_front(value);
+    }
+
+    void push_front(T&& value) {
+        emplace_front(std::move(value));
+    }
+
+    //最后一块空出来时回收，末尾所在的块即使为空也保留，下一次push_back直接用
+    void pop_back() {
+        --size_;
+        size_type pos = start_ + size_;
+        AllocTraits::destroy(alloc_, element(pos));
+        size_type old_end = (pos + 1) / kBlockSize;
+        if (old_end != pos / kBlockSize && nullptr != map_[old_end]) {
+            release_block(map_[old_end]);
+            map_[old_end] = nullptr;
+        }
+    }
+
+    void pop_front() {
+        AllocTraits::destroy(alloc_, element(start_));
+        ++start_;
+        --size_;
+        if (0 == start_ % kBlockSize) {
+            size_type old_first = start_ / kBlockSize - 1;
+            release_block(map_[old_first]);
+            map_[old_first] = nullptr;
+        }
+    }
+
+    //从离pos较近的一端挪动元素腾出位置
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        size_type index = pos - cbegin();
+        if (0 == index) {
+            emplace_front(std::forward<Args>(args)...);
+            return begin();
+        }
+        if (size_ == index) {
+            emplace_back(std::forward<Args>(args)...);
+            return end() - 1;
+        }
+        T value(std::forward<Args>(args)...);
+        if (index < size_ / 2) {
+            emplace_front(std::move(front()));
+            std::move(begin() + 2, begin() + (index + 1), begin() + 1);
+        } else {
+            emplace_back(std::move(back()));
+            std::move_backward(begin() + index, end() - 2, end() - 1);
+        }
+        (*this)[index] = std::move(value);
+        return begin() + index;
+    }
+
+    iterator insert(const_iterator pos, const T& value) {
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator pos, T&& value) {
+        return emplace(pos, std::move(value));
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    //[first, last)前面的元素少就把前面整体后移，否则把后面整体前移
+    iterator erase(const_iterator first, const_iterator last) {
+        size_type index = first - cbegin();
+        size_type n = last - first;
+        if (0 == n) {
+            return begin() + index;
+        }
+        if (index < (size_ - n) / 2) {
+            std::move_backward(begin(), begin() + index, begin() + (index + n));
+            for (size_type i = 0; i != n; ++i) {
+                pop_front();
+            }
+        } else {
+            std::move(begin() + (index + n), end(), begin() + index);
+            for (size_type i = 0; i != n; ++i) {
+                pop_back();
+            }
+        }
+        return begin() + index;
+    }
+
+    void resize(size_type n) {
+        while (size_ > n) {
+            pop_back();
+        }
+        while (size_ < n) {
+            emplace_back();
+        }
+    }
+
+    void resize(size_type n, const T& value) {
+        while (size_ > n) {
+            pop_back();
+        }
+        while (size_ < n) {
+            emplace_back(value);
+        }
+    }
+
+    //propagate_on_container_swap为false时两个分配器必须相等
+    void swap(deque& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
+        std::swap(map_, other.map_);
+        std::swap(map_size_, other.map_size_);
+        std::swap(start_, other.start_);
+        std::swap(size_, other.size_);
+        std::swap(spare_, other.spare_);
+        std::swap(spare_count_, other.spare_count_);
+    }
+
+private:
+    //pos是在整张map_上的下标
+    T* element(size_type pos) const noexcept {
+        return map_[pos / kBlockSize] + pos % kBlockSize;
+    }
+
+    template<bool Const>
+    BasicIterator<Const> make_iterator(size_type pos) const noexcept {
+        if (nullptr == map_) {
+            return BasicIterator<Const>();
+        }
+        T** node = map_ + pos / kBlockSize;
+        return BasicIterator<Const>(*node + pos % kBlockSize, node);
+    }
+
+    //pos所在的块不存在时取一个，优先用spare_里的
+    T* acquire(size_type pos) {
+        T*& block = map_[pos / kBlockSize];
+        if (nullptr == block) {
+            block = 0 != spare_count_ ? spare_[--spare_count_] : AllocTraits::allocate(alloc_, kBlockSize);
+        }
+        return block + pos % kBlockSize;
+    }
+
+    void release_block(T* block) noexcept {
+        if (spare_count_ != kSpareBlocks) {
+            spare_[spare_count_++] = block;
+        } else {
+            AllocTraits::deallocate(alloc_, block, kBlockSize);
+        }
+    }
+
+    //保证at_front时start_ > 0，否则末尾后面还有一格；
+    //map_足够大时只把已用的块挪到中间，不够时扩大到至少两倍
+    void reserve_map(bool at_front) {
+        size_type first_node = start_ / kBlockSize;
+        size_type used = (start_ + size_) / kBlockSize - first_node + 1;
+        size_type needed = used + 1;
+        size_type new_first;
+        if (map_size_ >= 2 * needed) {
+            new_first = (map_size_ - needed) / 2 + (at_front ? 1 : 0);
+            if (new_first < first_node) {
+                std::copy(map_ + first_node, map_ + first_node + used, map_ + new_first);
+            } else {
+                std::copy_backward(map_ + first_node, map_ + first_node + used, map_ + new_first + used);
+            }
+            std::fill(map_, map_ + new_first, nullptr);
+            std::fill(map_ + new_first + used, map_ + map_size_, nullptr);
+        } else {
+            MapAllocator map_alloc(alloc_);
+            size_type new_size = std::max({2 * map_size_, 2 * needed, kMinMapSize});
+            T** new_map = map_alloc.allocate(new_size);
+            std::fill(new_map, new_map + new_size, nullptr);
+            new_first = (new_size - needed) / 2 + (at_front ? 1 : 0);
+            if (nullptr != map_) {
+                std::copy(map_ + first_node, map_ + first_node + used, new_map + new_first);
+                map_alloc.deallocate(map_, map_size_);
+            }
+            map_ = new_map;
+            map_size_ = new_size;
+        }
+        start_ = new_first * kBlockSize + start_ % kBlockSize;
+    }
+
+    template<typename InputIter>
+    void append(InputIter first, InputIter last) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    void steal(deque& d) noexcept {
+        map_ = d.map_;
+        map_size_ = d.map_size_;
+        start_ = d.start_;
+        size_ = d.size_;
+        spare_count_ = d.spare_count_;
+        std::copy(d.spare_, d.spare_ + kSpareBlocks, spare_);
+        d.map_ = nullptr;
+        d.map_size_ = 0;
+        d.start_ = 0;
+        d.size_ = 0;
+        d.spare_count_ = 0;
+    }
+
+    void release_storage() noexcept {
+        clear();
+        shrink_to_fit();
+        if (nullptr != map_) {
+            MapAllocator map_alloc(alloc_);
+            map_alloc.deallocate(map_, map_size_);
+        }
+        map_ = nullptr;
+        map_size_ = 0;
+        start_ = 0;
+    }
+
+private:
+    T** map_ = nullptr;
+    size_type map_size_ = 0;
+    size_type start_ = 0;           // 第一个元素在整张map_上的下标
+    size_type size_ = 0;
+    T* spare_[kSpareBlocks] = {};
+    size_type spare_count_ = 0;
+    YCSTL_NO_UNIQUE_ADDRESS Allocator alloc_;
+
+    //块内指针 + 所在的map_格子；末尾所在的块可能还没分配，此时cur_为nullptr
+    template<bool Const>
+    class BasicIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        BasicIterator() noexcept : cur_(nullptr), node_(nullptr) {}
+
+        BasicIterator(T* cur, T** node) noexcept : cur_(cur), node_(node) {}
+
+        // 允许从iterator转换成const_iterator
+        template<bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& it) noexcept : cur_(it.cur_), node_(it.node_) {}
+
+        reference operator*() const {
+            return *cur_;
+        }
+
+        pointer operator->() const {
+            return cur_;
+        }
+
+        reference operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        BasicIterator& operator++() {
+            if (++cur_ == *node_ + kBlockSize) {
+                ++node_;
+                cur_ = *node_;
+            }
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        BasicIterator& operator--() {
+            if (cur_ == *node_) {
+                --node_;
+                cur_ = *node_ + kBlockSize;
+            }
+            --cur_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) {
+            BasicIterator it(*this);
+            --*this;
+            return it;
+        }
+
+        //从未分配过的deque返回的迭代器node_为空，n为0时不能去读*node_
+        BasicIterator& operator+=(difference_type n) {
+            if (0 == n) {
+                return *this;
+            }
+            constexpr difference_type kBlock = kBlockSize;
+            difference_type offset = n + (cur_ - *node_);
+            if (offset >= 0 && offset < kBlock) {
+                cur_ += n;
+            } else {
+                difference_type nodes = offset > 0 ? offset / kBlock : -((-offset - 1) / kBlock) - 1;
+                node_ += nodes;
+                cur_ = *node_ + (offset - nodes * kBlock);
+            }
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type n) {
+            return *this += -n;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type n) {
+            return it += n;
+        }
+
+        friend BasicIterator operator+(difference_type n, BasicIterator it) {
+            return it += n;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type n) {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const BasicIterator& a, const BasicIterator& b) {
+            if (a.node_ == b.node_) {
+                return a.cur_ - b.cur_;
+            }
+            return (a.node_ - b.node_) * difference_type(kBlockSize) + (a.cur_ - *a.node_) - (b.cur_ - *b.node_);
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+            return a.cur_ == b.cur_ && a.node_ == b.node_;
+        }
+
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+            return !(a == b);
+        }
+
+        friend bool operator<(const BasicIterator& a, const BasicIterator& b) {
+            return a.node_ == b.node_ ? a.cur_ < b.cur_ : a.node_ < b.node_;
+        }
+
+        friend bool operator>(const BasicIterator& a, const BasicIterator& b) {
+            return b < a;
+        }
+
+        friend bool operator<=(const BasicIterator& a, const BasicIterator& b) {
+            return !(b < a);
+        }
+
+        friend bool operator>=(const BasicIterator& a, const BasicIterator& b) {
+            return !(a < b);
+        }
+
+    private:
+        T* cur_;
+        T** node_;
+        template<bool> friend class BasicIterator;
+        friend class deque;
+    };
+};
+
+static_assert(sizeof(deque<int>) == 7 * sizeof(int*), "stateless allocator must not enlarge deque");
+
+template<typename T, typename Allocator>
+void swap(deque<T, Allocator>& a, deque<T, Allocator>& b) noexcept {
+    a.swap(b);
+}
+
+template<typename T, typename Allocator>
+bool operator==(const deque<T, Allocator>& a, const deque<T, Allocator>& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template<typename T, typename Allocator>
+bool operator!=(const deque<T, Allocator>& a, const deque<T, Allocator>& b) {
+    return !(a == b);
+}
+
+template<typename T, typename Allocator>
+bool operator<(const deque<T, Allocator>& a, const deque<T, Allocator>& b) {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+namespace pmr {
+template<typename T>
+using deque = ycstl::deque<T, polymorphic_allocator<T>>;
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const ycstl::deque<T>& d) {
+    os << "{";
+    for (auto it = d.begin(); it != d.end(); ++it) {
+        if (it != d.begin()) {
+            os << ", ";
+        }
+        os << *it;
+    }
+    os << "}";
+    return os;
+}
+
+}   //ycstl
+
+#endif
@@ -0,0 +1,198 @@
+/**
+ * 实现基于epoch的内存回收
+ * epoch_domain
+ * epoch_domain::guard
+ *
+ * 读者进入临界区时登记当前全局epoch，写者把摘下的对象连同当时的epoch放入本线程的退休列表；
+ * 全局epoch前进两次之后，退休前进入临界区的读者一定都已离开，此时批量释放
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef EPOCH_HPP_
+#define EPOCH_HPP_
+
+#include "memory.hpp"
+#include "thread_record.hpp"
+#include "vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace ycstl {
+
+struct EpochRetired {
+    void* ptr_;
+    void (*free_)(void*);
+    std::uint64_t epoch_;
+};
+
+//每个线程在每个domain中一条记录，state_ = (epoch << 1) | 是否在临界区中
+struct EpochRecord {
+    std::atomic<std::uint64_t> state_{0};
+    std::atomic<bool> in_use_{true};
+    EpochRecord* next_ = nullptr;
+    unsigned nesting_ = 0;
+    ycstl::vector<EpochRetired> retired_;
+};
+
+class epoch_domain {
+public:
+    //读临界区，析构时离开；同一线程可以嵌套
+    class guard {
+    public:
+        guard() noexcept : record_(nullptr) {}
+
+        explicit guard(EpochRecord* record) noexcept : record_(record) {}
+
+        guard(guard&& g) noexcept : record_(g.record_) {
+            g.record_ = nullptr;
+        }
+
+        guard& operator=(guard&& g) noexcept {
+            if (&g != this) {
+                reset();
+                record_ = g.record_;
+                g.record_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~guard() {
+            reset();
+        }
+
+        void reset() noexcept {
+            if (nullptr == record_) {
+                return;
+            }
+            if (0 == --record_->nesting_) {
+                record_->state_.store(record_->state_.load(std::memory_order_relaxed) & ~std::uint64_t(1),
+                                      std::memory_order_release);
+            }
+            record_ = nullptr;
+        }
+
+        guard(const guard&) = delete;
+        guard& operator=(const guard&) = delete;
+
+    private:
+        EpochRecord* record_;
+    };
+
+    //线程退出时记录标记为空闲，留给之后的线程复用，未释放的退休对象随记录一起转交
+    epoch_domain() : epoch_(0) {}
+
+    //销毁时不能再有线程处于临界区，所有尚未释放的对象在此释放
+    ~epoch_domain() {
+        records_.close();
+        for (EpochRecord* record = records_.head(); nullptr != record; record = record->next_) {
+            for (std::size_t i = 0; i != record->retired_.size(); ++i) {
+                record->retired_[i].free_(record->retired_[i].ptr_);
+            }
+        }
+    }
+
+    epoch_domain(const epoch_domain&) = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+    static epoch_domain& global() {
+        static epoch_domain domain;
+        return domain;
+    }
+
+    guard pin() {
+        EpochRecord* record = local_record();
+        if (0 == record->nesting_++) {
+            std::uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+            record->state_.store((epoch << 1) | 1, std::memory_order_seq_cst);
+            //登记之后的读(如rcu_vector::read对current_的acquire读)不能提前到登记之前，
+            //否则推进epoch的线程可能看不到这次登记，提前释放读者正要使用的对象
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        return guard(record);
+    }
+
+    //p已经对新读者不可见；等所有可能看到它的读者离开后用Deleter释放
+    template<typename T, typename Deleter = default_delete<T>>
+    void retire(T* p) {
+        EpochRecord* record = local_record();
+        record->retired_.push_back(EpochRetired{
+            const_cast<void*>(static_cast<const void*>(p)), &free_retired<T, Deleter>, epoch_.load(std::memory_order_seq_cst)});
+        if (record->retired_.size() >= kCollectThreshold) {
+            try_advance();
+            reclaim(record);
+        }
+    }
+
+    //尝试推进epoch并释放本线程中已经安全的对象，不阻塞
+    void collect() {
+        try_advance();
+        reclaim(local_record());
+    }
+
+    //阻塞直到调用前退休的对象全部可以释放；不能在本线程的临界区内调用
+    void synchronize() {
+        std::uint64_t target = epoch_.load(std::memory_order_seq_cst) + 2;
+        while (epoch_.load(std::memory_order_seq_cst) < target) {
+            if (!try_advance()) {
+                std::this_thread::yield();
+            }
+        }
+        reclaim(local_record());
+    }
+
+    //本线程等待释放的对象数
+    std::size_t pending() {
+        return local_record()->retired_.size();
+    }
+
+private:
+    static constexpr std::size_t kCollectThreshold = 64;
+
+    template<typename T, typename Deleter>
+    static void free_retired(void* p) {
+        Deleter()(static_cast<T*>(p));
+    }
+
+    EpochRecord* local_record() {
+        return records_.local();
+    }
+
+    //所有处于临界区的线程都已看到当前epoch时才能前进
+    bool try_advance() {
+        //与pin()中的栅栏配对：摘下对象的写(可能只是acq_rel)先于下面对各线程登记的读
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+        for (EpochRecord* record = records_.head(); nullptr != record; record = record->next_) {
+            std::uint64_t state = record->state_.load(std::memory_order_seq_cst);
+            if ((state & 1) && (state >> 1) != epoch) {
+                return false;
+            }
+        }
+        return epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+    }
+
+    void reclaim(EpochRecord* record) {
+        std::uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+        ycstl::vector<EpochRetired>& retired = record->retired_;
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i != retired.size(); ++i) {
+            if (retired[i].epoch_ + 2 <= epoch) {
+                retired[i].free_(retired[i].ptr_);
+            } else {
+                retired[kept++] = retired[i];
+            }
+        }
+        retired.resize(kept);
+    }
+
+    std::atomic<std::uint64_t> epoch_;
+    ThreadRecordList<EpochRecord> records_;
+};
+
+}   //ycstl
+
+#endif
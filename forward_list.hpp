@@ -0,0 +1,664 @@
+/**
+ * 实现forward_list
+ *
+ * 单向链表，节点只保存一个next_指针，头节点内嵌在容器中不需要额外分配
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef FORWARD_LIST_HPP_
+#define FORWARD_LIST_HPP_
+
+#include "memory.hpp"
+#include "memory_resource.hpp"
+
+#include <memory>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <iostream>
+
+namespace ycstl {
+
+struct ForwardListNodeBase {
+    ForwardListNodeBase* next_;
+};
+
+template<typename T>
+struct ForwardListNode : ForwardListNodeBase {
+    T value_;
+};
+
+template<typename T, typename Allocator = std::allocator<T>>
+class forward_list {
+    class Iterator;                 // iterator
+    class ConstIterator;            // const iterator
+
+    //重新绑定分配器，可以分配ForwardListNode<T>大小内存
+    using BasePtr = ForwardListNodeBase*;
+    using NodePtr = ForwardListNode<T>*;
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using NodeAllocator = typename AllocTraits::template rebind_alloc<ForwardListNode<T>>;
+
+public:
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using pointer                = typename std::allocator_traits<Allocator>::pointer;
+    using const_pointer          = typename std::allocator_traits<Allocator>::const_pointer;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using iterator               = Iterator;
+    using const_iterator         = ConstIterator;
+
+    forward_list() noexcept : forward_list(Allocator()) {}
+
+    explicit forward_list(const Allocator& alloc) noexcept : alloc_(alloc) {
+        head_.next_ = nullptr;
+    }
+
+    explicit forward_list(size_type n, const Allocator& alloc = Allocator()) : forward_list(alloc) {
+        BasePtr tail = &head_;
+        for (size_type i = 0; i != n; ++i) {
+            tail = link_after(tail, create_node());
+        }
+    }
+
+    forward_list(size_type n, const T& value, const Allocator& alloc = Allocator()) : forward_list(alloc) {
+        insert_after(before_begin(), n, value);
+    }
+
+    template<typename InputIter, typename = std::void_t<
+        decltype(*std::declval<InputIter>()),
+        decltype(++std::declval<InputIter&>())
+    >>
+    forward_list(InputIter first, InputIter last, const Allocator& alloc = Allocator()) : forward_list(alloc) {
+        insert_after(before_begin(), first, last);
+    }
+
+    forward_list(std::initializer_list<T> il, const Allocator& alloc = Allocator()) : forward_list(il.begin(), il.end(), alloc) {}
+
+    //拷贝构造，分配器由select_on_container_copy_construction决定
+    forward_list(const forward_list& x) :
+    forward_list(x.begin(), x.end(), AllocTraits::select_on_container_copy_construction(x.alloc_)) {}
+
+    forward_list(const forward_list& x, const Allocator& alloc) : forward_list(x.begin(), x.end(), alloc) {}
+
+    forward_list(forward_list&& x) noexcept : alloc_(std::move(x.alloc_)) {
+        steal(x);
+    }
+
+    //分配器不相等时不能接管x的节点，逐个移动元素
+    forward_list(forward_list&& x, const Allocator& alloc) : forward_list(alloc) {
+        if (alloc_ == x.alloc_) {
+            steal(x);
+            return;
+        }
+        insert_after(before_begin(), std::make_move_iterator(x.begin()), std::make_move_iterator(x.end()));
+    }
+
+    ~forward_list() {
+        clear();
+    }
+
+    forward_list& operator=(const forward_list& other) {
+        if (&other == this) {
+            return *this;
+        }
+        clear();
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+            alloc_ = other.alloc_;
+        }
+        insert_after(before_begin(), other.begin(), other.end());
+        return *this;
+    }
+
+    //分配器传播或相等时直接接管other的节点，否则只能在自己的分配器上逐个移动元素
+    forward_list& operator=(forward_list&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value ||
+                                                         AllocTraits::is_always_equal::value) {
+        if (&other == this) {
+            return *this;
+        }
+        clear();
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+            return *this;
+        } else if (alloc_ == other.alloc_) {
+            steal(other);
+            return *this;
+        }
+        insert_after(before_begin(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        other.clear();
+        return *this;
+    }
+
+    forward_list& operator=(std::initializer_list<T> ilist) {
+        assign(ilist);
+        return *this;
+    }
+
+    void assign(size_type n, const T& t) {
+        clear();
+        insert_after(before_begin(), n, t);
+    }
+
+    template<typename InputIter, typename = std::void_t<
+        decltype(*std::declval<InputIter>()),
+        decltype(++std::declval<InputIter&>())
+    >>
+    void assign(InputIter first, InputIter last) {
+        clear();
+        insert_after(before_begin(), first, last);
+    }
+
+    void assign(std::initializer_list<T> l) {
+        assign(l.begin(), l.end());
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return alloc_;
+    }
+
+    iterator before_begin() noexcept {
+        return Iterator(&head_);
+    }
+
+    const_iterator before_begin() const noexcept {
+        return ConstIterator(const_cast<BasePtr>(&head_));
+    }
+
+    const_iterator cbefore_begin() const noexcept {
+        return before_begin();
+    }
+
+    iterator begin() noexcept {
+        return Iterator(head_.next_);
+    }
+
+    const_iterator begin() const noexcept {
+        return ConstIterator(head_.next_);
+    }
+
+    iterator end() noexcept {
+        return Iterator(nullptr);
+    }
+
+    const_iterator end() const noexcept {
+        return ConstIterator(nullptr);
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    bool empty() const noexcept {
+        return nullptr == head_.next_;
+    }
+
+    reference front() {
+        return static_cast<NodePtr>(head_.next_)->value_;
+    }
+
+    const_reference front() const {
+        return static_cast<NodePtr>(head_.next_)->value_;
+    }
+
+    template<typename... Args>
+    reference emplace_front(Args&&... args) {
+        return static_cast<NodePtr>(link_after(&head_, create_node(std::forward<Args>(args)...)))->value_;
+    }
+
+    void push_front(const T& x) {
+        emplace_front(x);
+    }
+
+    void push_front(T&& x) {
+        emplace_front(std::move(x));
+    }
+
+    void pop_front() {
+        erase_after(before_begin());
+    }
+
+    template<typename... Args>
+    iterator emplace_after(const_iterator position, Args&&... args) {
+        return Iterator(link_after(position.cur_, create_node(std::forward<Args>(args)...)));
+    }
+
+    iterator insert_after(const_iterator position, const T& x) {
+        return emplace_after(position, x);
+    }
+
+    iterator insert_after(const_iterator position, T&& x) {
+        return emplace_after(position, std::move(x));
+    }
+
+    // 返回最后一个插入的元素，n为0时返回position
+    iterator insert_after(const_iterator position, size_type n, const T& x) {
+        BasePtr cur = position.cur_;
+        for (size_type i = 0; i != n; ++i) {
+            cur = link_after(cur, create_node(x));
+        }
+        return Iterator(cur);
+    }
+
+    template<typename InputIter, typename = std::void_t<
+        decltype(*std::declval<InputIter>()),
+        decltype(++std::declval<InputIter&>())
+    >>
+    iterator insert_after(const_iterator position, InputIter first, InputIter last) {
+        BasePtr cur = position.cur_;
+        for (InputIter it = first; it != last; ++it) {
+            cur = link_after(cur, create_node(*it));
+        }
+        return Iterator(cur);
+    }
+
+    iterator insert_after(const_iterator position, std::initializer_list<T> il) {
+        return insert_after(position, il.begin(), il.end());
+    }
+
+    iterator erase_after(const_iterator position) {
+        BasePtr pre = position.cur_;
+        BasePtr delete_node = pre->next_;
+        pre->next_ = delete_node->next_;
+        destroy_node(static_cast<NodePtr>(delete_node));
+        return Iterator(pre->next_);
+    }
+
+    // 删除(position, last)之间的元素
+    iterator erase_after(const_iterator position, const_iterator last) {
+        BasePtr pre = position.cur_;
+        BasePtr delete_node = pre->next_;
+        while (delete_node != last.cur_) {
+            BasePtr next_node = delete_node->next_;
+            destroy_node(static_cast<NodePtr>(delete_node));
+            delete_node = next_node;
+        }
+        pre->next_ = last.cur_;
+        return Iterator(last.cur_);
+    }
+
+    void resize(size_type sz) {
+        BasePtr cur = &head_;
+        for (size_type i = 0; i != sz; ++i) {
+            if (nullptr == cur->next_) {
+                link_after(cur, create_node());
+            }
+            cur = cur->next_;
+        }
+        erase_after(ConstIterator(cur), end());
+    }
+
+    void resize(size_type sz, const T& c) {
+        BasePtr cur = &head_;
+        for (size_type i = 0; i != sz; ++i) {
+            if (nullptr == cur->next_) {
+                link_after(cur, create_node(c));
+            }
+            cur = cur->next_;
+        }
+        erase_after(ConstIterator(cur), end());
+    }
+
+    //propagate_on_container_swap为false时两个分配器必须相等
+    void swap(forward_list& l) noexcept(AllocTraits::is_always_equal::value) {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            std::swap(alloc_, l.alloc_);
+        }
+        BasePtr tmp = l.head_.next_;
+        l.head_.next_ = head_.next_;
+        head_.next_ = tmp;
+    }
+
+    void clear() noexcept {
+        erase_after(before_begin(), end());
+    }
+
+    // 把x的全部元素移动到position之后
+    void splice_after(const_iterator position, forward_list& x) {
+        if (x.empty()) {
+            return;
+        }
+        BasePtr last = &x.head_;
+        while (nullptr != last->next_) {
+            last = last->next_;
+        }
+        transfer_after(position.cur_, &x.head_, last);
+    }
+
+    void splice_after(const_iterator position, forward_list&& x) {
+        splice_after(position, x);
+    }
+
+    // 把i之后的那个元素移动到position之后
+    void splice_after(const_iterator position, forward_list&, const_iterator i) {
+        BasePtr before = i.cur_;
+        BasePtr node = before->next_;
+        if (position.cur_ == before || position.cur_ == node) {
+            return;
+        }
+        transfer_after(position.cur_, before, node);
+    }
+
+    void splice_after(const_iterator position, forward_list&& x, const_iterator i) {
+        splice_after(position, x, i);
+    }
+
+    // 把(first, last)之间的元素移动到position之后
+    void splice_after(const_iterator position, forward_list&, const_iterator first, const_iterator last) {
+        BasePtr before = first.cur_;
+        BasePtr tail = before;
+        while (tail->next_ != last.cur_) {
+            tail = tail->next_;
+        }
+        if (before == tail) {
+            return;
+        }
+        transfer_after(position.cur_, before, tail);
+    }
+
+    void splice_after(const_iterator position, forward_list&& x, const_iterator first, const_iterator last) {
+        splice_after(position, x, first, last);
+    }
+
+    size_type remove(const T& value) {
+        return remove_if([&value](const T& x) { return x == value; });
+    }
+
+    template <typename Predicate, typename = std::enable_if_t<
+        std::is_invocable_r_v<bool, Predicate, const T&>
+    >>
+    size_type remove_if(Predicate pred) {
+        size_type removed = 0;
+        BasePtr pre = &head_;
+        while (nullptr != pre->next_) {
+            if (pred(static_cast<NodePtr>(pre->next_)->value_)) {
+                erase_after(ConstIterator(pre));
+                ++removed;
+            } else {
+                pre = pre->next_;
+            }
+        }
+        return removed;
+    }
+
+    size_type unique() {
+        return unique([](const T& a, const T& b) { return a == b; });
+    }
+
+    template<typename BinaryPredicate, typename = std::enable_if_t<
+        std::is_invocable_r_v<bool, BinaryPredicate, const T&, const T&>
+    >>
+    size_type unique(BinaryPredicate pred) {
+        size_type removed = 0;
+        BasePtr cur = head_.next_;
+        if (nullptr == cur) {
+            return removed;
+        }
+        while (nullptr != cur->next_) {
+            if (pred(static_cast<NodePtr>(cur)->value_, static_cast<NodePtr>(cur->next_)->value_)) {
+                erase_after(ConstIterator(cur));
+                ++removed;
+            } else {
+                cur = cur->next_;
+            }
+        }
+        return removed;
+    }
+
+    // 使用归并前应当保证两个链表都有序，否则是ub
+    void merge(forward_list& x) {
+        merge(x, std::less<>());
+    }
+
+    void merge(forward_list&& x) {
+        merge(x, std::less<>());
+    }
+
+    template<typename Compare, typename = std::enable_if_t<
+        std::is_invocable_r_v<bool, Compare, const T&, const T&>
+    >>
+    void merge(forward_list& x, Compare comp) {
+        if (&x == this) {
+            return;
+        }
+        head_.next_ = merge_nodes(head_.next_, x.head_.next_, comp);
+        x.head_.next_ = nullptr;
+    }
+
+    template<typename Compare, typename = std::enable_if_t<
+        std::is_invocable_r_v<bool, Compare, const T&, const T&>
+    >>
+    void merge(forward_list&& x, Compare comp) {
+        merge(x, comp);
+    }
+
+    void sort() {
+        sort(std::less<>());
+    }
+
+    // 自底向上的稳定归并排序，只改动next_指针，不移动元素
+    template<typename Compare, typename = std::enable_if_t<
+        std::is_invocable_r_v<bool, Compare, const T&, const T&>
+    >>
+    void sort(Compare comp) {
+        BasePtr bins[64] = {};
+        int fill = 0;
+        BasePtr cur = head_.next_;
+        while (nullptr != cur) {
+            BasePtr carry = cur;
+            cur = cur->next_;
+            carry->next_ = nullptr;
+            int i = 0;
+            for (; i < fill && nullptr != bins[i]; ++i) {
+                carry = merge_nodes(bins[i], carry, comp);
+                bins[i] = nullptr;
+            }
+            bins[i] = carry;
+            if (i == fill) {
+                ++fill;
+            }
+        }
+        BasePtr result = nullptr;
+        for (int i = 0; i < fill; ++i) {
+            if (nullptr != bins[i]) {
+                result = nullptr == result ? bins[i] : merge_nodes(bins[i], result, comp);
+            }
+        }
+        head_.next_ = result;
+    }
+
+    void reverse() noexcept {
+        BasePtr pre = nullptr;
+        BasePtr cur = head_.next_;
+        while (nullptr != cur) {
+            BasePtr next_node = cur->next_;
+            cur->next_ = pre;
+            pre = cur;
+            cur = next_node;
+        }
+        head_.next_ = pre;
+    }
+
+private:
+    template<typename... Args>
+    NodePtr create_node(Args&&... args) {
+        NodeAllocator node_alloc{alloc_};
+        NodePtr node = node_alloc.allocate(1);
+        try {
+            AllocTraits::construct(alloc_, &node->value_, std::forward<Args>(args)...);
+        } catch (...) {
+            node_alloc.deallocate(node, 1);
+            throw;
+        }
+        node->next_ = nullptr;
+        return node;
+    }
+
+    void destroy_node(NodePtr node) noexcept {
+        NodeAllocator node_alloc{alloc_};
+        AllocTraits::destroy(alloc_, &node->value_);
+        node_alloc.deallocate(node, 1);
+    }
+
+    //接管x的全部节点，x变为空
+    void steal(forward_list& x) noexcept {
+        head_.next_ = x.head_.next_;
+        x.head_.next_ = nullptr;
+    }
+
+    static BasePtr link_after(BasePtr position, BasePtr node) noexcept {
+        node->next_ = position->next_;
+        position->next_ = node;
+        return node;
+    }
+
+    //把(before, last]移动到position之后
+    static void transfer_after(BasePtr position, BasePtr before, BasePtr last) noexcept {
+        BasePtr first = before->next_;
+        before->next_ = last->next_;
+        last->next_ = position->next_;
+        position->next_ = first;
+    }
+
+    //合并两条以nullptr结尾的有序链，相等时a中的元素在前
+    template<typename Compare>
+    static BasePtr merge_nodes(BasePtr a, BasePtr b, Compare& comp) {
+        ForwardListNodeBase head;
+        BasePtr tail = &head;
+        while (nullptr != a && nullptr != b) {
+            if (comp(static_cast<NodePtr>(b)->value_, static_cast<NodePtr>(a)->value_)) {
+                tail->next_ = b;
+                b = b->next_;
+            } else {
+                tail->next_ = a;
+                a = a->next_;
+            }
+            tail = tail->next_;
+        }
+        tail->next_ = nullptr != a ? a : b;
+        return head.next_;
+    }
+
+private:
+    ForwardListNodeBase head_;
+    YCSTL_NO_UNIQUE_ADDRESS Allocator alloc_;
+
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag; // 单向迭代器
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Iterator() : cur_(nullptr) {}
+
+        explicit Iterator(BasePtr cur) : cur_(cur) {}
+
+        reference operator*() const {
+            return static_cast<NodePtr>(cur_)->value_;
+        }
+
+        pointer operator->() const {
+            return &(static_cast<NodePtr>(cur_)->value_);
+        }
+
+        Iterator& operator++() {
+            cur_ = cur_->next_;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator it(cur_);
+            cur_ = cur_->next_;
+            return it;
+        }
+
+        bool operator==(const Iterator& it) const {
+            return cur_ == it.cur_;
+        }
+
+        bool operator!=(const Iterator& it) const {
+            return cur_ != it.cur_;
+        }
+
+    private:
+        BasePtr cur_;
+        friend class forward_list;
+    };
+
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator() : cur_(nullptr) {}
+
+        explicit ConstIterator(BasePtr cur) : cur_(cur) {}
+
+        ConstIterator(const Iterator& it) : cur_(it.cur_) {} // 允许从 Iterator 转换成 ConstIterator
+
+        reference operator*() const {
+            return static_cast<NodePtr>(cur_)->value_;
+        }
+
+        pointer operator->() const {
+            return &(static_cast<NodePtr>(cur_)->value_);
+        }
+
+        ConstIterator& operator++() {
+            cur_ = cur_->next_;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator temp(*this);
+            cur_ = cur_->next_;
+            return temp;
+        }
+
+        bool operator==(const ConstIterator& it) const {
+            return cur_ == it.cur_;
+        }
+
+        bool operator!=(const ConstIterator& it) const {
+            return cur_ != it.cur_;
+        }
+
+    private:
+        BasePtr cur_;
+        friend class forward_list;
+    };
+};
+
+namespace pmr {
+template<typename T>
+using forward_list = ycstl::forward_list<T, polymorphic_allocator<T>>;
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const ycstl::forward_list<T>& l) {
+    os << "{";
+    for (auto it = l.begin(); it != l.end(); ++it) {
+        os << *it;
+        os << "-> ";
+    }
+    os << "end}";
+    return os;
+}
+
+}   //ycstl
+
+#endif
@@ -0,0 +1,534 @@
+/**
+ * 实现intrusive_list
+ * ListHook
+ * AutoUnlinkListHook
+ * intrusive_list
+ *
+ * 对象通过内嵌的钩子串联，链表本身不分配任何内存，也不拥有元素
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef INTRUSIVE_LIST_HPP_
+#define INTRUSIVE_LIST_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <iostream>
+
+namespace ycstl {
+
+//钩子与ListNode保持相同的pre_/next_布局，链表内部是以哨兵为根的环
+struct ListHook {
+    ListHook* pre_ = nullptr;
+    ListHook* next_ = nullptr;
+
+    ListHook() noexcept = default;
+
+    //拷贝对象时不拷贝链接关系
+    ListHook(const ListHook&) noexcept {}
+
+    ListHook& operator=(const ListHook&) noexcept {
+        return *this;
+    }
+
+    bool is_linked() const noexcept {
+        return nullptr != next_;
+    }
+
+    //从所在链表中摘除，O(1)
+    void unlink() noexcept {
+        if (!is_linked()) {
+            return;
+        }
+        pre_->next_ = next_;
+        next_->pre_ = pre_;
+        pre_ = next_ = nullptr;
+    }
+};
+
+//析构时自动从链表摘除，使用该钩子的链表size()为O(n)
+struct AutoUnlinkListHook : ListHook {
+    AutoUnlinkListHook() noexcept = default;
+
+    AutoUnlinkListHook(const AutoUnlinkListHook&) noexcept : ListHook() {}
+
+    AutoUnlinkListHook& operator=(const AutoUnlinkListHook&) noexcept {
+        return *this;
+    }
+
+    ~AutoUnlinkListHook() {
+        unlink();
+    }
+};
+
+template<typename T, auto HookPtr>
+class intrusive_list {
+    class Iterator;                 // iterator
+    class ConstIterator;            // const iterator
+
+    using HookType = std::remove_reference_t<decltype(std::declval<T&>().*HookPtr)>;
+    using HookPtrType = ListHook*;
+
+    static_assert(std::is_member_object_pointer_v<decltype(HookPtr)>, "HookPtr must be a pointer to data member");
+    static_assert(std::is_base_of_v<ListHook, HookType>, "hook must be ListHook or AutoUnlinkListHook");
+
+    //自动摘除的元素可能在链表不知情时离开，无法维护size_
+    static constexpr bool constant_time_size = !std::is_base_of_v<AutoUnlinkListHook, HookType>;
+
+public:
+    using value_type             = T;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using iterator               = Iterator;
+    using const_iterator         = ConstIterator;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    intrusive_list() noexcept : size_(0) {
+        root_.pre_ = root_.next_ = &root_;
+    }
+
+    template<typename InputIter, typename = std::void_t<
+        decltype(*std::declval<InputIter>()),
+        decltype(++std::declval<InputIter&>())
+    >>
+    intrusive_list(InputIter first, InputIter last) noexcept : intrusive_list() {
+        for (InputIter it = first; it != last; ++it) {
+            push_back(*it);
+        }
+    }
+
+    intrusive_list(intrusive_list&& x) noexcept : intrusive_list() {
+        take_over(x);
+    }
+
+    //不拥有元素，析构只解除链接
+    ~intrusive_list() {
+        clear();
+    }
+
+    intrusive_list& operator=(intrusive_list&& x) noexcept {
+        if (&x == this) {
+            return *this;
+        }
+        clear();
+        take_over(x);
+        return *this;
+    }
+
+    intrusive_list(const intrusive_list&) = delete;
+    intrusive_list& operator=(const intrusive_list&) = delete;
+
+    iterator begin() noexcept {
+        return Iterator(root_.next_);
+    }
+
+    const_iterator begin() const noexcept {
+        return ConstIterator(root_.next_);
+    }
+
+    iterator end() noexcept {
+        return Iterator(&root_);
+    }
+
+    const_iterator end() const noexcept {
+        return ConstIterator(const_cast<HookPtrType>(&root_));
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    bool empty() const noexcept {
+        return root_.next_ == &root_;
+    }
+
+    size_type size() const noexcept {
+        if constexpr (constant_time_size) {
+            return size_;
+        } else {
+            size_type n = 0;
+            for (HookPtrType hook = root_.next_; hook != &root_; hook = hook->next_) {
+                ++n;
+            }
+            return n;
+        }
+    }
+
+    reference front() {
+        return *to_value(root_.next_);
+    }
+
+    const_reference front() const {
+        return *to_value(root_.next_);
+    }
+
+    reference back() {
+        return *to_value(root_.pre_);
+    }
+
+    const_reference back() const {
+        return *to_value(root_.pre_);
+    }
+
+    void push_front(reference x) noexcept {
+        link_before(root_.next_, to_hook(x));
+    }
+
+    void push_back(reference x) noexcept {
+        link_before(&root_, to_hook(x));
+    }
+
+    void pop_front() noexcept {
+        unlink_hook(root_.next_);
+    }
+
+    void pop_back() noexcept {
+        unlink_hook(root_.pre_);
+    }
+
+    // 插入到指定迭代器之前的位置，元素必须尚未链接到任何链表
+    iterator insert(const_iterator position, reference x) noexcept {
+        HookPtrType hook = to_hook(x);
+        link_before(position.cur_, hook);
+        return Iterator(hook);
+    }
+
+    iterator erase(const_iterator position) noexcept {
+        HookPtrType next = position.cur_->next_;
+        unlink_hook(position.cur_);
+        return Iterator(next);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept {
+        HookPtrType cur = first.cur_;
+        while (cur != last.cur_) {
+            HookPtrType next = cur->next_;
+            unlink_hook(cur);
+            cur = next;
+        }
+        return Iterator(last.cur_);
+    }
+
+    //通过元素引用直接摘除，元素必须在本链表中
+    void unlink(reference x) noexcept {
+        unlink_hook(to_hook(x));
+    }
+
+    iterator iterator_to(reference x) noexcept {
+        return Iterator(to_hook(x));
+    }
+
+    const_iterator iterator_to(const_reference x) const noexcept {
+        return ConstIterator(to_hook(const_cast<reference>(x)));
+    }
+
+    void swap(intrusive_list& l) noexcept {
+        intrusive_list tmp(std::move(l));
+        l.take_over(*this);
+        take_over(tmp);
+    }
+
+    void clear() noexcept {
+        HookPtrType cur = root_.next_;
+        while (cur != &root_) {
+            HookPtrType next = cur->next_;
+            cur->pre_ = cur->next_ = nullptr;
+            cur = next;
+        }
+        root_.pre_ = root_.next_ = &root_;
+        size_ = 0;
+    }
+
+    void splice(const_iterator position, intrusive_list& x) noexcept {
+        if (x.empty()) {
+            return;
+        }
+        size_type n = x.size_;
+        transfer(position.cur_, x.root_.next_, &x.root_);
+        size_ += n;
+        x.size_ = 0;
+    }
+
+    void splice(const_iterator position, intrusive_list&& x) noexcept {
+        splice(position, x);
+    }
+
+    void splice(const_iterator position, intrusive_list& x, const_iterator i) noexcept {
+        HookPtrType node = i.cur_;
+        if (node == position.cur_ || node->next_ == position.cur_) {
+            return;
+        }
+        transfer(position.cur_, node, node->next_);
+        ++size_;
+        --x.size_;
+    }
+
+    void splice(const_iterator position, intrusive_list&& x, const_iterator i) noexcept {
+        splice(position, x, i);
+    }
+
+    void splice(const_iterator position, intrusive_list& x, const_iterator first, const_iterator last) noexcept {
+        if (first == last) {
+            return;
+        }
+        if constexpr (constant_time_size) {
+            if (&x != this) {
+                size_type n = 0;
+                for (HookPtrType cur = first.cur_; cur != last.cur_; cur = cur->next_) {
+                    ++n;
+                }
+                size_ += n;
+                x.size_ -= n;
+            }
+        }
+        transfer(position.cur_, first.cur_, last.cur_);
+    }
+
+    void splice(const_iterator position, intrusive_list&& x, const_iterator first, const_iterator last) noexcept {
+        splice(position, x, first, last);
+    }
+
+    template <typename Predicate, typename = std::enable_if_t<
+        std::is_invocable_r_v<bool, Predicate, const T&>
+    >>
+    size_type remove_if(Predicate pred) noexcept {
+        size_type removed = 0;
+        HookPtrType cur = root_.next_;
+        while (cur != &root_) {
+            HookPtrType next = cur->next_;
+            if (pred(*to_value(cur))) {
+                unlink_hook(cur);
+                ++removed;
+            }
+            cur = next;
+        }
+        return removed;
+    }
+
+    size_type remove(const T& value) noexcept {
+        return remove_if([&value](const T& x) { return x == value; });
+    }
+
+private:
+    //成员指针相对对象起始地址的偏移
+    static std::ptrdiff_t hook_offset() noexcept {
+        alignas(T) unsigned char probe[sizeof(T)];
+        const T* obj = reinterpret_cast<const T*>(probe);
+        return reinterpret_cast<const unsigned char*>(static_cast<const ListHook*>(&(obj->*HookPtr))) - probe;
+    }
+
+    static HookPtrType to_hook(reference x) noexcept {
+        return static_cast<HookPtrType>(&(x.*HookPtr));
+    }
+
+    static pointer to_value(HookPtrType hook) noexcept {
+        return reinterpret_cast<pointer>(reinterpret_cast<unsigned char*>(hook) - hook_offset());
+    }
+
+    void link_before(HookPtrType position, HookPtrType hook) noexcept {
+        hook->next_ = position;
+        hook->pre_ = position->pre_;
+        position->pre_->next_ = hook;
+        position->pre_ = hook;
+        ++size_;
+    }
+
+    void unlink_hook(HookPtrType hook) noexcept {
+        hook->unlink();
+        --size_;
+    }
+
+    //把[first, last)整体移动到position之前
+    static void transfer(HookPtrType position, HookPtrType first, HookPtrType last) noexcept {
+        if (position == last) {
+            return;
+        }
+        HookPtrType tail = last->pre_;
+        first->pre_->next_ = last;
+        last->pre_ = first->pre_;
+
+        first->pre_ = position->pre_;
+        tail->next_ = position;
+        position->pre_->next_ = first;
+        position->pre_ = tail;
+    }
+
+    void take_over(intrusive_list& x) noexcept {
+        if (x.empty()) {
+            return;
+        }
+        root_.next_ = x.root_.next_;
+        root_.pre_ = x.root_.pre_;
+        root_.next_->pre_ = &root_;
+        root_.pre_->next_ = &root_;
+        size_ = x.size_;
+        x.root_.pre_ = x.root_.next_ = &x.root_;
+        x.size_ = 0;
+    }
+
+private:
+    ListHook root_;
+    size_type size_;
+
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Iterator() : cur_(nullptr) {}
+
+        explicit Iterator(HookPtrType cur) : cur_(cur) {}
+
+        reference operator*() const {
+            return *to_value(cur_);
+        }
+
+        pointer operator->() const {
+            return to_value(cur_);
+        }
+
+        Iterator& operator++() {
+            cur_ = cur_->next_;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator it(cur_);
+            cur_ = cur_->next_;
+            return it;
+        }
+
+        Iterator& operator--() {
+            cur_ = cur_->pre_;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator it(cur_);
+            cur_ = cur_->pre_;
+            return it;
+        }
+
+        bool operator==(const Iterator& it) const {
+            return cur_ == it.cur_;
+        }
+
+        bool operator!=(const Iterator& it) const {
+            return cur_ != it.cur_;
+        }
+
+    private:
+        HookPtrType cur_;
+        friend class intrusive_list;
+    };
+
+    class ConstIterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator() : cur_(nullptr) {}
+
+        explicit ConstIterator(HookPtrType cur) : cur_(cur) {}
+
+        ConstIterator(const Iterator& it) : cur_(it.cur_) {} // 允许从 Iterator 转换成 ConstIterator
+
+        reference operator*() const {
+            return *to_value(cur_);
+        }
+
+        pointer operator->() const {
+            return to_value(cur_);
+        }
+
+        ConstIterator& operator++() {
+            cur_ = cur_->next_;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator temp(*this);
+            cur_ = cur_->next_;
+            return temp;
+        }
+
+        ConstIterator& operator--() {
+            cur_ = cur_->pre_;
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator temp(*this);
+            cur_ = cur_->pre_;
+            return temp;
+        }
+
+        bool operator==(const ConstIterator& it) const {
+            return cur_ == it.cur_;
+        }
+
+        bool operator!=(const ConstIterator& it) const {
+            return cur_ != it.cur_;
+        }
+
+    private:
+        HookPtrType cur_;
+        friend class intrusive_list;
+    };
+};
+
+template<typename T, auto HookPtr>
+std::ostream& operator<<(std::ostream& os, const ycstl::intrusive_list<T, HookPtr>& l) {
+    os << "{";
+    for (auto it = l.begin(); it != l.end(); ++it) {
+        os << *it;
+        os << "-> ";
+    }
+    os << "end}";
+    return os;
+}
+
+}   //ycstl
+
+#endif
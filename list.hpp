@@ -8,6 +8,9 @@
  #ifndef LIST_HPP_
  #define LIST_HPP_
  
+ #include "memory.hpp"
+ #include "memory_resource.hpp"
+ 
  #include <memory>
  #include <stdexcept>
  #include <iterator>
@@ -31,6 +34,7 @@
      //重新绑定分配器，可以分配ListNode<T>大小内存
      using NodePtr = ListNode<T>*;
      using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<ListNode<T>>;
+     using AllocTraits = std::allocator_traits<Allocator>;
  
  public:
      using value_type             = T;
@@ -86,7 +90,10 @@
          size_ = cur_size;
      }
  
-     list(const list& x) noexcept : list(x.begin(), x.end(), x.alloc_) {}
+     //拷贝构造，分配器由select_on_container_copy_construction决定
+     list(const list& x) noexcept : list(x.begin(), x.end(), AllocTraits::select_on_container_copy_construction(x.alloc_)) {}
+ 
+     list(const list& x, const Allocator& alloc) : list(x.begin(), x.end(), alloc) {}
  
      list(list&& x) noexcept : begin_(std::move(x.begin_)), end_(std::move(x.end_)), 
              size_(x.size_), alloc_(std::move(x.alloc_)) {
@@ -94,6 +101,19 @@
          x.size_ = 0;
      }
  
+     //分配器不相等时不能接管x的节点，逐个移动元素
+     list(list&& x, const Allocator& alloc) : size_(0), alloc_(alloc) {
+         if (alloc_ == x.alloc_) {
+             steal(x);
+             return;
+         }
+         NodePtr end_node = proxy_construct(alloc_);
+         begin_.cur_ = end_.cur_ = end_node;
+         for (Iterator it = x.begin_; it != x.end_; ++it) {
+             emplace_back(std::move(*it));
+         }
+     }
+ 
      list(std::initializer_list<T> il, const Allocator& alloc = Allocator()) noexcept : list(il.begin(), il.end(), alloc) {}
  
      ~list() {
@@ -101,7 +121,13 @@
      }
  
      list& operator=(const list& other) {
+         if (this == &other) {
+             return *this;
+         }
          clean();
+         if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+             alloc_ = other.alloc_;
+         }
          NodePtr end_node = proxy_construct(alloc_);
          begin_ = end_ = Iterator(end_node);
          std::size_t cur_size = 0;
@@ -123,15 +149,28 @@
          return *this;
      }
  
-     list& operator=(list&& other) noexcept {
+     //分配器传播或相等时直接接管other的节点，否则只能在自己的分配器上逐个移动元素
+     list& operator=(list&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value ||
+                                          AllocTraits::is_always_equal::value) {
+         if (this == &other) {
+             return *this;
+         }
          clean();
+         if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+             alloc_ = std::move(other.alloc_);
+             steal(other);
+             return *this;
+         } else if (alloc_ == other.alloc_) {
+             steal(other);
+             return *this;
+         }
          NodePtr end_node = proxy_construct(alloc_);
          begin_ = end_ = Iterator(end_node);
          std::size_t cur_size = 0;
          for (Iterator it = other.begin_; it != other.end_; ++it) {
              ++cur_size;
              NodePtr cur_node = proxy_construct(alloc_);
-             cur_node->value_ = *it;
+             cur_node->value_ = std::move(*it);
              cur_node->next_ = end_.GetNodePtr();
              if (begin_ == end_) {
                  begin_ = Iterator(cur_node);
@@ -262,7 +301,7 @@
      reference emplace_front(Args&&... args) {
          NodeAllocator node_alloc{alloc_};
          NodePtr node = node_alloc.allocate(1);
-         std::construct_at(&node->value_, std::forward<Args>(args)...);
+         AllocTraits::construct(alloc_, &node->value_, std::forward<Args>(args)...);
          node->next_ = begin_.cur_;
          node->pre_ = begin_.cur_->pre_;
          begin_.cur_->pre_ = node;
@@ -275,7 +314,7 @@
      reference emplace_back(Args&&... args) {
          NodeAllocator node_alloc{alloc_};
          NodePtr node = node_alloc.allocate(1);
-         std::construct_at(&node->value_, std::forward<Args>(args)...);
+         AllocTraits::construct(alloc_, &node->value_, std::forward<Args>(args)...);
          node->next_ = end_.cur_;
          node->pre_ = end_.cur_->pre_;
          if (node->pre_ != nullptr) {
@@ -318,7 +357,7 @@
          // 插入到指定迭代器之前的位置
          NodeAllocator node_alloc{alloc_};
          NodePtr node = node_alloc.allocate(1);
-         std::construct_at(&node->value_, std::forward<Args>(args)...);
+         AllocTraits::construct(alloc_, &node->value_, std::forward<Args>(args)...);
          node->next_ = position.cur_;
          node->pre_ = position.cur_->pre_;
          if (node->pre_ != nullptr) {
@@ -388,7 +427,7 @@
          if (delete_node == begin_.cur_) {
              begin_.cur_ = delete_node->next_;
          }
-         std::destroy_at(delete_node);
+         AllocTraits::destroy(alloc_, &delete_node->value_);
          node_alloc.deallocate(delete_node,1);
          --size_;
          return follow_iterator;
@@ -402,7 +441,15 @@
          return Iterator(last.cur_);
      }
  
+     allocator_type get_allocator() const noexcept {
+         return alloc_;
+     }
+ 
+     //propagate_on_container_swap为false时两个分配器必须相等
      void swap(list& l) noexcept(std::allocator_traits<Allocator>::is_always_equal::value) {
+         if constexpr (AllocTraits::propagate_on_container_swap::value) {
+             std::swap(alloc_, l.alloc_);
+         }
          auto tmp_begin = l.begin_.cur_;
          auto tmp_end = l.end_.cur_;
          auto tmp_size = l.size_;
@@ -588,12 +635,137 @@
  
      // }
  
-     
+     // 按遍历顺序重新分配所有节点，使分配顺序与遍历顺序一致
+     // 不保证节点连续：新节点逐个向分配器申请，能否相邻取决于分配器；
+     // 用monotonic_buffer_resource之类按顺序切分的资源(pmr::list)时新节点首尾相接，
+     // 默认分配器下通常来自堆顶的连续区域，但也可能落进堆上其他空闲块
+     // 先分配全部新节点再转移任何值，分配失败时原链表不变；
+     // T的移动构造不抛异常时转移这一步不会失败，否则改为拷贝(std::move_if_noexcept)，拷贝失败时原链表同样不变
+     // 所有旧迭代器失效，remap(旧位置, 新位置)在旧节点释放前逐个回调，可用来更新外部保存的迭代器
+     template<typename Remap, typename = std::enable_if_t<
+         std::is_invocable_v<Remap, const_iterator, iterator>
+     >>
+     void relinearize(Remap remap) {
+         if (0 == size_) {
+             return;
+         }
+         NodeAllocator node_alloc{alloc_};
+         NodePtr first = nullptr;
+         NodePtr tail = nullptr;
+         try {
+             for (size_type i = 0; i != size_; ++i) {
+                 NodePtr node = node_alloc.allocate(1);
+                 node->pre_ = tail;
+                 node->next_ = nullptr;
+                 if (nullptr != tail) {
+                     tail->next_ = node;
+                 } else {
+                     first = node;
+                 }
+                 tail = node;
+             }
+         } catch (...) {
+             deallocate_chain(first, nullptr);
+             throw;
+         }
+
+         NodePtr node = first;
+         NodePtr old_node = begin_.cur_;
+         try {
+             for (; nullptr != node; node = node->next_, old_node = old_node->next_) {
+                 AllocTraits::construct(alloc_, &node->value_, std::move_if_noexcept(old_node->value_));
+             }
+         } catch (...) {
+             free_chain(first, node);
+             deallocate_chain(node, nullptr);
+             throw;
+         }
+
+         old_node = begin_.cur_;
+         NodePtr sentinel = end_.cur_;
+         begin_.cur_ = first;
+         tail->next_ = sentinel;
+         sentinel->pre_ = tail;
+
+         //remap抛异常时剩下的旧节点照样释放
+         node = first;
+         try {
+             while (old_node != sentinel) {
+                 NodePtr next_old = old_node->next_;
+                 remap(ConstIterator(old_node), Iterator(node));
+                 free_chain(old_node, next_old);
+                 old_node = next_old;
+                 node = node->next_;
+             }
+         } catch (...) {
+             free_chain(old_node, sentinel);
+             throw;
+         }
+     }
+
+     void relinearize() {
+         relinearize([](const_iterator, iterator) {});
+     }
+
+     // 遍历时预取下一个节点，使下一次指针追逐的访存与当前元素的处理重叠
+     template<typename Function, typename = std::enable_if_t<
+         std::is_invocable_v<Function, T&>
+     >>
+     void prefetch_for_each(Function f) {
+         for (NodePtr node = begin_.cur_; node != end_.cur_; ) {
+             NodePtr next_node = node->next_;
+             prefetch_node(next_node);
+             f(node->value_);
+             node = next_node;
+         }
+     }
+ 
+     template<typename Function, typename = std::enable_if_t<
+         std::is_invocable_v<Function, const T&>
+     >>
+     void prefetch_for_each(Function f) const {
+         for (NodePtr node = begin_.cur_; node != end_.cur_; ) {
+             NodePtr next_node = node->next_;
+             prefetch_node(next_node);
+             f(static_cast<const T&>(node->value_));
+             node = next_node;
+         }
+     }
+ 
  private:
+     static void prefetch_node(NodePtr node) noexcept {
+ #if defined(__GNUC__) || defined(__clang__)
+         __builtin_prefetch(node, 0, 1);
+ #else
+         (void)node;
+ #endif
+     }
+ 
+     //只释放[first, last)上节点的内存，节点中的值没有构造过
+     void deallocate_chain(NodePtr first, NodePtr last) noexcept {
+         NodeAllocator node_alloc{alloc_};
+         while (first != last) {
+             NodePtr next_node = first->next_;
+             node_alloc.deallocate(first, 1);
+             first = next_node;
+         }
+     }
+
+     //析构并释放[first, last)上的节点
+     void free_chain(NodePtr first, NodePtr last) noexcept {
+         NodeAllocator node_alloc{alloc_};
+         while (first != last) {
+             NodePtr next_node = first->next_;
+             AllocTraits::destroy(alloc_, &first->value_);
+             node_alloc.deallocate(first, 1);
+             first = next_node;
+         }
+     }
+ 
      NodePtr proxy_construct(const Allocator& alloc) noexcept {
          NodeAllocator node_alloc{alloc};
          NodePtr node = node_alloc.allocate(1);
-         std::construct_at(&node->value_);
+         AllocTraits::construct(alloc_, &node->value_);
          node->next_ = nullptr;
          node->pre_ = nullptr;
          return node;
@@ -602,20 +774,20 @@
      void proxy_construct(size_type n, const Allocator& alloc)  noexcept {
          NodeAllocator node_alloc{alloc};
          NodePtr node = node_alloc.allocate(1);
-         std::construct_at(&node->value_);
+         AllocTraits::construct(alloc_, &node->value_);
          node->pre_ = nullptr;
          node->next_ = nullptr;
          begin_ = Iterator(node);
          for (size_t i = 1; i < n; ++i) {
              NodePtr new_node = node_alloc.allocate(1);
-             std::construct_at(&new_node->value_);
+             AllocTraits::construct(alloc_, &new_node->value_);
              new_node->pre_ = node;
              new_node->next_ = node->next_;
              node->next_ = new_node;
              node = new_node;
          }
          NodePtr end_node = node_alloc.allocate(1);
-         std::construct_at(&end_node->value_);
+         AllocTraits::construct(alloc_, &end_node->value_);
          end_node->pre_ = node;
          end_node->next_ = node->next_;
          node->next_ = end_node;
@@ -625,26 +797,35 @@
      void proxy_construct(size_type n, const T& value, const Allocator& alloc)  noexcept {
          NodeAllocator node_alloc{alloc};
          NodePtr node = node_alloc.allocate(1);
-         std::construct_at(&node->value_,value);
+         AllocTraits::construct(alloc_, &node->value_,value);
          node->pre_ = nullptr;
          node->next_ = nullptr;
          begin_ = Iterator(node);
          for (size_t i = 1; i < n; ++i) {
              NodePtr new_node = node_alloc.allocate(1);
-             std::construct_at(&new_node->value_, value);
+             AllocTraits::construct(alloc_, &new_node->value_, value);
              new_node->pre_ = node;
              new_node->next_ = node->next_;
              node->next_ = new_node;
              node = new_node;
          }
          NodePtr end_node = node_alloc.allocate(1);
-         std::construct_at(&end_node->value_);
+         AllocTraits::construct(alloc_, &end_node->value_);
          end_node->pre_ = node;
          end_node->next_ = node->next_;
          node->next_ = end_node;
          end_ = Iterator(end_node);
      }
  
+     //接管x的全部节点，x变为空
+     void steal(list& x) noexcept {
+         begin_.cur_ = x.begin_.cur_;
+         end_.cur_ = x.end_.cur_;
+         size_ = x.size_;
+         x.begin_.cur_ = x.end_.cur_ = nullptr;
+         x.size_ = 0;
+     }
+ 
      void clean() {
          if (begin_.cur_ == nullptr && end_.cur_ == nullptr) {
              return;
@@ -653,12 +834,12 @@
          NodePtr delete_node = begin_.cur_;
          while (delete_node != end_.cur_) {
              NodePtr next_node = delete_node->next_;
-             std::destroy_at(&delete_node->value_);
+             AllocTraits::destroy(alloc_, &delete_node->value_);
              node_alloc.deallocate(delete_node, 1);
              delete_node = next_node;
          }
          NodePtr end_node = end_.cur_;
-         std::destroy_at(end_node);
+         AllocTraits::destroy(alloc_, &end_node->value_);
          node_alloc.deallocate(end_node,1);
          begin_.cur_ = end_.cur_ = nullptr;
          size_ = 0;
@@ -677,7 +858,7 @@
              delete_node->pre_->next_ = delete_node->next_;
          }
          delete_node->next_->pre_ = delete_node->pre_;
-         std::destroy_at(delete_node);
+         AllocTraits::destroy(alloc_, &delete_node->value_);
          node_alloc.deallocate(delete_node,1);
          --size_;
      }   
@@ -690,7 +871,7 @@
          NodePtr delete_node = begin_.cur_;
          begin_.cur_ = delete_node->next_;
          begin_.cur_->pre_ = delete_node->pre_;
-         std::destroy_at(delete_node);
+         AllocTraits::destroy(alloc_, &delete_node->value_);
          node_alloc.deallocate(delete_node,1);
          --size_;
      }
@@ -715,7 +896,7 @@
      iterator begin_;
      iterator end_;
      size_type size_;
-     Allocator alloc_;
+     YCSTL_NO_UNIQUE_ADDRESS Allocator alloc_;
  
      class Iterator {
      public:
@@ -725,7 +906,7 @@
          using pointer = T*;
          using reference = T&;
          
-         Iterator(){}
+         Iterator() : cur_(nullptr) {}
  
          explicit Iterator(ListNode<T>* cur) {
              cur_ = cur;
@@ -757,11 +938,11 @@
              return *this;
          } 
  
-         reference operator*() {
+         reference operator*() const {
              return cur_->value_;
          }
  
-         pointer operator->() {
+         pointer operator->() const {
              return &(cur_->value_);
          }
  
@@ -791,11 +972,11 @@
              return cur_;
          }
  
-         bool operator==(const Iterator& it) {
+         bool operator==(const Iterator& it) const {
              return cur_ == it.cur_;
          }
  
-         bool operator!=(const Iterator& it) {
+         bool operator!=(const Iterator& it) const {
              return cur_ != it.cur_;
          }
  
@@ -866,6 +1047,13 @@
  
  };
  
+ static_assert(sizeof(list<int>) == 3 * sizeof(int*), "stateless allocator must not enlarge list");
+ 
+ namespace pmr {
+ template<typename T>
+ using list = ycstl::list<T, polymorphic_allocator<T>>;
+ }
+ 
  template <typename T>
  std::ostream& operator<<(std::ostream& os, const ycstl::list<T>& l) {
      os << "{";
@@ -0,0 +1,282 @@
+/**
+ * 实现lru_cache
+ * null_mutex
+ * lru_cache_stats
+ * lru_cache
+ *
+ * 基于ycstl::list的LRU缓存：命中时把节点splice到表头，O(1)更新新旧顺序；
+ * 淘汰的节点析构掉key/value后splice进空闲链表复用，稳定状态下put不再分配节点；
+ * 空闲链表每个分片最多保留kMaxFreeNodes个节点，多出来的直接释放；
+ * 按key的哈希分成N个分片，每个分片一把锁
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef LRU_CACHE_HPP_
+#define LRU_CACHE_HPP_
+
+#include "list.hpp"
+#include "memory.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace ycstl {
+
+//单线程使用时替代std::mutex，加解锁为空操作
+struct null_mutex {
+    void lock() noexcept {}
+    void unlock() noexcept {}
+    bool try_lock() noexcept { return true; }
+};
+
+//默认每个元素权重为1，此时capacity即元素个数
+struct unit_weight {
+    template<typename K, typename V>
+    std::size_t operator()(const K&, const V&) const noexcept {
+        return 1;
+    }
+};
+
+struct lru_cache_stats {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+};
+
+template<typename K, typename V,
+         typename Hash = std::hash<K>,
+         typename KeyEqual = std::equal_to<K>,
+         typename Weigher = unit_weight,
+         typename Mutex = std::mutex>
+class lru_cache {
+    //空闲链表中的节点item_为空，旧的key/value已经析构，不再占着它们持有的资源
+    struct Entry {
+        std::optional<std::pair<K, V>> item_;
+        std::size_t weight_ = 0;
+
+        const K& key() const noexcept {
+            return item_->first;
+        }
+
+        V& value() noexcept {
+            return item_->second;
+        }
+    };
+
+    using EntryList = ycstl::list<Entry>;
+    using EntryIter = typename EntryList::iterator;
+
+    //每个分片独立的链表、索引、锁和计数
+    struct Shard {
+        Mutex mutex_;
+        EntryList items_;           //表头最近使用，表尾最久未使用
+        EntryList free_;            //被淘汰的空节点，put时复用
+        std::unordered_map<K, EntryIter, Hash, KeyEqual> index_;
+        std::size_t weight_ = 0;
+        std::size_t capacity_ = 0;
+        lru_cache_stats stats_;
+    };
+
+public:
+    //每个分片空闲链表的节点上限
+    static constexpr std::size_t kMaxFreeNodes = 16;
+
+    using key_type    = K;
+    using mapped_type = V;
+    using size_type   = std::size_t;
+
+    // capacity为所有分片的总权重上限，平均分到每个分片
+    explicit lru_cache(size_type capacity, size_type shard_count = 1,
+                       const Hash& hash = Hash(), const Weigher& weigher = Weigher())
+        : shard_count_(0 == shard_count ? 1 : shard_count),
+          shards_(ycstl::make_unique<Shard[]>(shard_count_)),
+          hash_(hash), weigher_(weigher) {
+        size_type per_shard = capacity / shard_count_;
+        for (size_type i = 0; i != shard_count_; ++i) {
+            shards_[i].capacity_ = per_shard + (i < capacity % shard_count_ ? 1 : 0);
+        }
+    }
+
+    lru_cache(const lru_cache&) = delete;
+    lru_cache& operator=(const lru_cache&) = delete;
+
+    // 命中时返回值的拷贝并标记为最近使用
+    std::optional<V> get(const K& key) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<Mutex> lock(shard.mutex_);
+        auto found = shard.index_.find(key);
+        if (found == shard.index_.end()) {
+            ++shard.stats_.misses;
+            return std::nullopt;
+        }
+        ++shard.stats_.hits;
+        touch(shard, found->second);
+        return found->second->value();
+    }
+
+    bool contains(const K& key) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<Mutex> lock(shard.mutex_);
+        return shard.index_.find(key) != shard.index_.end();
+    }
+
+    // 插入或更新，必要时从表尾淘汰；单个元素权重超过分片容量时不插入并返回false
+    bool put(const K& key, V value) {
+        Shard& shard = shard_for(key);
+        size_type weight = weigher_(key, value);
+        std::lock_guard<Mutex> lock(shard.mutex_);
+        if (weight > shard.capacity_) {
+            return false;
+        }
+        auto found = shard.index_.find(key);
+        if (found != shard.index_.end()) {
+            EntryIter it = found->second;
+            shard.weight_ = shard.weight_ - it->weight_ + weight;
+            it->value() = std::move(value);
+            it->weight_ = weight;
+            touch(shard, it);
+        } else {
+            //先在空闲链表里构造好并登记到index_，都成功后再移到表头；
+            //构造或登记抛异常时条目清空后留在空闲链表里，items_、index_和weight_都不受影响
+            if (shard.free_.empty()) {
+                shard.free_.emplace_front();
+            }
+            EntryIter it = shard.free_.begin();
+            it->item_.emplace(key, std::move(value));
+            try {
+                shard.index_.emplace(key, it);
+            } catch (...) {
+                it->item_.reset();
+                throw;
+            }
+            it->weight_ = weight;
+            shard.items_.splice(shard.items_.begin(), shard.free_, it);
+            shard.weight_ += weight;
+        }
+        evict(shard);
+        return true;
+    }
+
+    bool erase(const K& key) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<Mutex> lock(shard.mutex_);
+        auto found = shard.index_.find(key);
+        if (found == shard.index_.end()) {
+            return false;
+        }
+        EntryIter it = found->second;
+        shard.weight_ -= it->weight_;
+        shard.index_.erase(found);
+        retire(shard, it);
+        return true;
+    }
+
+    void clear() {
+        for (size_type i = 0; i != shard_count_; ++i) {
+            Shard& shard = shards_[i];
+            std::lock_guard<Mutex> lock(shard.mutex_);
+            shard.index_.clear();
+            if (!shard.items_.empty()) {
+                shard.items_.clear();
+            }
+            if (!shard.free_.empty()) {
+                shard.free_.clear();
+            }
+            shard.weight_ = 0;
+        }
+    }
+
+    size_type size() {
+        size_type n = 0;
+        for (size_type i = 0; i != shard_count_; ++i) {
+            std::lock_guard<Mutex> lock(shards_[i].mutex_);
+            n += shards_[i].items_.size();
+        }
+        return n;
+    }
+
+    size_type weight() {
+        size_type w = 0;
+        for (size_type i = 0; i != shard_count_; ++i) {
+            std::lock_guard<Mutex> lock(shards_[i].mutex_);
+            w += shards_[i].weight_;
+        }
+        return w;
+    }
+
+    size_type shard_count() const noexcept {
+        return shard_count_;
+    }
+
+    lru_cache_stats stats() {
+        lru_cache_stats total;
+        for (size_type i = 0; i != shard_count_; ++i) {
+            std::lock_guard<Mutex> lock(shards_[i].mutex_);
+            total.hits += shards_[i].stats_.hits;
+            total.misses += shards_[i].stats_.misses;
+            total.evictions += shards_[i].stats_.evictions;
+        }
+        return total;
+    }
+
+    void reset_stats() {
+        for (size_type i = 0; i != shard_count_; ++i) {
+            std::lock_guard<Mutex> lock(shards_[i].mutex_);
+            shards_[i].stats_ = lru_cache_stats();
+        }
+    }
+
+private:
+    Shard& shard_for(const K& key) {
+        if (1 == shard_count_) {
+            return shards_[0];
+        }
+        //打散哈希值的高位再取模，避免和unordered_map的桶下标使用同一批低位
+        std::uint64_t h = static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+        return shards_[(h >> 32) % shard_count_];
+    }
+
+    static void touch(Shard& shard, EntryIter it) {
+        if (it == shard.items_.begin()) {
+            return;
+        }
+        shard.items_.splice(shard.items_.begin(), shard.items_, it);
+    }
+
+    //key/value立即析构，空节点留给下次put，空闲链表满了就释放节点
+    static void retire(Shard& shard, EntryIter it) {
+        if (shard.free_.size() >= kMaxFreeNodes) {
+            shard.items_.erase(it);
+            return;
+        }
+        it->item_.reset();
+        shard.free_.splice(shard.free_.begin(), shard.items_, it);
+    }
+
+    static void evict(Shard& shard) {
+        while (shard.weight_ > shard.capacity_) {
+            EntryIter victim = shard.items_.end();
+            --victim;
+            shard.weight_ -= victim->weight_;
+            shard.index_.erase(victim->key());
+            retire(shard, victim);
+            ++shard.stats_.evictions;
+        }
+    }
+
+    size_type shard_count_;
+    ycstl::unique_ptr<Shard[]> shards_;
+    YCSTL_NO_UNIQUE_ADDRESS Hash hash_;
+    YCSTL_NO_UNIQUE_ADDRESS Weigher weigher_;
+};
+
+}   //ycstl
+
+#endif
@@ -0,0 +1,710 @@
+/**
+ * 实现mdspan
+ * extents / dextents
+ * layout_right / layout_left / layout_stride / layout_blocked
+ * default_accessor / mdspan / submdspan / mdarray
+ *
+ * mdspan是不拥有内存的多维视图，mdarray在vector或array上持有数据；
+ * 布局策略负责把多维下标映射为一维偏移，内核按不同布局写一遍即可，不再手算下标；
+ * layout_blocked把二维矩阵按TileRows x TileCols的块连续存放，块内行主序
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef MDSPAN_HPP_
+#define MDSPAN_HPP_
+
+#include "array.hpp"
+#include "memory.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ycstl {
+
+inline constexpr std::size_t dynamic_extent = std::size_t(-1);
+
+//各维长度，编译期已知的维度不占存储，只保存动态维度
+template<typename IndexType, std::size_t... Extents>
+class extents {
+public:
+    using index_type = IndexType;
+    using size_type = std::make_unsigned_t<IndexType>;
+    using rank_type = std::size_t;
+
+    static constexpr rank_type rank() noexcept {
+        return sizeof...(Extents);
+    }
+
+    static constexpr rank_type rank_dynamic() noexcept {
+        return ((Extents == dynamic_extent ? 1 : 0) + ... + 0);
+    }
+
+    static constexpr std::size_t static_extent(rank_type r) noexcept {
+        return kStatic[r];
+    }
+
+    constexpr extents() noexcept : dynamic_{} {}
+
+    //可以只给出动态维度，也可以给出全部维度
+    template<typename... Indices, typename = std::enable_if_t<
+        (sizeof...(Indices) == rank_dynamic() || sizeof...(Indices) == rank()) &&
+        (std::is_convertible_v<Indices, index_type> && ...)>>
+    constexpr explicit extents(Indices... exts) noexcept
+        : extents(array<index_type, sizeof...(Indices)>{static_cast<index_type>(exts)...}) {}
+
+    template<typename OtherIndexType, std::size_t N, typename = std::enable_if_t<
+        (N == rank_dynamic() || N == rank()) && std::is_convertible_v<OtherIndexType, index_type>>>
+    constexpr explicit extents(const array<OtherIndexType, N>& exts) noexcept : dynamic_{} {
+        for (rank_type r = 0; r != rank(); ++r) {
+            if (dynamic_extent == kStatic[r]) {
+                dynamic_[dynamic_index(r)] = static_cast<index_type>(exts[N == rank() ? r : dynamic_index(r)]);
+            }
+        }
+    }
+
+    constexpr index_type extent(rank_type r) const noexcept {
+        if (dynamic_extent == kStatic[r]) {
+            return dynamic_[dynamic_index(r)];
+        }
+        return static_cast<index_type>(kStatic[r]);
+    }
+
+    //[first, last)各维长度的乘积
+    constexpr index_type product(rank_type first, rank_type last) const noexcept {
+        index_type n = 1;
+        for (rank_type r = first; r != last; ++r) {
+            n *= extent(r);
+        }
+        return n;
+    }
+
+    template<typename OtherIndexType, std::size_t... OtherExtents>
+    friend constexpr bool operator==(const extents& lhs, const extents<OtherIndexType, OtherExtents...>& rhs) noexcept {
+        if constexpr (sizeof...(OtherExtents) != rank()) {
+            return false;
+        } else {
+            for (rank_type r = 0; r != rank(); ++r) {
+                if (lhs.extent(r) != static_cast<index_type>(rhs.extent(r))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+private:
+    static constexpr array<std::size_t, sizeof...(Extents)> kStatic{Extents...};
+
+    //第r维之前有几个动态维度
+    static constexpr rank_type dynamic_index(rank_type r) noexcept {
+        rank_type n = 0;
+        for (rank_type i = 0; i != r; ++i) {
+            n += dynamic_extent == kStatic[i] ? 1 : 0;
+        }
+        return n;
+    }
+
+    array<index_type, rank_dynamic()> dynamic_;
+};
+
+template<typename IndexType, typename Sequence>
+struct MdspanDextents;
+
+template<typename IndexType, std::size_t... Is>
+struct MdspanDextents<IndexType, std::index_sequence<Is...>> {
+    using type = extents<IndexType, ((void)Is, dynamic_extent)...>;
+};
+
+template<typename IndexType, std::size_t Rank>
+using dextents = typename MdspanDextents<IndexType, std::make_index_sequence<Rank>>::type;
+
+//行主序，最后一维连续
+struct layout_right {
+    template<typename Extents>
+    class mapping {
+    public:
+        using extents_type = Extents;
+        using index_type = typename Extents::index_type;
+        using size_type = typename Extents::size_type;
+        using rank_type = typename Extents::rank_type;
+        using layout_type = layout_right;
+
+        constexpr mapping() noexcept = default;
+
+        constexpr mapping(const extents_type& exts) noexcept : extents_(exts) {}
+
+        constexpr const extents_type& extents() const noexcept {
+            return extents_;
+        }
+
+        template<typename... Indices>
+        constexpr index_type operator()(Indices... idx) const noexcept {
+            static_assert(sizeof...(Indices) == extents_type::rank(), "wrong number of indices");
+            index_type offset = 0;
+            rank_type r = 0;
+            ((offset = offset * extents_.extent(r) + static_cast<index_type>(idx), ++r), ...);
+            return offset;
+        }
+
+        constexpr index_type required_span_size() const noexcept {
+            return extents_.product(0, extents_type::rank());
+        }
+
+        constexpr index_type stride(rank_type r) const noexcept {
+            return extents_.product(r + 1, extents_type::rank());
+        }
+
+        static constexpr bool is_always_unique() noexcept { return true; }
+        static constexpr bool is_always_exhaustive() noexcept { return true; }
+        static constexpr bool is_always_strided() noexcept { return true; }
+        static constexpr bool is_unique() noexcept { return true; }
+        static constexpr bool is_exhaustive() noexcept { return true; }
+        static constexpr bool is_strided() noexcept { return true; }
+
+    private:
+        extents_type extents_;
+    };
+};
+
+//列主序，第一维连续
+struct layout_left {
+    template<typename Extents>
+    class mapping {
+    public:
+        using extents_type = Extents;
+        using index_type = typename Extents::index_type;
+        using size_type = typename Extents::size_type;
+        using rank_type = typename Extents::rank_type;
+        using layout_type = layout_left;
+
+        constexpr mapping() noexcept = default;
+
+        constexpr mapping(const extents_type& exts) noexcept : extents_(exts) {}
+
+        constexpr const extents_type& extents() const noexcept {
+            return extents_;
+        }
+
+        template<typename... Indices>
+        constexpr index_type operator()(Indices... idx) const noexcept {
+            static_assert(sizeof...(Indices) == extents_type::rank(), "wrong number of indices");
+            index_type offset = 0;
+            index_type stride = 1;
+            rank_type r = 0;
+            ((offset += static_cast<index_type>(idx) * stride, stride *= extents_.extent(r), ++r), ...);
+            return offset;
+        }
+
+        constexpr index_type required_span_size() const noexcept {
+            return extents_.product(0, extents_type::rank());
+        }
+
+        constexpr index_type stride(rank_type r) const noexcept {
+            return extents_.product(0, r);
+        }
+
+        static constexpr bool is_always_unique() noexcept { return true; }
+        static constexpr bool is_always_exhaustive() noexcept { return true; }
+        static constexpr bool is_always_strided() noexcept { return true; }
+        static constexpr bool is_unique() noexcept { return true; }
+        static constexpr bool is_exhaustive() noexcept { return true; }
+        static constexpr bool is_strided() noexcept { return true; }
+
+    private:
+        extents_type extents_;
+    };
+};
+
+//每一维任意步长，submdspan的结果都是这种布局
+struct layout_stride {
+    template<typename Extents>
+    class mapping {
+    public:
+        using extents_type = Extents;
+        using index_type = typename Extents::index_type;
+        using size_type = typename Extents::size_type;
+        using rank_type = typename Extents::rank_type;
+        using layout_type = layout_stride;
+
+        constexpr mapping() noexcept : extents_(), strides_{} {}
+
+        template<typename OtherIndexType>
+        constexpr mapping(const extents_type& exts, const array<OtherIndexType, extents_type::rank()>& strides) noexcept
+            : extents_(exts), strides_{} {
+            for (rank_type r = 0; r != extents_type::rank(); ++r) {
+                strides_[r] = static_cast<index_type>(strides[r]);
+            }
+        }
+
+        //从任意带步长的布局转换过来
+        template<typename OtherMapping, typename = std::enable_if_t<OtherMapping::is_always_strided()>>
+        constexpr explicit mapping(const OtherMapping& other) noexcept : extents_(other.extents()), strides_{} {
+            for (rank_type r = 0; r != extents_type::rank(); ++r) {
+                strides_[r] = other.stride(r);
+            }
+        }
+
+        constexpr const extents_type& extents() const noexcept {
+            return extents_;
+        }
+
+        constexpr const array<index_type, extents_type::rank()>& strides() const noexcept {
+            return strides_;
+        }
+
+        template<typename... Indices>
+        constexpr index_type operator()(Indices... idx) const noexcept {
+            static_assert(sizeof...(Indices) == extents_type::rank(), "wrong number of indices");
+            index_type offset = 0;
+            rank_type r = 0;
+            ((offset += static_cast<index_type>(idx) * strides_[r], ++r), ...);
+            return offset;
+        }
+
+        constexpr index_type required_span_size() const noexcept {
+            index_type size = 1;
+            for (rank_type r = 0; r != extents_type::rank(); ++r) {
+                if (0 == extents_.extent(r)) {
+                    return 0;
+                }
+                size += (extents_.extent(r) - 1) * strides_[r];
+            }
+            return size;
+        }
+
+        constexpr index_type stride(rank_type r) const noexcept {
+            return strides_[r];
+        }
+
+        static constexpr bool is_always_unique() noexcept { return true; }
+        static constexpr bool is_always_exhaustive() noexcept { return false; }
+        static constexpr bool is_always_strided() noexcept { return true; }
+        static constexpr bool is_unique() noexcept { return true; }
+        static constexpr bool is_strided() noexcept { return true; }
+
+        constexpr bool is_exhaustive() const noexcept {
+            return required_span_size() == extents_.product(0, extents_type::rank());
+        }
+
+    private:
+        extents_type extents_;
+        array<index_type, extents_type::rank()> strides_;
+    };
+};
+
+//二维分块布局：块按行主序排列，块内行主序，行列数向上补齐到块大小的整数倍
+//一个块正好落在连续内存中，分块内核访问的都是连续的TileRows * TileCols个元素
+template<std::size_t TileRows, std::size_t TileCols>
+struct layout_blocked {
+    static_assert(TileRows > 0 && TileCols > 0, "tile must not be empty");
+
+    template<typename Extents>
+    class mapping {
+        static_assert(Extents::rank() == 2, "layout_blocked only supports matrices");
+
+    public:
+        using extents_type = Extents;
+        using index_type = typename Extents::index_type;
+        using size_type = typename Extents::size_type;
+        using rank_type = typename Extents::rank_type;
+        using layout_type = layout_blocked;
+
+        static constexpr index_type kTileRows = TileRows;
+        static constexpr index_type kTileCols = TileCols;
+        static constexpr index_type kTileSize = kTileRows * kTileCols;
+
+        constexpr mapping() noexcept : extents_(), tiles_per_row_(0) {}
+
+        constexpr mapping(const extents_type& exts) noexcept
+            : extents_(exts), tiles_per_row_((exts.extent(1) + kTileCols - 1) / kTileCols) {}
+
+        constexpr const extents_type& extents() const noexcept {
+            return extents_;
+        }
+
+        constexpr index_type operator()(index_type i, index_type j) const noexcept {
+            index_type tile = (i / kTileRows) * tiles_per_row_ + j / kTileCols;
+            return tile * kTileSize + (i % kTileRows) * kTileCols + j % kTileCols;
+        }
+
+        constexpr index_type required_span_size() const noexcept {
+            index_type tile_rows = (extents_.extent(0) + kTileRows - 1) / kTileRows;
+            return tile_rows * tiles_per_row_ * kTileSize;
+        }
+
+        //从(tile_row, tile_col)块开始的连续内存偏移
+        constexpr index_type tile_offset(index_type tile_row, index_type tile_col) const noexcept {
+            return (tile_row * tiles_per_row_ + tile_col) * kTileSize;
+        }
+
+        static constexpr bool is_always_unique() noexcept { return true; }
+        static constexpr bool is_always_exhaustive() noexcept { return false; }
+        static constexpr bool is_always_strided() noexcept { return false; }
+        static constexpr bool is_unique() noexcept { return true; }
+        static constexpr bool is_strided() noexcept { return false; }
+
+        constexpr bool is_exhaustive() const noexcept {
+            return 0 == extents_.extent(0) % kTileRows && 0 == extents_.extent(1) % kTileCols;
+        }
+
+    private:
+        extents_type extents_;
+        index_type tiles_per_row_;
+    };
+};
+
+template<typename ElementType>
+struct default_accessor {
+    using offset_policy = default_accessor;
+    using element_type = ElementType;
+    using reference = ElementType&;
+    using data_handle_type = ElementType*;
+
+    constexpr default_accessor() noexcept = default;
+
+    template<typename OtherElementType, typename = std::enable_if_t<
+        std::is_convertible_v<OtherElementType(*)[], ElementType(*)[]>>>
+    constexpr default_accessor(default_accessor<OtherElementType>) noexcept {}
+
+    constexpr reference access(data_handle_type p, std::size_t i) const noexcept {
+        return p[i];
+    }
+
+    constexpr data_handle_type offset(data_handle_type p, std::size_t i) const noexcept {
+        return p + i;
+    }
+};
+
+template<typename ElementType, typename Extents, typename LayoutPolicy = layout_right,
+         typename AccessorPolicy = default_accessor<ElementType>>
+class mdspan {
+public:
+    using extents_type = Extents;
+    using layout_type = LayoutPolicy;
+    using accessor_type = AccessorPolicy;
+    using mapping_type = typename LayoutPolicy::template mapping<Extents>;
+    using element_type = ElementType;
+    using value_type = std::remove_cv_t<ElementType>;
+    using index_type = typename Extents::index_type;
+    using size_type = typename Extents::size_type;
+    using rank_type = typename Extents::rank_type;
+    using data_handle_type = typename AccessorPolicy::data_handle_type;
+    using reference = typename AccessorPolicy::reference;
+
+    static constexpr rank_type rank() noexcept {
+        return extents_type::rank();
+    }
+
+    static constexpr rank_type rank_dynamic() noexcept {
+        return extents_type::rank_dynamic();
+    }
+
+    static constexpr std::size_t static_extent(rank_type r) noexcept {
+        return extents_type::static_extent(r);
+    }
+
+    constexpr mdspan() = default;
+
+    template<typename... Indices, typename = std::enable_if_t<
+        (sizeof...(Indices) == rank_dynamic() || sizeof...(Indices) == rank()) &&
+        (std::is_convertible_v<Indices, index_type> && ...)>>
+    constexpr explicit mdspan(data_handle_type p, Indices... exts)
+        : data_(p), map_(extents_type(static_cast<index_type>(exts)...)) {}
+
+    constexpr mdspan(data_handle_type p, const extents_type& exts) : data_(p), map_(exts) {}
+
+    constexpr mdspan(data_handle_type p, const mapping_type& m, const accessor_type& a = accessor_type())
+        : data_(p), map_(m), acc_(a) {}
+
+    //从mdspan<T>到mdspan<const T>
+    template<typename OtherElementType, typename OtherAccessor, typename = std::enable_if_t<
+        std::is_convertible_v<typename OtherAccessor::data_handle_type, data_handle_type>>>
+    constexpr mdspan(const mdspan<OtherElementType, Extents, LayoutPolicy, OtherAccessor>& other)
+        : data_(other.data_handle()), map_(other.mapping()), acc_(other.accessor()) {}
+
+    template<typename... Indices>
+    constexpr reference operator()(Indices... idx) const {
+        return acc_.access(data_, map_(static_cast<index_type>(idx)...));
+    }
+
+    template<typename OtherIndexType>
+    constexpr reference operator[](const array<OtherIndexType, rank()>& idx) const {
+        return at_indices(idx, std::make_index_sequence<rank()>());
+    }
+
+    constexpr const extents_type& extents() const noexcept {
+        return map_.extents();
+    }
+
+    constexpr index_type extent(rank_type r) const noexcept {
+        return extents().extent(r);
+    }
+
+    constexpr size_type size() const noexcept {
+        return static_cast<size_type>(extents().product(0, rank()));
+    }
+
+    constexpr bool empty() const noexcept {
+        return 0 == size();
+    }
+
+    constexpr index_type stride(rank_type r) const {
+        return map_.stride(r);
+    }
+
+    constexpr const data_handle_type& data_handle() const noexcept {
+        return data_;
+    }
+
+    constexpr const mapping_type& mapping() const noexcept {
+        return map_;
+    }
+
+    constexpr const accessor_type& accessor() const noexcept {
+        return acc_;
+    }
+
+    static constexpr bool is_always_unique() { return mapping_type::is_always_unique(); }
+    static constexpr bool is_always_exhaustive() { return mapping_type::is_always_exhaustive(); }
+    static constexpr bool is_always_strided() { return mapping_type::is_always_strided(); }
+
+    constexpr bool is_unique() const { return map_.is_unique(); }
+    constexpr bool is_exhaustive() const { return map_.is_exhaustive(); }
+    constexpr bool is_strided() const { return map_.is_strided(); }
+
+private:
+    template<typename OtherIndexType, std::size_t... Is>
+    constexpr reference at_indices(const array<OtherIndexType, rank()>& idx, std::index_sequence<Is...>) const {
+        return (*this)(idx[Is]...);
+    }
+
+    data_handle_type data_{};
+    mapping_type map_;
+    YCSTL_NO_UNIQUE_ADDRESS accessor_type acc_;
+};
+
+//submdspan的切片：单个下标去掉这一维，full_extent保留整维，
+//pair{first, last}取[first, last)，strided_slice按步长取extent个元素
+struct full_extent_t {
+    explicit full_extent_t() = default;
+};
+
+inline constexpr full_extent_t full_extent{};
+
+struct strided_slice {
+    std::size_t offset;
+    std::size_t extent;
+    std::size_t stride;
+};
+
+struct MdspanSlice {
+    template<typename IndexType, typename Slice>
+    static constexpr bool keeps_rank() noexcept {
+        return !std::is_convertible_v<Slice, IndexType>;
+    }
+
+    template<typename IndexType, typename Slice>
+    static constexpr IndexType first(const Slice& slice) noexcept {
+        if constexpr (std::is_same_v<Slice, full_extent_t>) {
+            return 0;
+        } else if constexpr (std::is_same_v<Slice, strided_slice>) {
+            return static_cast<IndexType>(slice.offset);
+        } else if constexpr (keeps_rank<IndexType, Slice>()) {
+            return static_cast<IndexType>(slice.first);
+        } else {
+            return static_cast<IndexType>(slice);
+        }
+    }
+
+    template<typename IndexType, typename Slice>
+    static constexpr IndexType extent(const Slice& slice, IndexType whole) noexcept {
+        if constexpr (std::is_same_v<Slice, full_extent_t>) {
+            return whole;
+        } else if constexpr (std::is_same_v<Slice, strided_slice>) {
+            return static_cast<IndexType>(slice.extent);
+        } else {
+            return static_cast<IndexType>(slice.second) - static_cast<IndexType>(slice.first);
+        }
+    }
+
+    template<typename IndexType, typename Slice>
+    static constexpr IndexType stride(const Slice& slice) noexcept {
+        if constexpr (std::is_same_v<Slice, strided_slice>) {
+            return static_cast<IndexType>(slice.stride);
+        } else {
+            return 1;
+        }
+    }
+};
+
+//结果一律是动态维度的layout_stride，只支持带步长的布局
+template<typename ElementType, typename Extents, typename LayoutPolicy, typename AccessorPolicy, typename... Slices>
+constexpr auto submdspan(const mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>& src, Slices... slices) {
+    using index_type = typename Extents::index_type;
+    using sub_extents = dextents<index_type, (std::size_t(MdspanSlice::keeps_rank<index_type, Slices>()) + ... + 0)>;
+    using sub_mapping = layout_stride::mapping<sub_extents>;
+    using sub_accessor = typename AccessorPolicy::offset_policy;
+    static_assert(sizeof...(Slices) == Extents::rank(), "one slice per dimension");
+    static_assert(LayoutPolicy::template mapping<Extents>::is_always_strided(), "submdspan requires a strided layout");
+
+    array<index_type, sub_extents::rank()> exts{};
+    array<index_type, sub_extents::rank()> strides{};
+    index_type offset = 0;
+    std::size_t r = 0;
+    std::size_t k = 0;
+    auto apply = [&](const auto& slice) {
+        using Slice = std::decay_t<decltype(slice)>;
+        index_type stride = src.stride(r);
+        offset += MdspanSlice::first<index_type>(slice) * stride;
+        if constexpr (MdspanSlice::keeps_rank<index_type, Slice>()) {
+            exts[k] = MdspanSlice::extent<index_type>(slice, src.extent(r));
+            strides[k] = MdspanSlice::stride<index_type>(slice) * stride;
+            ++k;
+        }
+        ++r;
+    };
+    (apply(slices), ...);
+    return mdspan<ElementType, sub_extents, layout_stride, sub_accessor>(
+        src.accessor().offset(src.data_handle(), offset), sub_mapping(sub_extents(exts), strides),
+        sub_accessor(src.accessor()));
+}
+
+//持有数据的多维数组，Container可以是vector或足够大的array
+template<typename ElementType, typename Extents, typename LayoutPolicy = layout_right,
+         typename Container = vector<ElementType>>
+class mdarray {
+public:
+    using extents_type = Extents;
+    using layout_type = LayoutPolicy;
+    using container_type = Container;
+    using mapping_type = typename LayoutPolicy::template mapping<Extents>;
+    using element_type = ElementType;
+    using value_type = ElementType;
+    using index_type = typename Extents::index_type;
+    using size_type = typename Extents::size_type;
+    using rank_type = typename Extents::rank_type;
+    using pointer = ElementType*;
+    using const_pointer = const ElementType*;
+    using reference = ElementType&;
+    using const_reference = const ElementType&;
+    using mdspan_type = mdspan<ElementType, Extents, LayoutPolicy>;
+    using const_mdspan_type = mdspan<const ElementType, Extents, LayoutPolicy>;
+
+    static constexpr rank_type rank() noexcept {
+        return extents_type::rank();
+    }
+
+    static constexpr rank_type rank_dynamic() noexcept {
+        return extents_type::rank_dynamic();
+    }
+
+    constexpr mdarray() : map_(extents_type()) {
+        allocate_storage();
+    }
+
+    template<typename... Indices, typename = std::enable_if_t<
+        (sizeof...(Indices) == rank_dynamic() || sizeof...(Indices) == rank()) &&
+        (std::is_convertible_v<Indices, index_type> && ...)>>
+    constexpr explicit mdarray(Indices... exts) : map_(extents_type(static_cast<index_type>(exts)...)) {
+        allocate_storage();
+    }
+
+    constexpr explicit mdarray(const extents_type& exts) : map_(exts) {
+        allocate_storage();
+    }
+
+    constexpr explicit mdarray(const mapping_type& m) : map_(m) {
+        allocate_storage();
+    }
+
+    constexpr mdarray(const mapping_type& m, const value_type& value) : map_(m) {
+        allocate_storage();
+        for (auto& e : c_) {
+            e = value;
+        }
+    }
+
+    template<typename... Indices>
+    constexpr reference operator()(Indices... idx) {
+        return c_.data()[map_(static_cast<index_type>(idx)...)];
+    }
+
+    template<typename... Indices>
+    constexpr const_reference operator()(Indices... idx) const {
+        return c_.data()[map_(static_cast<index_type>(idx)...)];
+    }
+
+    constexpr const extents_type& extents() const noexcept {
+        return map_.extents();
+    }
+
+    constexpr index_type extent(rank_type r) const noexcept {
+        return extents().extent(r);
+    }
+
+    constexpr size_type size() const noexcept {
+        return static_cast<size_type>(extents().product(0, rank()));
+    }
+
+    constexpr bool empty() const noexcept {
+        return 0 == size();
+    }
+
+    constexpr index_type stride(rank_type r) const {
+        return map_.stride(r);
+    }
+
+    constexpr const mapping_type& mapping() const noexcept {
+        return map_;
+    }
+
+    constexpr pointer data() noexcept {
+        return c_.data();
+    }
+
+    constexpr const_pointer data() const noexcept {
+        return c_.data();
+    }
+
+    constexpr const container_type& container() const noexcept {
+        return c_;
+    }
+
+    constexpr mdspan_type to_mdspan() noexcept {
+        return mdspan_type(c_.data(), map_);
+    }
+
+    constexpr const_mdspan_type to_mdspan() const noexcept {
+        return const_mdspan_type(c_.data(), map_);
+    }
+
+    constexpr operator mdspan_type() noexcept {
+        return to_mdspan();
+    }
+
+    constexpr operator const_mdspan_type() const noexcept {
+        return to_mdspan();
+    }
+
+private:
+    //vector按布局需要的大小分配，array只检查容量
+    constexpr void allocate_storage() {
+        std::size_t n = static_cast<std::size_t>(map_.required_span_size());
+        if constexpr (requires(container_type& c) { c.resize(n); }) {
+            c_.resize(n);
+        } else if (c_.size() < n) {
+            throw std::length_error("mdarray container too small");
+        }
+    }
+
+    mapping_type map_;
+    container_type c_{};
+};
+
+}   //ycstl
+
+#endif
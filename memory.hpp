@@ -2,6 +2,11 @@
  * 已实现类
  * default_delete
  * unique_ptr
+ * allocator_delete / allocate_unique
+ * shared_ptr / weak_ptr
+ * local_shared_ptr / local_weak_ptr
+ * atomic_shared_ptr
+ * intrusive_ptr / intrusive_ref_counter / local_intrusive_ref_counter
  * 
  * @author YC奕晨 
  * */ 
@@ -11,6 +16,22 @@
 
 #include <type_traits>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+
+//空的删除器/分配器成员不占用空间，unique_ptr<T>与裸指针一样大
+#ifndef YCSTL_NO_UNIQUE_ADDRESS
+#if defined(_MSC_VER)
+#define YCSTL_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define YCSTL_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+#endif
  
 namespace ycstl {
 
@@ -98,6 +119,7 @@ public:
 
     unique_ptr& operator=(std::nullptr_t) noexcept {
         del_(data_);
+        data_ = nullptr;
         del_ = Deleter();
         return *this;
     }
@@ -148,7 +170,7 @@ public:
 
 private:
     T* data_;
-    Deleter del_;
+    YCSTL_NO_UNIQUE_ADDRESS Deleter del_;
 
     template<typename, typename>
     friend class unique_ptr;
@@ -207,12 +229,14 @@ public:
         data_ = u.data_;
         del_ = std::move(u.del_);
         u.data_ = nullptr;
+        return *this;
     }
 
     unique_ptr& operator=(std::nullptr_t) noexcept {
         del_(data_);
         data_ = nullptr;
         del_ = Deleter();
+        return *this;
     }
 
     T& operator[](size_t offset) const {
@@ -263,12 +287,15 @@ public:
 
 private:
     T* data_;
-    Deleter del_;
+    YCSTL_NO_UNIQUE_ADDRESS Deleter del_;
 
     template<typename, typename>
     friend class unique_ptr;
 };
 
+static_assert(sizeof(unique_ptr<int>) == sizeof(int*), "stateless deleter must not enlarge unique_ptr");
+static_assert(sizeof(unique_ptr<int[]>) == sizeof(int*), "stateless deleter must not enlarge unique_ptr<T[]>");
+
 //unique相关的非成员函数
 template<typename T, typename... Args, typename = std::enable_if_t<!std::is_array<T>::value>>
 unique_ptr<T> make_unique( Args&&... args ) {
@@ -281,6 +308,140 @@ unique_ptr<T> make_unique(std::size_t size) {
     return unique_ptr<T>(new ElementType[size]());
 }
 
+//默认初始化，平凡类型不清零，用于马上会被整体覆盖的缓冲区
+template<typename T, typename = std::enable_if_t<!std::is_array<T>::value>>
+unique_ptr<T> make_unique_for_overwrite() {
+    return unique_ptr<T>(new T);
+}
+
+template<typename T, typename = std::enable_if_t<std::is_array_v<T>>>
+unique_ptr<T> make_unique_for_overwrite(std::size_t size) {
+    using ElementType = std::remove_extent_t<T>;
+    return unique_ptr<T>(new ElementType[size]);
+}
+
+//allocate_unique使用的删除器，保存分配器，析构对象后把内存还给分配器
+template<typename T, typename Allocator>
+class allocator_delete {
+public:
+    using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+    allocator_delete() = default;
+
+    explicit allocator_delete(const Allocator& alloc) noexcept : alloc_(alloc) {}
+
+    void operator()(T* ptr) noexcept {
+        if (nullptr != ptr) {
+            std::destroy_at(ptr);
+            alloc_.deallocate(ptr, 1);
+        }
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return alloc_;
+    }
+
+private:
+    YCSTL_NO_UNIQUE_ADDRESS allocator_type alloc_;
+};
+
+//数组版本还需要记住元素个数
+template<typename T, typename Allocator>
+class allocator_delete<T[], Allocator> {
+public:
+    using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+    allocator_delete() = default;
+
+    allocator_delete(const Allocator& alloc, std::size_t size) noexcept : alloc_(alloc), size_(size) {}
+
+    void operator()(T* ptr) noexcept {
+        if (nullptr != ptr) {
+            std::destroy(ptr, ptr + size_);
+            alloc_.deallocate(ptr, size_);
+        }
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return alloc_;
+    }
+
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+private:
+    YCSTL_NO_UNIQUE_ADDRESS allocator_type alloc_;
+    std::size_t size_ = 0;
+};
+
+template<typename T, typename A, typename... Args, typename = std::enable_if_t<!std::is_array<T>::value>>
+unique_ptr<T, allocator_delete<T, A>> allocate_unique(const A& alloc, Args&&... args) {
+    allocator_delete<T, A> del(alloc);
+    typename allocator_delete<T, A>::allocator_type a = del.get_allocator();
+    T* p = a.allocate(1);
+    try {
+        std::construct_at(p, std::forward<Args>(args)...);
+    } catch (...) {
+        a.deallocate(p, 1);
+        throw;
+    }
+    return unique_ptr<T, allocator_delete<T, A>>(p, std::move(del));
+}
+
+//逐个值初始化，构造中途抛出异常时析构已构造的元素
+template<typename T, typename A, typename = std::enable_if_t<std::is_array_v<T>>>
+unique_ptr<T, allocator_delete<T, A>> allocate_unique(const A& alloc, std::size_t size) {
+    using ElementType = std::remove_extent_t<T>;
+    allocator_delete<T, A> del(alloc, size);
+    typename allocator_delete<T, A>::allocator_type a = del.get_allocator();
+    ElementType* p = a.allocate(size);
+    std::size_t i = 0;
+    try {
+        for (; i != size; ++i) {
+            ::new (static_cast<void*>(p + i)) ElementType();
+        }
+    } catch (...) {
+        std::destroy(p, p + i);
+        a.deallocate(p, size);
+        throw;
+    }
+    return unique_ptr<T, allocator_delete<T, A>>(p, std::move(del));
+}
+
+template<typename T, typename A, typename = std::enable_if_t<!std::is_array<T>::value>>
+unique_ptr<T, allocator_delete<T, A>> allocate_unique_for_overwrite(const A& alloc) {
+    allocator_delete<T, A> del(alloc);
+    typename allocator_delete<T, A>::allocator_type a = del.get_allocator();
+    T* p = a.allocate(1);
+    try {
+        ::new (static_cast<void*>(p)) T;
+    } catch (...) {
+        a.deallocate(p, 1);
+        throw;
+    }
+    return unique_ptr<T, allocator_delete<T, A>>(p, std::move(del));
+}
+
+template<typename T, typename A, typename = std::enable_if_t<std::is_array_v<T>>>
+unique_ptr<T, allocator_delete<T, A>> allocate_unique_for_overwrite(const A& alloc, std::size_t size) {
+    using ElementType = std::remove_extent_t<T>;
+    allocator_delete<T, A> del(alloc, size);
+    typename allocator_delete<T, A>::allocator_type a = del.get_allocator();
+    ElementType* p = a.allocate(size);
+    std::size_t i = 0;
+    try {
+        for (; i != size; ++i) {
+            ::new (static_cast<void*>(p + i)) ElementType;
+        }
+    } catch (...) {
+        std::destroy(p, p + i);
+        a.deallocate(p, size);
+        throw;
+    }
+    return unique_ptr<T, allocator_delete<T, A>>(p, std::move(del));
+}
+
 template<typename T, typename = std::enable_if_t<!std::is_array<T>::value>>
 bool operator==(const unique_ptr<T>& u1, const unique_ptr<T>& u2) {
     return u1.get() == u2.get();
@@ -312,6 +473,971 @@ bool operator==(std::nullptr_t, const std::unique_ptr<T>& u) {
 }
 
 
+//shared_ptr的实现
+//basic_shared_ptr<T, true>为shared_ptr，引用计数是原子的；basic_shared_ptr<T, false>为local_shared_ptr，只能在单线程中使用
+class bad_weak_ptr : public std::exception {
+public:
+    const char* what() const noexcept override {
+        return "ycstl::bad_weak_ptr";
+    }
+};
+
+//控制块基类，use_count_为0时释放对象，weak_count_为0时释放控制块
+//只要还有shared_ptr存在，weak_count_就额外持有1
+template<bool Atomic>
+class ControlBlock {
+    using Count = std::conditional_t<Atomic, std::atomic<long>, long>;
+
+public:
+    ControlBlock() noexcept : use_count_(1), weak_count_(1) {}
+
+    virtual ~ControlBlock() = default;
+
+    virtual void dispose() noexcept = 0;        //释放被管理的对象
+    virtual void destroy() noexcept = 0;        //释放控制块自身
+
+    void add_ref() noexcept {
+        increment(use_count_);
+    }
+
+    void release() noexcept {
+        if (0 == decrement(use_count_)) {
+            dispose();
+            weak_release();
+        }
+    }
+
+    void weak_add_ref() noexcept {
+        increment(weak_count_);
+    }
+
+    void weak_release() noexcept {
+        if (0 == decrement(weak_count_)) {
+            destroy();
+        }
+    }
+
+    //weak_ptr::lock使用，对象已释放时返回false
+    bool try_add_ref() noexcept {
+        if constexpr (Atomic) {
+            long n = use_count_.load(std::memory_order_relaxed);
+            while (0 != n) {
+                if (use_count_.compare_exchange_weak(n, n + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        } else {
+            if (0 == use_count_) {
+                return false;
+            }
+            ++use_count_;
+            return true;
+        }
+    }
+
+    long use_count() const noexcept {
+        if constexpr (Atomic) {
+            return use_count_.load(std::memory_order_relaxed);
+        } else {
+            return use_count_;
+        }
+    }
+
+private:
+    static void increment(Count& count) noexcept {
+        if constexpr (Atomic) {
+            count.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            ++count;
+        }
+    }
+
+    static long decrement(Count& count) noexcept {
+        if constexpr (Atomic) {
+            return count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        } else {
+            return --count;
+        }
+    }
+
+    Count use_count_;
+    Count weak_count_;
+};
+
+//通过指针接管对象的控制块，保存删除器和用于释放控制块的分配器
+template<bool Atomic, typename P, typename D, typename A>
+class PtrControlBlock : public ControlBlock<Atomic> {
+public:
+    PtrControlBlock(P p, D d, const A& a) : ptr_(p), del_(std::move(d)), alloc_(a) {}
+
+    void dispose() noexcept override {
+        del_(ptr_);
+    }
+
+    void destroy() noexcept override {
+        using BlockAllocator = typename std::allocator_traits<A>::template rebind_alloc<PtrControlBlock>;
+        BlockAllocator block_alloc{alloc_};
+        std::destroy_at(this);
+        block_alloc.deallocate(this, 1);
+    }
+
+private:
+    P ptr_;
+    YCSTL_NO_UNIQUE_ADDRESS D del_;
+    YCSTL_NO_UNIQUE_ADDRESS A alloc_;
+};
+
+//make_shared使用，对象和控制块在同一次分配中
+template<bool Atomic, typename T, typename A>
+class InplaceControlBlock : public ControlBlock<Atomic> {
+public:
+    template<typename... Args>
+    explicit InplaceControlBlock(const A& a, Args&&... args) : alloc_(a) {
+        std::construct_at(get(), std::forward<Args>(args)...);
+    }
+
+    std::remove_cv_t<T>* get() noexcept {
+        return reinterpret_cast<std::remove_cv_t<T>*>(&storage_);
+    }
+
+    void dispose() noexcept override {
+        std::destroy_at(get());
+    }
+
+    void destroy() noexcept override {
+        using BlockAllocator = typename std::allocator_traits<A>::template rebind_alloc<InplaceControlBlock>;
+        BlockAllocator block_alloc{alloc_};
+        std::destroy_at(this);
+        block_alloc.deallocate(this, 1);
+    }
+
+private:
+    YCSTL_NO_UNIQUE_ADDRESS A alloc_;
+    alignas(T) unsigned char storage_[sizeof(T)];
+};
+
+struct SharedInplaceTag {};
+
+template<typename T, bool Atomic>
+class basic_weak_ptr;
+
+template<typename T, bool Atomic = true>
+class basic_shared_ptr {
+    template<typename Y>
+    static constexpr bool compatible = std::is_convertible_v<Y*, std::remove_extent_t<T>*>;
+
+public:
+    using element_type = std::remove_extent_t<T>;
+    using weak_type = basic_weak_ptr<T, Atomic>;
+
+    constexpr basic_shared_ptr() noexcept : ptr_(nullptr), ctrl_(nullptr) {}
+
+    constexpr basic_shared_ptr(std::nullptr_t) noexcept : ptr_(nullptr), ctrl_(nullptr) {}
+
+    template<typename Y, typename = std::enable_if_t<compatible<Y>>>
+    explicit basic_shared_ptr(Y* p) : basic_shared_ptr(p, default_delete<std::conditional_t<std::is_array_v<T>, Y[], Y>>()) {}
+
+    template<typename Y, typename D, typename = std::enable_if_t<
+        compatible<Y> && std::is_invocable_v<D&, Y*>
+    >>
+    basic_shared_ptr(Y* p, D d) : basic_shared_ptr(p, std::move(d), std::allocator<std::remove_cv_t<Y>>()) {}
+
+    //控制块由a分配；分配失败时用d释放p
+    template<typename Y, typename D, typename A, typename = std::enable_if_t<
+        compatible<Y> && std::is_invocable_v<D&, Y*>
+    >>
+    basic_shared_ptr(Y* p, D d, A a) : ptr_(p), ctrl_(nullptr) {
+        using Block = PtrControlBlock<Atomic, Y*, D, A>;
+        using BlockAllocator = typename std::allocator_traits<A>::template rebind_alloc<Block>;
+        BlockAllocator block_alloc{a};
+        Block* block = nullptr;
+        try {
+            block = block_alloc.allocate(1);
+        } catch (...) {
+            d(p);
+            throw;
+        }
+        std::construct_at(block, p, std::move(d), a);
+        ctrl_ = block;
+    }
+
+    template<typename D, typename = std::enable_if_t<std::is_invocable_v<D&, element_type*>>>
+    basic_shared_ptr(std::nullptr_t, D d) : basic_shared_ptr(static_cast<element_type*>(nullptr), std::move(d)) {}
+
+    //别名构造：与r共享所有权，但get()返回p
+    template<typename Y>
+    basic_shared_ptr(const basic_shared_ptr<Y, Atomic>& r, element_type* p) noexcept : ptr_(p), ctrl_(r.ctrl_) {
+        if (nullptr != ctrl_) {
+            ctrl_->add_ref();
+        }
+    }
+
+    template<typename Y>
+    basic_shared_ptr(basic_shared_ptr<Y, Atomic>&& r, element_type* p) noexcept : ptr_(p), ctrl_(r.ctrl_) {
+        r.ptr_ = nullptr;
+        r.ctrl_ = nullptr;
+    }
+
+    basic_shared_ptr(const basic_shared_ptr& r) noexcept : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        if (nullptr != ctrl_) {
+            ctrl_->add_ref();
+        }
+    }
+
+    template<typename Y, typename = std::enable_if_t<compatible<Y>>>
+    basic_shared_ptr(const basic_shared_ptr<Y, Atomic>& r) noexcept : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        if (nullptr != ctrl_) {
+            ctrl_->add_ref();
+        }
+    }
+
+    basic_shared_ptr(basic_shared_ptr&& r) noexcept : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        r.ptr_ = nullptr;
+        r.ctrl_ = nullptr;
+    }
+
+    template<typename Y, typename = std::enable_if_t<compatible<Y>>>
+    basic_shared_ptr(basic_shared_ptr<Y, Atomic>&& r) noexcept : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        r.ptr_ = nullptr;
+        r.ctrl_ = nullptr;
+    }
+
+    template<typename Y, typename = std::enable_if_t<compatible<Y>>>
+    explicit basic_shared_ptr(const basic_weak_ptr<Y, Atomic>& r) : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        if (nullptr == ctrl_ || !ctrl_->try_add_ref()) {
+            throw bad_weak_ptr();
+        }
+    }
+
+    template<typename Y, typename D, typename = std::enable_if_t<compatible<Y>>>
+    basic_shared_ptr(unique_ptr<Y, D>&& u) : ptr_(nullptr), ctrl_(nullptr) {
+        if (nullptr != u.get()) {
+            D del = std::move(u.get_deleter());
+            basic_shared_ptr(u.release(), std::move(del)).swap(*this);
+        }
+    }
+
+    //make_shared/allocate_shared使用
+    template<typename A, typename... Args>
+    basic_shared_ptr(SharedInplaceTag, const A& a, Args&&... args) : ptr_(nullptr), ctrl_(nullptr) {
+        using Block = InplaceControlBlock<Atomic, T, A>;
+        using BlockAllocator = typename std::allocator_traits<A>::template rebind_alloc<Block>;
+        BlockAllocator block_alloc{a};
+        Block* block = block_alloc.allocate(1);
+        try {
+            std::construct_at(block, a, std::forward<Args>(args)...);
+        } catch (...) {
+            block_alloc.deallocate(block, 1);
+            throw;
+        }
+        ptr_ = block->get();
+        ctrl_ = block;
+    }
+
+    ~basic_shared_ptr() {
+        if (nullptr != ctrl_) {
+            ctrl_->release();
+        }
+    }
+
+    basic_shared_ptr& operator=(const basic_shared_ptr& r) noexcept {
+        basic_shared_ptr(r).swap(*this);
+        return *this;
+    }
+
+    template<typename Y, typename = std::enable_if_t<compatible<Y>>>
+    basic_shared_ptr& operator=(const basic_shared_ptr<Y, Atomic>& r) noexcept {
+        basic_shared_ptr(r).swap(*this);
+        return *this;
+    }
+
+    basic_shared_ptr& operator=(basic_shared_ptr&& r) noexcept {
+        basic_shared_ptr(std::move(r)).swap(*this);
+        return *this;
+    }
+
+    template<typename Y, typename = std::enable_if_t<compatible<Y>>>
+    basic_shared_ptr& operator=(basic_shared_ptr<Y, Atomic>&& r) noexcept {
+        basic_shared_ptr(std::move(r)).swap(*this);
+        return *this;
+    }
+
+    template<typename Y, typename D, typename = std::enable_if_t<compatible<Y>>>
+    basic_shared_ptr& operator=(unique_ptr<Y, D>&& u) {
+        basic_shared_ptr(std::move(u)).swap(*this);
+        return *this;
+    }
+
+    void reset() noexcept {
+        basic_shared_ptr().swap(*this);
+    }
+
+    template<typename Y, typename = std::enable_if_t<compatible<Y>>>
+    void reset(Y* p) {
+        basic_shared_ptr(p).swap(*this);
+    }
+
+    template<typename Y, typename D, typename = std::enable_if_t<compatible<Y>>>
+    void reset(Y* p, D d) {
+        basic_shared_ptr(p, std::move(d)).swap(*this);
+    }
+
+    template<typename Y, typename D, typename A, typename = std::enable_if_t<compatible<Y>>>
+    void reset(Y* p, D d, A a) {
+        basic_shared_ptr(p, std::move(d), std::move(a)).swap(*this);
+    }
+
+    void swap(basic_shared_ptr& r) noexcept {
+        element_type* tmp_ptr = ptr_;
+        ptr_ = r.ptr_;
+        r.ptr_ = tmp_ptr;
+        ControlBlock<Atomic>* tmp_ctrl = ctrl_;
+        ctrl_ = r.ctrl_;
+        r.ctrl_ = tmp_ctrl;
+    }
+
+    element_type* get() const noexcept {
+        return ptr_;
+    }
+
+    template<typename U = T, typename = std::enable_if_t<!std::is_array_v<U>>>
+    std::add_lvalue_reference_t<U> operator*() const noexcept {
+        return *ptr_;
+    }
+
+    template<typename U = T, typename = std::enable_if_t<!std::is_array_v<U>>>
+    element_type* operator->() const noexcept {
+        return ptr_;
+    }
+
+    template<typename U = T, typename = std::enable_if_t<std::is_array_v<U>>>
+    element_type& operator[](std::ptrdiff_t offset) const {
+        return ptr_[offset];
+    }
+
+    long use_count() const noexcept {
+        return nullptr == ctrl_ ? 0 : ctrl_->use_count();
+    }
+
+    explicit operator bool() const noexcept {
+        return nullptr != ptr_;
+    }
+
+    //按控制块地址排序，别名指针与原指针视为同一所有者
+    template<typename Y>
+    bool owner_before(const basic_shared_ptr<Y, Atomic>& r) const noexcept {
+        return std::less<ControlBlock<Atomic>*>()(ctrl_, r.ctrl_);
+    }
+
+    template<typename Y>
+    bool owner_before(const basic_weak_ptr<Y, Atomic>& r) const noexcept {
+        return std::less<ControlBlock<Atomic>*>()(ctrl_, r.ctrl_);
+    }
+
+private:
+    element_type* ptr_;
+    ControlBlock<Atomic>* ctrl_;
+
+    template<typename, bool>
+    friend class basic_shared_ptr;
+
+    template<typename, bool>
+    friend class basic_weak_ptr;
+};
+
+template<typename T, bool Atomic = true>
+class basic_weak_ptr {
+    template<typename Y>
+    static constexpr bool compatible = std::is_convertible_v<Y*, std::remove_extent_t<T>*>;
+
+public:
+    using element_type = std::remove_extent_t<T>;
+
+    constexpr basic_weak_ptr() noexcept : ptr_(nullptr), ctrl_(nullptr) {}
+
+    template<typename Y, typename = std::enable_if_t<compatible<Y>>>
+    basic_weak_ptr(const basic_shared_ptr<Y, Atomic>& r) noexcept : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        if (nullptr != ctrl_) {
+            ctrl_->weak_add_ref();
+        }
+    }
+
+    basic_weak_ptr(const basic_weak_ptr& r) noexcept : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        if (nullptr != ctrl_) {
+            ctrl_->weak_add_ref();
+        }
+    }
+
+    template<typename Y, typename = std::enable_if_t<compatible<Y>>>
+    basic_weak_ptr(const basic_weak_ptr<Y, Atomic>& r) noexcept : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        if (nullptr != ctrl_) {
+            ctrl_->weak_add_ref();
+        }
+    }
+
+    basic_weak_ptr(basic_weak_ptr&& r) noexcept : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        r.ptr_ = nullptr;
+        r.ctrl_ = nullptr;
+    }
+
+    template<typename Y, typename = std::enable_if_t<compatible<Y>>>
+    basic_weak_ptr(basic_weak_ptr<Y, Atomic>&& r) noexcept : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        r.ptr_ = nullptr;
+        r.ctrl_ = nullptr;
+    }
+
+    ~basic_weak_ptr() {
+        if (nullptr != ctrl_) {
+            ctrl_->weak_release();
+        }
+    }
+
+    basic_weak_ptr& operator=(const basic_weak_ptr& r) noexcept {
+        basic_weak_ptr(r).swap(*this);
+        return *this;
+    }
+
+    template<typename Y, typename = std::enable_if_t<compatible<Y>>>
+    basic_weak_ptr& operator=(const basic_weak_ptr<Y, Atomic>& r) noexcept {
+        basic_weak_ptr(r).swap(*this);
+        return *this;
+    }
+
+    template<typename Y, typename = std::enable_if_t<compatible<Y>>>
+    basic_weak_ptr& operator=(const basic_shared_ptr<Y, Atomic>& r) noexcept {
+        basic_weak_ptr(r).swap(*this);
+        return *this;
+    }
+
+    basic_weak_ptr& operator=(basic_weak_ptr&& r) noexcept {
+        basic_weak_ptr(std::move(r)).swap(*this);
+        return *this;
+    }
+
+    void reset() noexcept {
+        basic_weak_ptr().swap(*this);
+    }
+
+    void swap(basic_weak_ptr& r) noexcept {
+        element_type* tmp_ptr = ptr_;
+        ptr_ = r.ptr_;
+        r.ptr_ = tmp_ptr;
+        ControlBlock<Atomic>* tmp_ctrl = ctrl_;
+        ctrl_ = r.ctrl_;
+        r.ctrl_ = tmp_ctrl;
+    }
+
+    long use_count() const noexcept {
+        return nullptr == ctrl_ ? 0 : ctrl_->use_count();
+    }
+
+    bool expired() const noexcept {
+        return 0 == use_count();
+    }
+
+    //对象仍存活时返回共享它的指针，否则返回空指针
+    basic_shared_ptr<T, Atomic> lock() const noexcept {
+        basic_shared_ptr<T, Atomic> p;
+        if (nullptr != ctrl_ && ctrl_->try_add_ref()) {
+            p.ptr_ = ptr_;
+            p.ctrl_ = ctrl_;
+        }
+        return p;
+    }
+
+    template<typename Y>
+    bool owner_before(const basic_shared_ptr<Y, Atomic>& r) const noexcept {
+        return std::less<ControlBlock<Atomic>*>()(ctrl_, r.ctrl_);
+    }
+
+    template<typename Y>
+    bool owner_before(const basic_weak_ptr<Y, Atomic>& r) const noexcept {
+        return std::less<ControlBlock<Atomic>*>()(ctrl_, r.ctrl_);
+    }
+
+private:
+    element_type* ptr_;
+    ControlBlock<Atomic>* ctrl_;
+
+    template<typename, bool>
+    friend class basic_shared_ptr;
+
+    template<typename, bool>
+    friend class basic_weak_ptr;
+};
+
+template<typename T>
+using shared_ptr = basic_shared_ptr<T, true>;
+
+template<typename T>
+using weak_ptr = basic_weak_ptr<T, true>;
+
+template<typename T>
+using local_shared_ptr = basic_shared_ptr<T, false>;
+
+template<typename T>
+using local_weak_ptr = basic_weak_ptr<T, false>;
+
+//shared相关的非成员函数
+template<typename T, typename A, typename... Args, typename = std::enable_if_t<!std::is_array<T>::value>>
+shared_ptr<T> allocate_shared(const A& alloc, Args&&... args) {
+    return shared_ptr<T>(SharedInplaceTag(), alloc, std::forward<Args>(args)...);
+}
+
+template<typename T, typename... Args, typename = std::enable_if_t<!std::is_array<T>::value>>
+shared_ptr<T> make_shared(Args&&... args) {
+    return shared_ptr<T>(SharedInplaceTag(), std::allocator<std::remove_cv_t<T>>(), std::forward<Args>(args)...);
+}
+
+template<typename T, typename A, typename... Args, typename = std::enable_if_t<!std::is_array<T>::value>>
+local_shared_ptr<T> allocate_local_shared(const A& alloc, Args&&... args) {
+    return local_shared_ptr<T>(SharedInplaceTag(), alloc, std::forward<Args>(args)...);
+}
+
+template<typename T, typename... Args, typename = std::enable_if_t<!std::is_array<T>::value>>
+local_shared_ptr<T> make_local_shared(Args&&... args) {
+    return local_shared_ptr<T>(SharedInplaceTag(), std::allocator<std::remove_cv_t<T>>(), std::forward<Args>(args)...);
+}
+
+template<typename T, typename U, bool Atomic>
+basic_shared_ptr<T, Atomic> static_pointer_cast(const basic_shared_ptr<U, Atomic>& r) noexcept {
+    return basic_shared_ptr<T, Atomic>(r, static_cast<typename basic_shared_ptr<T, Atomic>::element_type*>(r.get()));
+}
+
+template<typename T, typename U, bool Atomic>
+basic_shared_ptr<T, Atomic> const_pointer_cast(const basic_shared_ptr<U, Atomic>& r) noexcept {
+    return basic_shared_ptr<T, Atomic>(r, const_cast<typename basic_shared_ptr<T, Atomic>::element_type*>(r.get()));
+}
+
+template<typename T, typename U, bool Atomic>
+basic_shared_ptr<T, Atomic> dynamic_pointer_cast(const basic_shared_ptr<U, Atomic>& r) noexcept {
+    auto p = dynamic_cast<typename basic_shared_ptr<T, Atomic>::element_type*>(r.get());
+    if (nullptr == p) {
+        return basic_shared_ptr<T, Atomic>();
+    }
+    return basic_shared_ptr<T, Atomic>(r, p);
+}
+
+template<typename T, typename U, bool Atomic>
+bool operator==(const basic_shared_ptr<T, Atomic>& p1, const basic_shared_ptr<U, Atomic>& p2) noexcept {
+    return p1.get() == p2.get();
+}
+
+template<typename T, typename U, bool Atomic>
+bool operator!=(const basic_shared_ptr<T, Atomic>& p1, const basic_shared_ptr<U, Atomic>& p2) noexcept {
+    return p1.get() != p2.get();
+}
+
+template<typename T, bool Atomic>
+bool operator==(const basic_shared_ptr<T, Atomic>& p, std::nullptr_t) noexcept {
+    return p.get() == nullptr;
+}
+
+template<typename T, bool Atomic>
+bool operator==(std::nullptr_t, const basic_shared_ptr<T, Atomic>& p) noexcept {
+    return p.get() == nullptr;
+}
+
+template<typename T, bool Atomic>
+bool operator!=(const basic_shared_ptr<T, Atomic>& p, std::nullptr_t) noexcept {
+    return p.get() != nullptr;
+}
+
+template<typename T, bool Atomic>
+bool operator!=(std::nullptr_t, const basic_shared_ptr<T, Atomic>& p) noexcept {
+    return p.get() != nullptr;
+}
+
+//atomic_shared_ptr的实现
+//原子字的低48位是指向AtomicSharedHolder的指针，高16位是外部计数(正在读取该holder的线程数)
+//读者先把外部计数加1再访问holder，拷贝出shared_ptr后把计数还回去；
+//如果holder在此期间已被换下，则改为减少holder的内部计数，内部计数归零的线程负责释放holder
+template<typename T>
+struct AtomicSharedHolder {
+    explicit AtomicSharedHolder(shared_ptr<T> value) noexcept : value_(std::move(value)), refs_(0) {}
+
+    shared_ptr<T> value_;
+    std::atomic<long> refs_;
+};
+
+template<typename T>
+class atomic_shared_ptr {
+    using Holder = AtomicSharedHolder<T>;
+
+    static_assert(sizeof(void*) == sizeof(std::uint64_t), "atomic_shared_ptr packs a 48-bit pointer into a 64-bit word");
+
+    static constexpr int kCountShift = 48;
+    static constexpr std::uint64_t kCountOne = std::uint64_t(1) << kCountShift;
+    static constexpr std::uint64_t kPointerMask = kCountOne - 1;
+
+public:
+    using value_type = shared_ptr<T>;
+
+    constexpr atomic_shared_ptr() noexcept : word_(0) {}
+
+    atomic_shared_ptr(std::nullptr_t) noexcept : word_(0) {}
+
+    atomic_shared_ptr(shared_ptr<T> desired) : word_(pack(make_holder(std::move(desired)), 0)) {}
+
+    //析构时不能再有其他线程访问
+    ~atomic_shared_ptr() {
+        delete holder_of(word_.load(std::memory_order_relaxed));
+    }
+
+    atomic_shared_ptr(const atomic_shared_ptr&) = delete;
+    atomic_shared_ptr& operator=(const atomic_shared_ptr&) = delete;
+
+    atomic_shared_ptr& operator=(shared_ptr<T> desired) {
+        store(std::move(desired));
+        return *this;
+    }
+
+    operator shared_ptr<T>() const {
+        return load();
+    }
+
+    bool is_lock_free() const noexcept {
+        return word_.is_lock_free();
+    }
+
+    //内部统一使用acq_rel/seq_cst，order参数只为与std::atomic接口保持一致
+    shared_ptr<T> load(std::memory_order = std::memory_order_seq_cst) const {
+        Holder* holder = acquire();
+        if (nullptr == holder) {
+            release(holder);
+            return shared_ptr<T>();
+        }
+        shared_ptr<T> result = holder->value_;
+        release(holder);
+        return result;
+    }
+
+    void store(shared_ptr<T> desired, std::memory_order order = std::memory_order_seq_cst) {
+        exchange(std::move(desired), order);
+    }
+
+    shared_ptr<T> exchange(shared_ptr<T> desired, std::memory_order = std::memory_order_seq_cst) {
+        Holder* holder = make_holder(std::move(desired));
+        std::uint64_t old = word_.exchange(pack(holder, 0), std::memory_order_acq_rel);
+        return retire(old, 0);
+    }
+
+    //expected与当前值指向同一对象且共享同一控制块时才替换；失败时expected更新为当前值
+    bool compare_exchange_strong(shared_ptr<T>& expected, shared_ptr<T> desired,
+                                 std::memory_order = std::memory_order_seq_cst,
+                                 std::memory_order = std::memory_order_seq_cst) {
+        Holder* holder = acquire();
+        if (!equivalent(holder, expected)) {
+            expected = nullptr == holder ? shared_ptr<T>() : holder->value_;
+            release(holder);
+            return false;
+        }
+        Holder* desired_holder = make_holder(std::move(desired));
+        std::uint64_t cur = word_.load(std::memory_order_acquire);
+        while (holder_of(cur) == holder) {
+            if (word_.compare_exchange_weak(cur, pack(desired_holder, 0), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                //自己持有的那一份外部计数随旧holder一起结算
+                retire(cur, 1);
+                return true;
+            }
+        }
+        //在比较之后被其他线程替换，按失败处理
+        delete desired_holder;
+        release(holder);
+        expected = load();
+        return false;
+    }
+
+    bool compare_exchange_weak(shared_ptr<T>& expected, shared_ptr<T> desired,
+                               std::memory_order success = std::memory_order_seq_cst,
+                               std::memory_order failure = std::memory_order_seq_cst) {
+        return compare_exchange_strong(expected, std::move(desired), success, failure);
+    }
+
+private:
+    static Holder* make_holder(shared_ptr<T> value) {
+        if (nullptr == value.get() && 0 == value.use_count()) {
+            return nullptr;
+        }
+        return new Holder(std::move(value));
+    }
+
+    //5级页表(LA57)或指针标记(ARM TBI/MTE)下地址可能用到高16位，与计数重叠时无法继续，直接终止
+    static std::uint64_t pack(Holder* holder, std::uint64_t count) noexcept {
+        std::uint64_t bits = reinterpret_cast<std::uint64_t>(holder);
+        if (0 != (bits & ~kPointerMask)) {
+            std::abort();
+        }
+        return bits | (count << kCountShift);
+    }
+
+    static Holder* holder_of(std::uint64_t word) noexcept {
+        return reinterpret_cast<Holder*>(word & kPointerMask);
+    }
+
+    static bool equivalent(Holder* holder, const shared_ptr<T>& expected) noexcept {
+        if (nullptr == holder) {
+            return nullptr == expected.get() && 0 == expected.use_count();
+        }
+        const shared_ptr<T>& cur = holder->value_;
+        return cur.get() == expected.get() && !cur.owner_before(expected) && !expected.owner_before(cur);
+    }
+
+    //外部计数加1，返回当前holder
+    Holder* acquire() const noexcept {
+        return holder_of(word_.fetch_add(kCountOne, std::memory_order_acquire));
+    }
+
+    //归还acquire得到的外部计数
+    void release(Holder* holder) const noexcept {
+        std::uint64_t cur = word_.load(std::memory_order_relaxed);
+        while (holder_of(cur) == holder) {
+            if (word_.compare_exchange_weak(cur, cur - kCountOne, std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+        if (nullptr != holder && 1 == holder->refs_.fetch_sub(1, std::memory_order_acq_rel)) {
+            delete holder;
+        }
+    }
+
+    //旧holder被换下：把尚未归还的外部计数转入内部计数，own为调用者自己持有的份数
+    static shared_ptr<T> retire(std::uint64_t old, long own) noexcept {
+        Holder* holder = holder_of(old);
+        if (nullptr == holder) {
+            return shared_ptr<T>();
+        }
+        shared_ptr<T> result = holder->value_;
+        long outstanding = static_cast<long>(old >> kCountShift) - own;
+        if (-outstanding == holder->refs_.fetch_add(outstanding, std::memory_order_acq_rel)) {
+            delete holder;
+        }
+        return result;
+    }
+
+    mutable std::atomic<std::uint64_t> word_;
+};
+
+//intrusive_ptr的实现
+//引用计数放在对象内部，通过ADL找到的intrusive_ptr_add_ref(T*)/intrusive_ptr_release(T*)增减，
+//可以由用户自己提供，也可以继承intrusive_ref_counter得到
+template<typename Derived, bool Atomic = true, typename Deleter = default_delete<Derived>>
+class intrusive_ref_counter {
+public:
+    long use_count() const noexcept {
+        if constexpr (Atomic) {
+            return refs_.load(std::memory_order_relaxed);
+        } else {
+            return refs_;
+        }
+    }
+
+protected:
+    constexpr intrusive_ref_counter() noexcept : refs_(0) {}
+
+    //拷贝对象时不拷贝计数
+    intrusive_ref_counter(const intrusive_ref_counter&) noexcept : refs_(0) {}
+
+    intrusive_ref_counter& operator=(const intrusive_ref_counter&) noexcept {
+        return *this;
+    }
+
+    ~intrusive_ref_counter() = default;
+
+private:
+    friend void intrusive_ptr_add_ref(const intrusive_ref_counter* p) noexcept {
+        if constexpr (Atomic) {
+            p->refs_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            ++p->refs_;
+        }
+    }
+
+    friend void intrusive_ptr_release(const intrusive_ref_counter* p) noexcept {
+        if constexpr (Atomic) {
+            if (1 == p->refs_.fetch_sub(1, std::memory_order_acq_rel)) {
+                Deleter()(static_cast<Derived*>(const_cast<intrusive_ref_counter*>(p)));
+            }
+        } else {
+            if (0 == --p->refs_) {
+                Deleter()(static_cast<Derived*>(const_cast<intrusive_ref_counter*>(p)));
+            }
+        }
+    }
+
+    mutable std::conditional_t<Atomic, std::atomic<long>, long> refs_;
+};
+
+//只在单线程中共享的对象使用，计数为普通整数
+template<typename Derived, typename Deleter = default_delete<Derived>>
+using local_intrusive_ref_counter = intrusive_ref_counter<Derived, false, Deleter>;
+
+template<typename T>
+class intrusive_ptr {
+public:
+    using element_type = T;
+
+    constexpr intrusive_ptr() noexcept : ptr_(nullptr) {}
+
+    constexpr intrusive_ptr(std::nullptr_t) noexcept : ptr_(nullptr) {}
+
+    // add_ref为false时接管调用者已经持有的一份引用
+    intrusive_ptr(T* p, bool add_ref = true) : ptr_(p) {
+        if (nullptr != ptr_ && add_ref) {
+            intrusive_ptr_add_ref(ptr_);
+        }
+    }
+
+    intrusive_ptr(const intrusive_ptr& r) : ptr_(r.ptr_) {
+        if (nullptr != ptr_) {
+            intrusive_ptr_add_ref(ptr_);
+        }
+    }
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    intrusive_ptr(const intrusive_ptr<U>& r) : ptr_(r.get()) {
+        if (nullptr != ptr_) {
+            intrusive_ptr_add_ref(ptr_);
+        }
+    }
+
+    intrusive_ptr(intrusive_ptr&& r) noexcept : ptr_(r.ptr_) {
+        r.ptr_ = nullptr;
+    }
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    intrusive_ptr(intrusive_ptr<U>&& r) noexcept : ptr_(r.detach()) {}
+
+    //接管unique_ptr持有的对象，不重新分配；对象的释放方式必须与unique_ptr的删除器一致
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    intrusive_ptr(unique_ptr<U, default_delete<U>>&& u) : ptr_(u.release()) {
+        if (nullptr != ptr_) {
+            intrusive_ptr_add_ref(ptr_);
+        }
+    }
+
+    ~intrusive_ptr() {
+        if (nullptr != ptr_) {
+            intrusive_ptr_release(ptr_);
+        }
+    }
+
+    intrusive_ptr& operator=(const intrusive_ptr& r) {
+        intrusive_ptr(r).swap(*this);
+        return *this;
+    }
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    intrusive_ptr& operator=(const intrusive_ptr<U>& r) {
+        intrusive_ptr(r).swap(*this);
+        return *this;
+    }
+
+    intrusive_ptr& operator=(intrusive_ptr&& r) noexcept {
+        intrusive_ptr(std::move(r)).swap(*this);
+        return *this;
+    }
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    intrusive_ptr& operator=(intrusive_ptr<U>&& r) noexcept {
+        intrusive_ptr(std::move(r)).swap(*this);
+        return *this;
+    }
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    intrusive_ptr& operator=(unique_ptr<U, default_delete<U>>&& u) {
+        intrusive_ptr(std::move(u)).swap(*this);
+        return *this;
+    }
+
+    intrusive_ptr& operator=(T* p) {
+        intrusive_ptr(p).swap(*this);
+        return *this;
+    }
+
+    void reset() noexcept {
+        intrusive_ptr().swap(*this);
+    }
+
+    void reset(T* p, bool add_ref = true) {
+        intrusive_ptr(p, add_ref).swap(*this);
+    }
+
+    //放弃所有权但不减少计数，调用者负责之后调用intrusive_ptr_release
+    T* detach() noexcept {
+        T* p = ptr_;
+        ptr_ = nullptr;
+        return p;
+    }
+
+    T* get() const noexcept {
+        return ptr_;
+    }
+
+    T& operator*() const noexcept {
+        return *ptr_;
+    }
+
+    T* operator->() const noexcept {
+        return ptr_;
+    }
+
+    explicit operator bool() const noexcept {
+        return nullptr != ptr_;
+    }
+
+    void swap(intrusive_ptr& r) noexcept {
+        T* tmp = ptr_;
+        ptr_ = r.ptr_;
+        r.ptr_ = tmp;
+    }
+
+private:
+    T* ptr_;
+};
+
+//intrusive相关的非成员函数
+template<typename T, typename... Args, typename = std::enable_if_t<!std::is_array<T>::value>>
+intrusive_ptr<T> make_intrusive(Args&&... args) {
+    return intrusive_ptr<T>(new T(std::forward<Args>(args)...));
+}
+
+template<typename T, typename U>
+bool operator==(const intrusive_ptr<T>& a, const intrusive_ptr<U>& b) noexcept {
+    return a.get() == b.get();
+}
+
+template<typename T, typename U>
+bool operator!=(const intrusive_ptr<T>& a, const intrusive_ptr<U>& b) noexcept {
+    return a.get() != b.get();
+}
+
+template<typename T>
+bool operator==(const intrusive_ptr<T>& a, std::nullptr_t) noexcept {
+    return nullptr == a.get();
+}
+
+template<typename T>
+bool operator!=(const intrusive_ptr<T>& a, std::nullptr_t) noexcept {
+    return nullptr != a.get();
+}
+
+template<typename T, typename U>
+intrusive_ptr<T> static_pointer_cast(const intrusive_ptr<U>& r) {
+    return intrusive_ptr<T>(static_cast<T*>(r.get()));
+}
+
+template<typename T, typename U>
+intrusive_ptr<T> const_pointer_cast(const intrusive_ptr<U>& r) {
+    return intrusive_ptr<T>(const_cast<T*>(r.get()));
+}
+
+template<typename T, typename U>
+intrusive_ptr<T> dynamic_pointer_cast(const intrusive_ptr<U>& r) {
+    return intrusive_ptr<T>(dynamic_cast<T*>(r.get()));
+}
+
 }   //ycstl
 
 
@@ -0,0 +1,544 @@
+/**
+ * 实现多态内存资源
+ * memory_resource
+ * new_delete_resource / null_memory_resource / get_default_resource / set_default_resource
+ * monotonic_buffer_resource
+ * pool_options
+ * unsynchronized_pool_resource / synchronized_pool_resource
+ * polymorphic_allocator
+ *
+ * 容器的分配器类型固定为polymorphic_allocator<T>，实际从哪里分配由运行时传入的memory_resource决定；
+ * polymorphic_allocator在容器拷贝、移动、交换时都不传播，元素通过uses-allocator构造拿到同一个资源
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef MEMORY_RESOURCE_HPP_
+#define MEMORY_RESOURCE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ycstl {
+
+class memory_resource {
+public:
+    virtual ~memory_resource() = default;
+
+    void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+        return do_allocate(bytes, align);
+    }
+
+    void deallocate(void* p, std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+        do_deallocate(p, bytes, align);
+    }
+
+    //一个资源分配的内存能否由另一个资源释放
+    bool is_equal(const memory_resource& other) const noexcept {
+        return do_is_equal(other);
+    }
+
+private:
+    virtual void* do_allocate(std::size_t bytes, std::size_t align) = 0;
+    virtual void do_deallocate(void* p, std::size_t bytes, std::size_t align) = 0;
+    virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource& a, const memory_resource& b) noexcept {
+    return &a == &b || a.is_equal(b);
+}
+
+inline bool operator!=(const memory_resource& a, const memory_resource& b) noexcept {
+    return !(a == b);
+}
+
+//直接使用全局operator new/delete
+class NewDeleteResource : public memory_resource {
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(bytes, std::align_val_t(align));
+        }
+        return ::operator new(bytes);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(p, bytes, std::align_val_t(align));
+        } else {
+            ::operator delete(p, bytes);
+        }
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+//任何分配都抛出bad_alloc，用于检查代码是否只使用了预先提供的缓冲区
+class NullMemoryResource : public memory_resource {
+private:
+    void* do_allocate(std::size_t, std::size_t) override {
+        throw std::bad_alloc();
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+inline memory_resource* new_delete_resource() noexcept {
+    static NewDeleteResource resource;
+    return &resource;
+}
+
+inline memory_resource* null_memory_resource() noexcept {
+    static NullMemoryResource resource;
+    return &resource;
+}
+
+inline std::atomic<memory_resource*>& default_resource_holder() noexcept {
+    static std::atomic<memory_resource*> holder(new_delete_resource());
+    return holder;
+}
+
+inline memory_resource* get_default_resource() noexcept {
+    return default_resource_holder().load(std::memory_order_acquire);
+}
+
+//传入nullptr时恢复为new_delete_resource，返回之前的默认资源
+inline memory_resource* set_default_resource(memory_resource* r) noexcept {
+    if (nullptr == r) {
+        r = new_delete_resource();
+    }
+    return default_resource_holder().exchange(r, std::memory_order_acq_rel);
+}
+
+//释放操作为空，所有内存在release()或析构时一次归还上游；先用完构造时给定的缓冲区
+class monotonic_buffer_resource : public memory_resource {
+    struct Chunk {
+        Chunk* next_;
+        std::size_t bytes_;
+        std::size_t align_;
+    };
+
+public:
+    static constexpr std::size_t kDefaultChunkSize = 1024;
+
+    explicit monotonic_buffer_resource(memory_resource* upstream = get_default_resource()) noexcept
+        : monotonic_buffer_resource(kDefaultChunkSize, upstream) {}
+
+    explicit monotonic_buffer_resource(std::size_t initial_size, memory_resource* upstream = get_default_resource()) noexcept
+        : upstream_(upstream), chunks_(nullptr), initial_buffer_(nullptr), initial_size_(0),
+          cur_(nullptr), end_(nullptr), next_size_(initial_size < kMinChunkSize ? kMinChunkSize : initial_size) {}
+
+    monotonic_buffer_resource(void* buffer, std::size_t size, memory_resource* upstream = get_default_resource()) noexcept
+        : upstream_(upstream), chunks_(nullptr), initial_buffer_(static_cast<char*>(buffer)), initial_size_(size),
+          cur_(static_cast<char*>(buffer)), end_(static_cast<char*>(buffer) + size),
+          next_size_(size < kMinChunkSize ? kMinChunkSize : size * 2) {}
+
+    ~monotonic_buffer_resource() override {
+        release();
+    }
+
+    monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+    monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+    //归还所有从上游申请的内存，重新从初始缓冲区开始分配
+    void release() noexcept {
+        while (nullptr != chunks_) {
+            Chunk* next = chunks_->next_;
+            upstream_->deallocate(chunks_, chunks_->bytes_, chunks_->align_);
+            chunks_ = next;
+        }
+        cur_ = initial_buffer_;
+        end_ = initial_buffer_ + initial_size_;
+    }
+
+    memory_resource* upstream_resource() const noexcept {
+        return upstream_;
+    }
+
+private:
+    static constexpr std::size_t kMinChunkSize = 64;
+
+    static std::size_t align_padding(char* p, std::size_t align) noexcept {
+        std::uintptr_t v = reinterpret_cast<std::uintptr_t>(p);
+        return static_cast<std::size_t>(((v + align - 1) & ~(std::uintptr_t(align) - 1)) - v);
+    }
+
+    //补齐量可能超过剩余空间，先比较它再比较bytes
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        std::size_t padding = align_padding(cur_, align);
+        std::size_t available = static_cast<std::size_t>(end_ - cur_);
+        if (nullptr == cur_ || padding > available || bytes > available - padding) {
+            grow(bytes, align);
+            padding = align_padding(cur_, align);
+        }
+        char* p = cur_ + padding;
+        cur_ = p + bytes;
+        return p;
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    //块头放在块的开头，块大小按2倍增长
+    void grow(std::size_t bytes, std::size_t align) {
+        std::size_t chunk_align = align > alignof(Chunk) ? align : alignof(Chunk);
+        std::size_t header = (sizeof(Chunk) + chunk_align - 1) & ~(chunk_align - 1);
+        std::size_t size = next_size_;
+        while (size < header + bytes) {
+            size *= 2;
+        }
+        Chunk* chunk = static_cast<Chunk*>(upstream_->allocate(size, chunk_align));
+        chunk->next_ = chunks_;
+        chunk->bytes_ = size;
+        chunk->align_ = chunk_align;
+        chunks_ = chunk;
+        cur_ = reinterpret_cast<char*>(chunk) + header;
+        end_ = reinterpret_cast<char*>(chunk) + size;
+        next_size_ = size * 2;
+    }
+
+    memory_resource* upstream_;
+    Chunk* chunks_;
+    char* initial_buffer_;
+    std::size_t initial_size_;
+    char* cur_;
+    char* end_;
+    std::size_t next_size_;
+};
+
+struct pool_options {
+    std::size_t max_blocks_per_chunk = 0;           //0表示使用默认值
+    std::size_t largest_required_pool_block = 0;    //超过的分配直接交给上游
+};
+
+//按2的幂分成若干档，每档一条空闲链表；不加锁
+class unsynchronized_pool_resource : public memory_resource {
+    //块链表，链表节点放在每块的末尾
+    struct Chunk {
+        Chunk* next_;
+        std::size_t bytes_;
+        std::size_t align_;
+    };
+
+    struct FreeBlock {
+        FreeBlock* next_;
+    };
+
+    struct Pool {
+        FreeBlock* free_ = nullptr;
+        Chunk* chunks_ = nullptr;
+        std::size_t next_blocks_ = kInitialBlocks;
+    };
+
+    //超过最大档的分配前面带一个头，串成双向链表，release()时全部归还
+    struct LargeHeader {
+        LargeHeader* pre_;
+        LargeHeader* next_;
+    };
+
+public:
+    static constexpr std::size_t kMinBlockSize = 8;
+    static constexpr std::size_t kMaxPools = 20;
+
+    unsynchronized_pool_resource() noexcept
+        : unsynchronized_pool_resource(pool_options(), get_default_resource()) {}
+
+    explicit unsynchronized_pool_resource(memory_resource* upstream) noexcept
+        : unsynchronized_pool_resource(pool_options(), upstream) {}
+
+    explicit unsynchronized_pool_resource(const pool_options& opts, memory_resource* upstream = get_default_resource()) noexcept
+        : upstream_(upstream), large_(nullptr) {
+        options_.max_blocks_per_chunk = 0 == opts.max_blocks_per_chunk ? kDefaultMaxBlocks : opts.max_blocks_per_chunk;
+        std::size_t largest = 0 == opts.largest_required_pool_block ? kDefaultLargestBlock : opts.largest_required_pool_block;
+        pool_count_ = 1;
+        while (pool_count_ < kMaxPools && block_size(pool_count_ - 1) < largest) {
+            ++pool_count_;
+        }
+        options_.largest_required_pool_block = block_size(pool_count_ - 1);
+    }
+
+    ~unsynchronized_pool_resource() override {
+        release();
+    }
+
+    unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+    unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+    //把所有内存还给上游，之前分配出去的块全部失效
+    void release() noexcept {
+        for (std::size_t i = 0; i != pool_count_; ++i) {
+            Pool& pool = pools_[i];
+            Chunk* chunk = pool.chunks_;
+            while (nullptr != chunk) {
+                Chunk* next = chunk->next_;
+                upstream_->deallocate(chunk_base(chunk), chunk->bytes_, chunk->align_);
+                chunk = next;
+            }
+            pool = Pool();
+        }
+        while (nullptr != large_) {
+            LargeHeader* next = large_->next_;
+            free_large(large_);
+            large_ = next;
+        }
+    }
+
+    memory_resource* upstream_resource() const noexcept {
+        return upstream_;
+    }
+
+    pool_options options() const noexcept {
+        return options_;
+    }
+
+private:
+    static constexpr std::size_t kInitialBlocks = 16;
+    static constexpr std::size_t kDefaultMaxBlocks = 1024;
+    static constexpr std::size_t kDefaultLargestBlock = 4096;
+
+    static constexpr std::size_t block_size(std::size_t index) noexcept {
+        return kMinBlockSize << index;
+    }
+
+    //大于等于max(bytes, align)的最小档
+    std::size_t pool_index(std::size_t bytes, std::size_t align) const noexcept {
+        std::size_t need = bytes > align ? bytes : align;
+        std::size_t index = 0;
+        while (index != pool_count_ && block_size(index) < need) {
+            ++index;
+        }
+        return index;
+    }
+
+    static void* chunk_base(Chunk* chunk) noexcept {
+        return reinterpret_cast<char*>(chunk) + sizeof(Chunk) - chunk->bytes_;
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        std::size_t index = pool_index(bytes, align);
+        if (index == pool_count_) {
+            return allocate_large(bytes, align);
+        }
+        Pool& pool = pools_[index];
+        if (nullptr == pool.free_) {
+            refill(pool, block_size(index));
+        }
+        FreeBlock* block = pool.free_;
+        pool.free_ = block->next_;
+        return block;
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        std::size_t index = pool_index(bytes, align);
+        if (index == pool_count_) {
+            LargeHeader* header = reinterpret_cast<LargeHeader*>(static_cast<char*>(p) - large_header_size(align));
+            if (nullptr != header->pre_) {
+                header->pre_->next_ = header->next_;
+            } else {
+                large_ = header->next_;
+            }
+            if (nullptr != header->next_) {
+                header->next_->pre_ = header->pre_;
+            }
+            free_large(header);
+            return;
+        }
+        Pool& pool = pools_[index];
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next_ = pool.free_;
+        pool.free_ = block;
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    //从上游申请一块，块大小对齐到块的边界，每次的块数翻倍直到max_blocks_per_chunk
+    void refill(Pool& pool, std::size_t size) {
+        std::size_t blocks = pool.next_blocks_;
+        std::size_t bytes = blocks * size + sizeof(Chunk);
+        std::size_t align = size > alignof(Chunk) ? size : alignof(Chunk);
+        char* base = static_cast<char*>(upstream_->allocate(bytes, align));
+        Chunk* chunk = reinterpret_cast<Chunk*>(base + blocks * size);
+        chunk->next_ = pool.chunks_;
+        chunk->bytes_ = bytes;
+        chunk->align_ = align;
+        pool.chunks_ = chunk;
+        for (std::size_t i = blocks; i != 0; --i) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(base + (i - 1) * size);
+            block->next_ = pool.free_;
+            pool.free_ = block;
+        }
+        if (pool.next_blocks_ < options_.max_blocks_per_chunk) {
+            pool.next_blocks_ = pool.next_blocks_ * 2 < options_.max_blocks_per_chunk
+                                    ? pool.next_blocks_ * 2 : options_.max_blocks_per_chunk;
+        }
+    }
+
+    static std::size_t large_header_size(std::size_t align) noexcept {
+        std::size_t a = align > alignof(LargeHeader) ? align : alignof(LargeHeader);
+        return (sizeof(LargeHeader) + a - 1) & ~(a - 1);
+    }
+
+    //头部之前再记下本次的大小和对齐，release()时用来归还
+    struct LargeInfo {
+        std::size_t bytes_;
+        std::size_t align_;
+    };
+
+    void* allocate_large(std::size_t bytes, std::size_t align) {
+        std::size_t a = align > alignof(LargeHeader) ? align : alignof(LargeHeader);
+        std::size_t prefix = large_header_size(align);
+        std::size_t info = (sizeof(LargeInfo) + a - 1) & ~(a - 1);
+        char* base = static_cast<char*>(upstream_->allocate(info + prefix + bytes, a));
+        LargeInfo* large_info = reinterpret_cast<LargeInfo*>(base + info - sizeof(LargeInfo));
+        large_info->bytes_ = info + prefix + bytes;
+        large_info->align_ = a;
+        LargeHeader* header = reinterpret_cast<LargeHeader*>(base + info);
+        header->pre_ = nullptr;
+        header->next_ = large_;
+        if (nullptr != large_) {
+            large_->pre_ = header;
+        }
+        large_ = header;
+        return base + info + prefix;
+    }
+
+    void free_large(LargeHeader* header) noexcept {
+        LargeInfo* large_info = reinterpret_cast<LargeInfo*>(header) - 1;
+        std::size_t info = (sizeof(LargeInfo) + large_info->align_ - 1) & ~(large_info->align_ - 1);
+        upstream_->deallocate(reinterpret_cast<char*>(header) - info, large_info->bytes_, large_info->align_);
+    }
+
+    memory_resource* upstream_;
+    pool_options options_;
+    std::size_t pool_count_;
+    Pool pools_[kMaxPools];
+    LargeHeader* large_;
+};
+
+//unsynchronized_pool_resource加一把锁，可以在多个线程间共享
+class synchronized_pool_resource : public memory_resource {
+public:
+    synchronized_pool_resource() noexcept : pool_() {}
+
+    explicit synchronized_pool_resource(memory_resource* upstream) noexcept : pool_(upstream) {}
+
+    explicit synchronized_pool_resource(const pool_options& opts, memory_resource* upstream = get_default_resource()) noexcept
+        : pool_(opts, upstream) {}
+
+    synchronized_pool_resource(const synchronized_pool_resource&) = delete;
+    synchronized_pool_resource& operator=(const synchronized_pool_resource&) = delete;
+
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pool_.release();
+    }
+
+    memory_resource* upstream_resource() const noexcept {
+        return pool_.upstream_resource();
+    }
+
+    pool_options options() const noexcept {
+        return pool_.options();
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pool_.allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pool_.deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::mutex mutex_;
+    unsynchronized_pool_resource pool_;
+};
+
+//持有一个memory_resource指针的分配器，拷贝、移动、交换容器时都不传播
+template<typename T = std::byte>
+class polymorphic_allocator {
+public:
+    using value_type = T;
+
+    polymorphic_allocator() noexcept : resource_(get_default_resource()) {}
+
+    polymorphic_allocator(memory_resource* r) noexcept : resource_(r) {}
+
+    polymorphic_allocator(const polymorphic_allocator&) = default;
+
+    template<typename U>
+    polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept : resource_(other.resource()) {}
+
+    polymorphic_allocator& operator=(const polymorphic_allocator&) = delete;
+
+    T* allocate(std::size_t n) {
+        if (n > std::size_t(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        resource_->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    //uses-allocator构造：元素如果也接受分配器，把同一个资源传下去
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        std::uninitialized_construct_using_allocator(p, *this, std::forward<Args>(args)...);
+    }
+
+    template<typename U>
+    void destroy(U* p) {
+        std::destroy_at(p);
+    }
+
+    //容器拷贝时使用默认资源，而不是被拷贝容器的资源
+    polymorphic_allocator select_on_container_copy_construction() const noexcept {
+        return polymorphic_allocator();
+    }
+
+    memory_resource* resource() const noexcept {
+        return resource_;
+    }
+
+private:
+    memory_resource* resource_;
+};
+
+template<typename T, typename U>
+bool operator==(const polymorphic_allocator<T>& a, const polymorphic_allocator<U>& b) noexcept {
+    return *a.resource() == *b.resource();
+}
+
+template<typename T, typename U>
+bool operator!=(const polymorphic_allocator<T>& a, const polymorphic_allocator<U>& b) noexcept {
+    return !(a == b);
+}
+
+}   //ycstl
+
+#endif
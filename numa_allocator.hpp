@@ -0,0 +1,403 @@
+/**
+ * 实现NUMA和大页分配策略
+ * numa_policy
+ * numa_resource
+ * numa_allocator
+ *
+ * numa_resource直接向内核映射内存，在首次访问之前用mbind把页面绑定到指定节点或在节点间交错，
+ * 并按策略申请透明大页(madvise)或显式大页(MAP_HUGETLB)；
+ * 大块分配单独映射，释放时解除映射；小块分配按2的幂分档，从同样按策略映射的2MiB区域中顺序切出，
+ * 释放后放进本档的空闲链表供下一次同档分配复用，区域本身只在资源析构时归还；
+ * 内核不支持、没有预留大页或者不是Linux时逐级退回普通页/operator new，stats()里可以看到退回的次数
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef NUMA_ALLOCATOR_HPP_
+#define NUMA_ALLOCATOR_HPP_
+
+#include "memory_resource.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ycstl {
+
+enum class numa_mode {
+    local,          //不设置，由首次访问的线程决定
+    bind,           //只在nodes中的节点上分配
+    preferred,      //优先nodes中的第一个节点，不够时用其他节点
+    interleave      //按页在nodes中的节点间轮流分配，nodes为0时使用所有节点
+};
+
+enum class huge_page_mode {
+    none,
+    transparent,    // 2MiB对齐并madvise(MADV_HUGEPAGE)
+    hugetlb         // MAP_HUGETLB，没有预留大页时退回transparent
+};
+
+struct numa_policy {
+    numa_mode mode = numa_mode::local;
+    std::uint64_t nodes = 0;                        //节点位掩码，第i位表示节点i
+    huge_page_mode huge_pages = huge_page_mode::none;
+};
+
+struct numa_stats {
+    std::size_t bytes_mapped = 0;
+    std::size_t mappings = 0;
+    std::size_t hugetlb_mappings = 0;       //成功使用显式大页的映射数
+    std::size_t bound_mappings = 0;         //成功mbind的映射数
+    std::size_t fallbacks = 0;              //某一级策略失败后退回的次数
+};
+
+//系统中的NUMA节点数，无法确定时返回1
+inline int numa_node_count() noexcept {
+#if defined(__linux__)
+    int count = 0;
+    char path[64];
+    for (int node = 0; node != 64; ++node) {
+        std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d", node);
+        if (0 == ::access(path, F_OK)) {
+            count = node + 1;
+        }
+    }
+    return 0 == count ? 1 : count;
+#else
+    return 1;
+#endif
+}
+
+inline std::uint64_t numa_all_nodes() noexcept {
+    int count = numa_node_count();
+    return count >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+}
+
+//mode对应的内核常量，与<linux/mempolicy.h>一致
+inline int numa_kernel_mode(numa_mode mode) noexcept {
+    switch (mode) {
+    case numa_mode::preferred:
+        return 1;
+    case numa_mode::bind:
+        return 2;
+    case numa_mode::interleave:
+        return 3;
+    default:
+        return 0;
+    }
+}
+
+//设置当前线程之后首次访问的页面的分配策略，失败时返回false
+inline bool set_thread_numa_policy(const numa_policy& policy) noexcept {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    std::uint64_t nodes = policy.nodes;
+    if (numa_mode::interleave == policy.mode && 0 == nodes) {
+        nodes = numa_all_nodes();
+    }
+    unsigned long mask = static_cast<unsigned long>(nodes);
+    const unsigned long* mask_ptr = numa_mode::local == policy.mode ? nullptr : &mask;
+    return 0 == ::syscall(SYS_set_mempolicy, numa_kernel_mode(policy.mode), mask_ptr,
+                          numa_mode::local == policy.mode ? 0UL : 65UL);
+#else
+    (void)policy;
+    return false;
+#endif
+}
+
+class numa_resource : public memory_resource {
+    //大块分配的头部，记录整段映射的起点和长度
+    struct MappingHeader {
+        void* base_;
+        std::size_t length_;
+    };
+
+    //小块分配使用的区域，串成链表在析构时解除映射
+    struct Region {
+        Region* next_;
+        std::size_t length_;
+    };
+
+    //释放的小块串成每档一条的空闲链表
+    struct FreeBlock {
+        FreeBlock* next_;
+    };
+
+public:
+    static constexpr std::size_t kHugePageSize = std::size_t(2) << 20;
+    static constexpr std::size_t kRegionSize = std::size_t(2) << 20;
+    static constexpr std::size_t kLargeThreshold = std::size_t(256) << 10;
+    static constexpr std::size_t kMinBlockSize = 16;
+    static constexpr std::size_t kMaxBlockAlign = 4096;     //块按min(档大小, kMaxBlockAlign)对齐
+    static constexpr int kClasses = 15;                      // 16B到256KiB
+
+    explicit numa_resource(const numa_policy& policy = numa_policy()) noexcept
+        : policy_(policy), regions_(nullptr), cur_(nullptr), end_(nullptr), free_{} {
+        if (numa_mode::interleave == policy_.mode && 0 == policy_.nodes) {
+            policy_.nodes = numa_all_nodes();
+        }
+    }
+
+    ~numa_resource() override {
+        while (nullptr != regions_) {
+            Region* next = regions_->next_;
+            unmap(regions_, regions_->length_);
+            regions_ = next;
+        }
+    }
+
+    numa_resource(const numa_resource&) = delete;
+    numa_resource& operator=(const numa_resource&) = delete;
+
+    const numa_policy& policy() const noexcept {
+        return policy_;
+    }
+
+    numa_stats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+private:
+    static std::size_t round_up(std::size_t n, std::size_t align) noexcept {
+        return (n + align - 1) & ~(align - 1);
+    }
+
+    static std::size_t align_padding(char* p, std::size_t align) noexcept {
+        std::uintptr_t v = reinterpret_cast<std::uintptr_t>(p);
+        return round_up(v, align) - v;
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (bytes >= kLargeThreshold) {
+            std::size_t header = round_up(sizeof(MappingHeader), align > alignof(MappingHeader) ? align : alignof(MappingHeader));
+            std::size_t length = 0;
+            char* base = static_cast<char*>(map(header + bytes, length));
+            MappingHeader* h = reinterpret_cast<MappingHeader*>(base + header - sizeof(MappingHeader));
+            h->base_ = base;
+            h->length_ = length;
+            return base + header;
+        }
+        int index = size_class(bytes, align);
+        if (index < 0) {
+            return carve(bytes, align);
+        }
+        if (nullptr != free_[index]) {
+            FreeBlock* block = free_[index];
+            free_[index] = block->next_;
+            return block;
+        }
+        std::size_t size = kMinBlockSize << index;
+        return carve(size, size < kMaxBlockAlign ? size : kMaxBlockAlign);
+    }
+
+    //放回本档的空闲链表；对齐超过kMaxBlockAlign的小块不分档，留到析构时随区域归还
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        if (bytes < kLargeThreshold) {
+            int index = size_class(bytes, align);
+            if (index >= 0) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                FreeBlock* block = static_cast<FreeBlock*>(p);
+                block->next_ = free_[index];
+                free_[index] = block;
+            }
+            return;
+        }
+        MappingHeader* h = reinterpret_cast<MappingHeader*>(p) - 1;
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.bytes_mapped -= h->length_;
+        --stats_.mappings;
+        unmap(h->base_, h->length_);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    //小块所在的档，size = max(bytes, align, kMinBlockSize)向上取2的幂；对齐超过kMaxBlockAlign时返回-1
+    static int size_class(std::size_t bytes, std::size_t align) noexcept {
+        if (align > kMaxBlockAlign) {
+            return -1;
+        }
+        std::size_t size = bytes > align ? bytes : align;
+        size = size > kMinBlockSize ? size : kMinBlockSize;
+        return std::countr_zero(std::bit_ceil(size)) - std::countr_zero(kMinBlockSize);
+    }
+
+    //从当前区域顺序切出一块，放不下时映射新的区域；调用者持有mutex_
+    void* carve(std::size_t bytes, std::size_t align) {
+        //补齐量可能超过区域剩余的空间，先比较它再比较bytes
+        std::size_t padding = align_padding(cur_, align);
+        std::size_t available = static_cast<std::size_t>(end_ - cur_);
+        if (nullptr == cur_ || padding > available || bytes > available - padding) {
+            std::size_t length = 0;
+            std::size_t size = sizeof(Region) + align + bytes;
+            Region* region = static_cast<Region*>(map(size > kRegionSize ? size : kRegionSize, length));
+            region->next_ = regions_;
+            region->length_ = length;
+            regions_ = region;
+            cur_ = reinterpret_cast<char*>(region) + sizeof(Region);
+            end_ = reinterpret_cast<char*>(region) + length;
+            padding = align_padding(cur_, align);
+        }
+        char* p = cur_ + padding;
+        cur_ = p + bytes;
+        return p;
+    }
+
+#if defined(__linux__)
+    //依次尝试显式大页、透明大页、普通页；调用者持有mutex_
+    void* map(std::size_t bytes, std::size_t& length) {
+        void* p = MAP_FAILED;
+        if (huge_page_mode::hugetlb == policy_.huge_pages) {
+#if defined(MAP_HUGETLB)
+            length = round_up(bytes, kHugePageSize);
+            p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+            if (MAP_FAILED == p) {
+                ++stats_.fallbacks;
+            } else {
+                ++stats_.hugetlb_mappings;
+            }
+        }
+        if (MAP_FAILED == p && huge_page_mode::none != policy_.huge_pages) {
+            p = map_transparent(bytes, length);
+        }
+        if (MAP_FAILED == p) {
+            length = round_up(bytes, static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)));
+            p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (MAP_FAILED == p) {
+                throw std::bad_alloc();
+            }
+        }
+        bind(p, length);
+        stats_.bytes_mapped += length;
+        ++stats_.mappings;
+        return p;
+    }
+
+    //多映射一个大页再裁掉两端，得到2MiB对齐的区间
+    void* map_transparent(std::size_t bytes, std::size_t& length) {
+        length = round_up(bytes, kHugePageSize);
+        char* raw = static_cast<char*>(::mmap(nullptr, length + kHugePageSize, PROT_READ | PROT_WRITE,
+                                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (MAP_FAILED == static_cast<void*>(raw)) {
+            return MAP_FAILED;
+        }
+        char* aligned = raw + (round_up(reinterpret_cast<std::uintptr_t>(raw), kHugePageSize) - reinterpret_cast<std::uintptr_t>(raw));
+        if (aligned != raw) {
+            ::munmap(raw, aligned - raw);
+        }
+        std::size_t tail = (raw + length + kHugePageSize) - (aligned + length);
+        if (0 != tail) {
+            ::munmap(aligned + length, tail);
+        }
+#if defined(MADV_HUGEPAGE)
+        if (0 != ::madvise(aligned, length, MADV_HUGEPAGE)) {
+            ++stats_.fallbacks;
+        }
+#endif
+        return aligned;
+    }
+
+    //页面尚未被访问，mbind之后首次访问时才按策略分配物理页
+    void bind(void* p, std::size_t length) {
+        if (numa_mode::local == policy_.mode) {
+            return;
+        }
+#if defined(SYS_mbind)
+        unsigned long mask = static_cast<unsigned long>(policy_.nodes);
+        if (0 == ::syscall(SYS_mbind, p, length, numa_kernel_mode(policy_.mode), &mask, 65UL, 0U)) {
+            ++stats_.bound_mappings;
+            return;
+        }
+#endif
+        ++stats_.fallbacks;
+    }
+
+    static void unmap(void* p, std::size_t length) noexcept {
+        ::munmap(p, length);
+    }
+#else
+    void* map(std::size_t bytes, std::size_t& length) {
+        length = round_up(bytes, 4096);
+        void* p = ::operator new(length, std::align_val_t(4096));
+        if (numa_mode::local != policy_.mode || huge_page_mode::none != policy_.huge_pages) {
+            ++stats_.fallbacks;
+        }
+        stats_.bytes_mapped += length;
+        ++stats_.mappings;
+        return p;
+    }
+
+    static void unmap(void* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t(4096));
+    }
+#endif
+
+    numa_policy policy_;
+    mutable std::mutex mutex_;
+    numa_stats stats_;
+    Region* regions_;
+    char* cur_;
+    char* end_;
+    FreeBlock* free_[kClasses];
+};
+
+//持有numa_resource指针的分配器；与polymorphic_allocator不同，容器拷贝、移动、交换时分配策略随之传播
+template<typename T>
+class numa_allocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    numa_allocator(numa_resource* resource) noexcept : resource_(resource) {}
+
+    template<typename U>
+    numa_allocator(const numa_allocator<U>& other) noexcept : resource_(other.resource()) {}
+
+    T* allocate(std::size_t n) {
+        if (n > std::size_t(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        resource_->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    numa_resource* resource() const noexcept {
+        return resource_;
+    }
+
+private:
+    numa_resource* resource_;
+};
+
+template<typename T, typename U>
+bool operator==(const numa_allocator<T>& a, const numa_allocator<U>& b) noexcept {
+    return a.resource() == b.resource();
+}
+
+template<typename T, typename U>
+bool operator!=(const numa_allocator<T>& a, const numa_allocator<U>& b) noexcept {
+    return !(a == b);
+}
+
+}   //ycstl
+
+#endif
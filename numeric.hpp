@@ -0,0 +1,424 @@
+/**
+ * 实现numeric
+ * vector_expression / expr
+ * + - * / += -= *= /= 一元- 逐元素比较 abs sqrt where
+ * sum dot min_value max_value all any count
+ *
+ * 包含这个头文件后，元素为算术类型的vector/array可以直接写 a = b * c + d：
+ * 运算符只构造表达式节点，赋值给vector/array时在一个循环里逐元素求值，不分配中间结果；
+ * 比较运算符要求至少一边已经是表达式，避免和array原有的整体比较冲突，用expr(a) < b；
+ * 表达式只保存容器的指针，不要在容器析构后再求值；
+ * 所有操作数长度必须相同，构造表达式或赋值给array时长度不同抛出std::length_error
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef NUMERIC_HPP_
+#define NUMERIC_HPP_
+
+#include "array.hpp"
+#include "vector.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+//逐元素求值的循环每次迭代只读写同一下标，告诉编译器没有循环间依赖，省掉别名检查
+#if defined(__clang__)
+#define YCSTL_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define YCSTL_IVDEP _Pragma("GCC ivdep")
+#else
+#define YCSTL_IVDEP
+#endif
+
+namespace ycstl {
+
+//所有表达式节点的CRTP基类，vector/array通过它识别表达式
+template<typename E>
+struct vector_expression {
+    constexpr const E& self() const noexcept {
+        return static_cast<const E&>(*this);
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return self().size();
+    }
+
+    constexpr decltype(auto) operator[](std::size_t i) const {
+        return self()[i];
+    }
+
+    template<typename T>
+    constexpr void assign_to(T* dst) const {
+        const E& e = self();
+        std::size_t n = e.size();
+        YCSTL_IVDEP
+        for (std::size_t i = 0; i < n; ++i) {
+            dst[i] = e[i];
+        }
+    }
+};
+
+template<typename T>
+inline constexpr bool is_vector_expression_v = std::is_base_of_v<vector_expression<T>, T>;
+
+//叶子：容器的一段连续内存
+template<typename T>
+class ExprRef : public vector_expression<ExprRef<T>> {
+public:
+    using value_type = T;
+
+    constexpr ExprRef(const T* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    constexpr std::size_t size() const noexcept {
+        return size_;
+    }
+
+    constexpr T operator[](std::size_t i) const noexcept {
+        return data_[i];
+    }
+
+private:
+    const T* data_;
+    std::size_t size_;
+};
+
+//叶子：标量，广播到任意长度
+template<typename T>
+class ExprScalar : public vector_expression<ExprScalar<T>> {
+public:
+    using value_type = T;
+
+    constexpr explicit ExprScalar(T value) noexcept : value_(value) {}
+
+    constexpr T operator[](std::size_t) const noexcept {
+        return value_;
+    }
+
+private:
+    T value_;
+};
+
+template<typename T>
+struct ExprIsScalar : std::false_type {};
+
+template<typename T>
+struct ExprIsScalar<ExprScalar<T>> : std::true_type {};
+
+//构造表达式时检查长度，标量没有长度，和任何长度都匹配
+template<typename A, typename B>
+constexpr void expr_check_size(const A& a, const B& b) {
+    if constexpr (!ExprIsScalar<A>::value && !ExprIsScalar<B>::value) {
+        if (a.size() != b.size()) {
+            throw std::length_error("expression operands differ in length");
+        }
+    }
+}
+
+template<typename Op, typename L, typename R>
+class ExprBinary : public vector_expression<ExprBinary<Op, L, R>> {
+public:
+    using value_type = decltype(Op()(std::declval<typename L::value_type>(), std::declval<typename R::value_type>()));
+
+    constexpr ExprBinary(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+        expr_check_size(lhs_, rhs_);
+    }
+
+    //标量没有长度，取另一边的
+    constexpr std::size_t size() const noexcept {
+        if constexpr (ExprIsScalar<L>::value) {
+            return rhs_.size();
+        } else {
+            return lhs_.size();
+        }
+    }
+
+    constexpr value_type operator[](std::size_t i) const {
+        return Op()(lhs_[i], rhs_[i]);
+    }
+
+private:
+    L lhs_;
+    R rhs_;
+};
+
+template<typename Op, typename E>
+class ExprUnary : public vector_expression<ExprUnary<Op, E>> {
+public:
+    using value_type = decltype(Op()(std::declval<typename E::value_type>()));
+
+    constexpr explicit ExprUnary(const E& e) noexcept : e_(e) {}
+
+    constexpr std::size_t size() const noexcept {
+        return e_.size();
+    }
+
+    constexpr value_type operator[](std::size_t i) const {
+        return Op()(e_[i]);
+    }
+
+private:
+    E e_;
+};
+
+//where(cond, x, y)：cond[i]为真取x[i]，否则取y[i]
+template<typename C, typename X, typename Y>
+class ExprSelect : public vector_expression<ExprSelect<C, X, Y>> {
+public:
+    using value_type = std::common_type_t<typename X::value_type, typename Y::value_type>;
+
+    constexpr ExprSelect(const C& cond, const X& x, const Y& y) : cond_(cond), x_(x), y_(y) {
+        expr_check_size(cond_, x_);
+        expr_check_size(cond_, y_);
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return cond_.size();
+    }
+
+    //两边都算出来再选，编译器可以生成无分支的混合指令
+    constexpr value_type operator[](std::size_t i) const {
+        value_type a = x_[i];
+        value_type b = y_[i];
+        return cond_[i] ? a : b;
+    }
+
+private:
+    C cond_;
+    X x_;
+    Y y_;
+};
+
+struct ExprAbs {
+    template<typename T>
+    constexpr T operator()(T x) const noexcept {
+        return x < T(0) ? -x : x;
+    }
+};
+
+struct ExprSqrt {
+    template<typename T>
+    auto operator()(T x) const noexcept {
+        return std::sqrt(x);
+    }
+};
+
+template<typename T>
+struct ExprIsContainer : std::false_type {};
+
+template<typename T, typename Allocator>
+struct ExprIsContainer<vector<T, Allocator>> : std::is_arithmetic<T> {};
+
+template<typename T, std::size_t N>
+struct ExprIsContainer<array<T, N>> : std::is_arithmetic<T> {};
+
+template<typename T>
+inline constexpr bool kExprIsContainer = ExprIsContainer<std::decay_t<T>>::value;
+
+template<typename T>
+inline constexpr bool kExprIsExpression = is_vector_expression_v<std::decay_t<T>>;
+
+template<typename T>
+inline constexpr bool kExprIsOperand = kExprIsExpression<T> || kExprIsContainer<T> || std::is_arithmetic_v<std::decay_t<T>>;
+
+//容器包成ExprRef，标量包成ExprScalar，表达式原样复制
+template<typename T>
+constexpr auto as_expression(const T& x) noexcept {
+    if constexpr (kExprIsExpression<T>) {
+        return x;
+    } else if constexpr (kExprIsContainer<T>) {
+        return ExprRef<typename T::value_type>(x.data(), x.size());
+    } else {
+        return ExprScalar<T>(x);
+    }
+}
+
+template<typename T>
+using ExprOf = decltype(as_expression(std::declval<const T&>()));
+
+//把容器显式变成表达式，用于比较运算符和需要延迟求值的场合
+template<typename C, typename = std::enable_if_t<kExprIsContainer<C>>>
+constexpr ExprRef<typename C::value_type> expr(const C& c) noexcept {
+    return ExprRef<typename C::value_type>(c.data(), c.size());
+}
+
+template<typename Op, typename L, typename R>
+constexpr ExprBinary<Op, ExprOf<L>, ExprOf<R>> make_binary_expression(const L& lhs, const R& rhs) {
+    return ExprBinary<Op, ExprOf<L>, ExprOf<R>>(as_expression(lhs), as_expression(rhs));
+}
+
+//算术运算：一边是表达式或容器，另一边可以是标量
+template<typename L, typename R>
+inline constexpr bool kExprArithmetic = kExprIsOperand<L> && kExprIsOperand<R> &&
+    (kExprIsExpression<L> || kExprIsContainer<L> || kExprIsExpression<R> || kExprIsContainer<R>);
+
+//比较运算：至少一边是表达式
+template<typename L, typename R>
+inline constexpr bool kExprComparison = kExprIsOperand<L> && kExprIsOperand<R> &&
+    (kExprIsExpression<L> || kExprIsExpression<R>);
+
+template<typename L, typename R, typename = std::enable_if_t<kExprArithmetic<L, R>>>
+constexpr auto operator+(const L& lhs, const R& rhs) {
+    return make_binary_expression<std::plus<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kExprArithmetic<L, R>>>
+constexpr auto operator-(const L& lhs, const R& rhs) {
+    return make_binary_expression<std::minus<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kExprArithmetic<L, R>>>
+constexpr auto operator*(const L& lhs, const R& rhs) {
+    return make_binary_expression<std::multiplies<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kExprArithmetic<L, R>>>
+constexpr auto operator/(const L& lhs, const R& rhs) {
+    return make_binary_expression<std::divides<>>(lhs, rhs);
+}
+
+//复合赋值：c = c op rhs，原地逐元素求值
+template<typename C, typename R, typename = std::enable_if_t<kExprIsContainer<C> && kExprIsOperand<R>>>
+constexpr C& operator+=(C& c, const R& rhs) {
+    return c = make_binary_expression<std::plus<>>(c, rhs);
+}
+
+template<typename C, typename R, typename = std::enable_if_t<kExprIsContainer<C> && kExprIsOperand<R>>>
+constexpr C& operator-=(C& c, const R& rhs) {
+    return c = make_binary_expression<std::minus<>>(c, rhs);
+}
+
+template<typename C, typename R, typename = std::enable_if_t<kExprIsContainer<C> && kExprIsOperand<R>>>
+constexpr C& operator*=(C& c, const R& rhs) {
+    return c = make_binary_expression<std::multiplies<>>(c, rhs);
+}
+
+template<typename C, typename R, typename = std::enable_if_t<kExprIsContainer<C> && kExprIsOperand<R>>>
+constexpr C& operator/=(C& c, const R& rhs) {
+    return c = make_binary_expression<std::divides<>>(c, rhs);
+}
+
+template<typename E, typename = std::enable_if_t<kExprIsExpression<E> || kExprIsContainer<E>>>
+constexpr auto operator-(const E& e) noexcept {
+    return ExprUnary<std::negate<>, ExprOf<E>>(as_expression(e));
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kExprComparison<L, R>>>
+constexpr auto operator<(const L& lhs, const R& rhs) {
+    return make_binary_expression<std::less<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kExprComparison<L, R>>>
+constexpr auto operator<=(const L& lhs, const R& rhs) {
+    return make_binary_expression<std::less_equal<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kExprComparison<L, R>>>
+constexpr auto operator>(const L& lhs, const R& rhs) {
+    return make_binary_expression<std::greater<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kExprComparison<L, R>>>
+constexpr auto operator>=(const L& lhs, const R& rhs) {
+    return make_binary_expression<std::greater_equal<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kExprComparison<L, R>>>
+constexpr auto operator==(const L& lhs, const R& rhs) {
+    return make_binary_expression<std::equal_to<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kExprComparison<L, R>>>
+constexpr auto operator!=(const L& lhs, const R& rhs) {
+    return make_binary_expression<std::not_equal_to<>>(lhs, rhs);
+}
+
+template<typename E, typename = std::enable_if_t<kExprIsExpression<E> || kExprIsContainer<E>>>
+constexpr auto abs(const E& e) noexcept {
+    return ExprUnary<ExprAbs, ExprOf<E>>(as_expression(e));
+}
+
+template<typename E, typename = std::enable_if_t<kExprIsExpression<E> || kExprIsContainer<E>>>
+auto sqrt(const E& e) noexcept {
+    return ExprUnary<ExprSqrt, ExprOf<E>>(as_expression(e));
+}
+
+template<typename C, typename X, typename Y, typename = std::enable_if_t<
+    kExprIsExpression<C> && kExprIsOperand<X> && kExprIsOperand<Y>>>
+constexpr auto where(const C& cond, const X& x, const Y& y) {
+    return ExprSelect<ExprOf<C>, ExprOf<X>, ExprOf<Y>>(as_expression(cond), as_expression(x), as_expression(y));
+}
+
+//归约：4个独立的累加器，打断加法的依赖链
+template<typename E, typename Op>
+constexpr auto reduce_expression(const E& e, typename E::value_type init, Op op) {
+    using T = typename E::value_type;
+    std::size_t n = e.size();
+    T acc[4] = {init, init, init, init};
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc[0] = op(acc[0], e[i]);
+        acc[1] = op(acc[1], e[i + 1]);
+        acc[2] = op(acc[2], e[i + 2]);
+        acc[3] = op(acc[3], e[i + 3]);
+    }
+    for (; i < n; ++i) {
+        acc[0] = op(acc[0], e[i]);
+    }
+    return op(op(acc[0], acc[1]), op(acc[2], acc[3]));
+}
+
+template<typename E, typename = std::enable_if_t<kExprIsExpression<E> || kExprIsContainer<E>>>
+constexpr auto sum(const E& x) {
+    auto e = as_expression(x);
+    return reduce_expression(e, typename decltype(e)::value_type(0), std::plus<>());
+}
+
+template<typename L, typename R, typename = std::enable_if_t<
+    (kExprIsExpression<L> || kExprIsContainer<L>) && (kExprIsExpression<R> || kExprIsContainer<R>)>>
+constexpr auto dot(const L& lhs, const R& rhs) {
+    return sum(make_binary_expression<std::multiplies<>>(lhs, rhs));
+}
+
+//空表达式的结果没有意义，调用方保证非空
+template<typename E, typename = std::enable_if_t<kExprIsExpression<E> || kExprIsContainer<E>>>
+constexpr auto min_value(const E& x) {
+    auto e = as_expression(x);
+    using T = typename decltype(e)::value_type;
+    return reduce_expression(e, e[0], [](T a, T b) { return b < a ? b : a; });
+}
+
+template<typename E, typename = std::enable_if_t<kExprIsExpression<E> || kExprIsContainer<E>>>
+constexpr auto max_value(const E& x) {
+    auto e = as_expression(x);
+    using T = typename decltype(e)::value_type;
+    return reduce_expression(e, e[0], [](T a, T b) { return a < b ? b : a; });
+}
+
+//按个数统计，没有提前退出，整个循环可以向量化
+template<typename E, typename = std::enable_if_t<kExprIsExpression<E>>>
+constexpr std::size_t count(const E& e) {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < e.size(); ++i) {
+        n += e[i] ? 1 : 0;
+    }
+    return n;
+}
+
+template<typename E, typename = std::enable_if_t<kExprIsExpression<E>>>
+constexpr bool all(const E& e) {
+    return count(e) == e.size();
+}
+
+template<typename E, typename = std::enable_if_t<kExprIsExpression<E>>>
+constexpr bool any(const E& e) {
+    return count(e) != 0;
+}
+
+}   //ycstl
+
+#endif
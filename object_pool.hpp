@@ -0,0 +1,286 @@
+/**
+ * 实现object_pool
+ * pool_deleter
+ * object_pool_stats
+ * object_pool
+ *
+ * 按slab批量分配槽位，make()在空闲槽位上构造对象并返回unique_ptr<T, pool_deleter>，
+ * 删除器析构对象后把槽位放回池中；
+ * 每个线程有自己的空闲链表，不加锁，过长时整段推到全局无锁链表，
+ * 本线程链表为空时一次取走整条全局链表，再没有时才分配新的slab
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef OBJECT_POOL_HPP_
+#define OBJECT_POOL_HPP_
+
+#include "memory.hpp"
+#include "thread_record.hpp"
+#include "vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ycstl {
+
+//空闲时存放链表指针，使用时存放对象
+template<typename T>
+union ObjectPoolSlot {
+    ObjectPoolSlot* next_;
+    alignas(T) unsigned char storage_[sizeof(T)];
+};
+
+//每个线程在每个池中一条记录，计数只由持有记录的线程写
+template<typename T>
+struct ObjectPoolRecord {
+    ObjectPoolSlot<T>* head_ = nullptr;
+    std::size_t count_ = 0;
+    std::atomic<std::size_t> acquired_{0};
+    std::atomic<std::size_t> released_{0};
+    std::atomic<std::size_t> misses_{0};
+    std::atomic<bool> in_use_{true};
+    ObjectPoolRecord* next_ = nullptr;
+};
+
+struct object_pool_stats {
+    std::size_t hits = 0;           //由空闲槽位满足的make
+    std::size_t misses = 0;         //需要分配新slab的make
+    std::size_t outstanding = 0;    //尚未归还的对象
+    std::size_t capacity = 0;       //所有slab中的槽位数
+};
+
+template<typename T, typename Allocator>
+class object_pool;
+
+//把对象还给所属的池
+template<typename T, typename Allocator = std::allocator<T>>
+class pool_deleter {
+public:
+    pool_deleter() noexcept : pool_(nullptr) {}
+
+    explicit pool_deleter(object_pool<T, Allocator>& pool) noexcept : pool_(&pool) {}
+
+    void operator()(T* ptr) const noexcept {
+        if (nullptr != ptr) {
+            pool_->release(ptr);
+        }
+    }
+
+    object_pool<T, Allocator>* get_pool() const noexcept {
+        return pool_;
+    }
+
+private:
+    object_pool<T, Allocator>* pool_;
+};
+
+template<typename T, typename Allocator = std::allocator<T>>
+class object_pool {
+    using Slot = ObjectPoolSlot<T>;
+    using Record = ObjectPoolRecord<T>;
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
+public:
+    using value_type   = T;
+    using size_type    = std::size_t;
+    using deleter_type = pool_deleter<T, Allocator>;
+    using pointer      = unique_ptr<T, deleter_type>;
+
+    static constexpr size_type kSlotsPerSlab = sizeof(Slot) >= 256 ? 64 : 16384 / sizeof(Slot);
+
+    // initial个槽位预先分配好，放在全局空闲链表中
+    explicit object_pool(size_type initial = 0, const Allocator& alloc = Allocator())
+        : global_(nullptr), records_(this, &detach), capacity_(0), alloc_(alloc) {
+        reserve(initial);
+    }
+
+    //销毁时所有对象必须都已归还
+    ~object_pool() {
+        records_.close();
+        SlotAllocator slot_alloc{alloc_};
+        for (size_type i = 0; i != slabs_.size(); ++i) {
+            slot_alloc.deallocate(slabs_[i], kSlotsPerSlab);
+        }
+    }
+
+    object_pool(const object_pool&) = delete;
+    object_pool& operator=(const object_pool&) = delete;
+
+    template<typename... Args, typename = std::enable_if_t<std::is_constructible_v<T, Args&&...>>>
+    pointer make(Args&&... args) {
+        Record* record = local_record();
+        Slot* slot = pop(record);
+        T* p;
+        try {
+            p = ::new (static_cast<void*>(slot->storage_)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            push(record, slot);
+            throw;
+        }
+        record->acquired_.store(record->acquired_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return pointer(p, deleter_type(*this));
+    }
+
+    //析构对象并把槽位放进本线程的空闲链表，可以在任意线程调用
+    void release(T* p) noexcept {
+        std::destroy_at(p);
+        Record* record = local_record();
+        push(record, reinterpret_cast<Slot*>(p));
+        record->released_.store(record->released_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (record->count_ > kCacheLimit) {
+            flush(record, kCacheLimit / 2);
+        }
+    }
+
+    //至少有n个槽位，新增的放入全局空闲链表
+    void reserve(size_type n) {
+        std::lock_guard<std::mutex> lock(slab_mutex_);
+        while (capacity_.load(std::memory_order_relaxed) < n) {
+            Slot* first = allocate_slab();
+            push_global(first, first + kSlotsPerSlab - 1);
+        }
+    }
+
+    object_pool_stats stats() const {
+        object_pool_stats s;
+        size_type acquired = 0;
+        size_type released = 0;
+        for (Record* record = records_.head(); nullptr != record; record = record->next_) {
+            acquired += record->acquired_.load(std::memory_order_relaxed);
+            released += record->released_.load(std::memory_order_relaxed);
+            s.misses += record->misses_.load(std::memory_order_relaxed);
+        }
+        //各线程的计数不是同一时刻读到的，只保证不出现负数
+        s.hits = acquired > s.misses ? acquired - s.misses : 0;
+        s.outstanding = acquired > released ? acquired - released : 0;
+        s.capacity = capacity_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    size_type outstanding() const {
+        return stats().outstanding;
+    }
+
+    double hit_rate() const {
+        object_pool_stats s = stats();
+        return 0 == s.hits + s.misses ? 0.0 : double(s.hits) / double(s.hits + s.misses);
+    }
+
+    size_type capacity() const noexcept {
+        return capacity_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_type kCacheLimit = 2 * kSlotsPerSlab;
+
+    Slot* pop(Record* record) {
+        if (nullptr == record->head_) {
+            refill(record);
+        }
+        Slot* slot = record->head_;
+        record->head_ = slot->next_;
+        --record->count_;
+        return slot;
+    }
+
+    static void push(Record* record, Slot* slot) noexcept {
+        slot->next_ = record->head_;
+        record->head_ = slot;
+        ++record->count_;
+    }
+
+    //整条取走全局链表，没有ABA问题；仍为空时分配新slab
+    void refill(Record* record) {
+        Slot* head = global_.exchange(nullptr, std::memory_order_acquire);
+        if (nullptr == head) {
+            {
+                std::lock_guard<std::mutex> lock(slab_mutex_);
+                head = allocate_slab();
+            }
+            record->misses_.store(record->misses_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        size_type n = 0;
+        Slot* tail = head;
+        for (;;) {
+            ++n;
+            if (nullptr == tail->next_) {
+                break;
+            }
+            tail = tail->next_;
+        }
+        tail->next_ = record->head_;
+        record->head_ = head;
+        record->count_ += n;
+    }
+
+    //把本线程链表的前n个槽位推到全局链表
+    void flush(Record* record, size_type n) noexcept {
+        if (0 == n || nullptr == record->head_) {
+            return;
+        }
+        Slot* first = record->head_;
+        Slot* last = first;
+        size_type moved = 1;
+        while (moved < n && nullptr != last->next_) {
+            last = last->next_;
+            ++moved;
+        }
+        record->head_ = last->next_;
+        record->count_ -= moved;
+        push_global(first, last);
+    }
+
+    void push_global(Slot* first, Slot* last) noexcept {
+        Slot* head = global_.load(std::memory_order_relaxed);
+        do {
+            last->next_ = head;
+        } while (!global_.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    //调用者持有slab_mutex_，返回串好的槽位链表
+    Slot* allocate_slab() {
+        SlotAllocator slot_alloc{alloc_};
+        Slot* slab = slot_alloc.allocate(kSlotsPerSlab);
+        try {
+            slabs_.push_back(slab);
+        } catch (...) {
+            slot_alloc.deallocate(slab, kSlotsPerSlab);
+            throw;
+        }
+        for (size_type i = 0; i + 1 != kSlotsPerSlab; ++i) {
+            slab[i].next_ = &slab[i + 1];
+        }
+        slab[kSlotsPerSlab - 1].next_ = nullptr;
+        capacity_.store(capacity_.load(std::memory_order_relaxed) + kSlotsPerSlab, std::memory_order_relaxed);
+        return slab;
+    }
+
+    //线程退出时在注册表的锁内调用：把本线程链表推到全局链表，并把记录标记为空闲
+    static void detach(void* owner, void* p) noexcept {
+        Record* record = static_cast<Record*>(p);
+        static_cast<object_pool*>(owner)->flush(record, record->count_);
+        record->in_use_.store(false, std::memory_order_release);
+    }
+
+    Record* local_record() {
+        return records_.local();
+    }
+
+    std::atomic<Slot*> global_;
+    ThreadRecordList<Record> records_;
+    std::atomic<size_type> capacity_;
+    std::mutex slab_mutex_;
+    ycstl::vector<Slot*> slabs_;
+    YCSTL_NO_UNIQUE_ADDRESS Allocator alloc_;
+};
+
+}   //ycstl
+
+#endif
@@ -0,0 +1,233 @@
+/**
+ * 实现perf_counter
+ * perf_event / perf_reading / perf_counters / perf_scope
+ *
+ * 基于perf_event_open的硬件计数器：周期、指令、L1d读缺失、LLC读缺失、分支预测失败、dTLB读缺失；
+ * 每个事件单独打开，只统计调用线程的用户态，某个事件打不开(容器里没有权限、虚拟机没有PMU、
+ * 非Linux系统)时只把它标记为不可用，其余照常工作；
+ * 计数器被内核轮换复用时按 enabled / running 时间比例放大
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef PERF_COUNTER_HPP_
+#define PERF_COUNTER_HPP_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ycstl {
+
+enum class perf_event : std::size_t {
+    cycles,
+    instructions,
+    l1d_misses,
+    llc_misses,
+    branch_misses,
+    dtlb_misses,
+};
+
+inline constexpr std::size_t kPerfEventCount = 6;
+
+inline const char* perf_event_name(perf_event e) noexcept {
+    static const char* const names[kPerfEventCount] = {
+        "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses",
+    };
+    return names[static_cast<std::size_t>(e)];
+}
+
+//一次测量的结果，不可用的事件valid为false
+struct perf_reading {
+    std::uint64_t values[kPerfEventCount] = {};
+    bool valid[kPerfEventCount] = {};
+
+    bool has(perf_event e) const noexcept {
+        return valid[static_cast<std::size_t>(e)];
+    }
+
+    std::uint64_t operator[](perf_event e) const noexcept {
+        return values[static_cast<std::size_t>(e)];
+    }
+
+    //平均到每个元素
+    double per(perf_event e, double elements) const noexcept {
+        return double(values[static_cast<std::size_t>(e)]) / elements;
+    }
+
+    bool any() const noexcept {
+        for (bool v : valid) {
+            if (v) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    perf_reading& operator+=(const perf_reading& other) noexcept {
+        for (std::size_t i = 0; i != kPerfEventCount; ++i) {
+            values[i] += other.values[i];
+            valid[i] = valid[i] || other.valid[i];
+        }
+        return *this;
+    }
+};
+
+//调用线程上的一组计数器，构造时打开，析构时关闭
+class perf_counters {
+public:
+    perf_counters() noexcept {
+        for (std::size_t i = 0; i != kPerfEventCount; ++i) {
+            fds_[i] = -1;
+            errors_[i] = open(static_cast<perf_event>(i), fds_[i]);
+        }
+    }
+
+    ~perf_counters() {
+#if defined(__linux__)
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+#endif
+    }
+
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+
+    bool available(perf_event e) const noexcept {
+        return fds_[static_cast<std::size_t>(e)] >= 0;
+    }
+
+    bool any_available() const noexcept {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //打开失败时的errno，可用时为0
+    int error(perf_event e) const noexcept {
+        return errors_[static_cast<std::size_t>(e)];
+    }
+
+    void start() noexcept {
+#if defined(__linux__)
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    perf_reading stop() noexcept {
+        perf_reading reading;
+#if defined(__linux__)
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        for (std::size_t i = 0; i != kPerfEventCount; ++i) {
+            //value, time_enabled, time_running
+            std::uint64_t data[3] = {};
+            if (fds_[i] < 0 || ::read(fds_[i], data, sizeof(data)) != ssize_t(sizeof(data))) {
+                continue;
+            }
+            reading.valid[i] = true;
+            if (0 != data[2] && data[2] < data[1]) {
+                reading.values[i] = std::uint64_t(double(data[0]) * double(data[1]) / double(data[2]));
+            } else {
+                reading.values[i] = data[0];
+            }
+        }
+#endif
+        return reading;
+    }
+
+private:
+    static int open(perf_event e, int& fd) noexcept {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        constexpr std::uint64_t kReadMiss = (std::uint64_t(PERF_COUNT_HW_CACHE_OP_READ) << 8) |
+                                            (std::uint64_t(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16);
+        switch (e) {
+        case perf_event::cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case perf_event::instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case perf_event::l1d_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | kReadMiss;
+            break;
+        case perf_event::llc_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_LL | kReadMiss;
+            break;
+        case perf_event::branch_misses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case perf_event::dtlb_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_DTLB | kReadMiss;
+            break;
+        }
+        fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+        return fd < 0 ? errno : 0;
+#else
+        (void)e;
+        fd = -1;
+        return ENOSYS;
+#endif
+    }
+
+    int fds_[kPerfEventCount];
+    int errors_[kPerfEventCount];
+};
+
+//作用域内的计数累加到out中，计数器不可用时什么都不做
+class perf_scope {
+public:
+    perf_scope(perf_counters& counters, perf_reading& out) noexcept : counters_(counters), out_(out) {
+        counters_.start();
+    }
+
+    ~perf_scope() {
+        out_ += counters_.stop();
+    }
+
+    perf_scope(const perf_scope&) = delete;
+    perf_scope& operator=(const perf_scope&) = delete;
+
+private:
+    perf_counters& counters_;
+    perf_reading& out_;
+};
+
+}   //ycstl
+
+#endif
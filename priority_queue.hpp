@@ -0,0 +1,489 @@
+/**
+ * 实现priority_queue
+ * priority_queue / indexed_priority_queue / radix_heap
+ *
+ * priority_queue是Arity叉堆，默认4叉：树高减半，一个节点的孩子挨在一起，
+ * 下沉时比较的几个元素通常在同一两条缓存行里；从已有容器构造时用自底向上的O(n)建堆；
+ * indexed_priority_queue在push时返回句柄，可以按句柄修改优先级或删除，适合Dijkstra的decrease-key；
+ * radix_heap是单调的最小堆，只接受无符号整数key，并且push的key不能小于最近一次top/pop看到的key
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef PRIORITY_QUEUE_HPP_
+#define PRIORITY_QUEUE_HPP_
+
+#include "memory.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace ycstl {
+
+//Arity叉堆中的下标换算，根为0
+template<std::size_t Arity>
+struct HeapIndex {
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+
+    static constexpr std::size_t parent(std::size_t i) noexcept {
+        return (i - 1) / Arity;
+    }
+
+    static constexpr std::size_t first_child(std::size_t i) noexcept {
+        return i * Arity + 1;
+    }
+};
+
+template<typename T, typename Container = vector<T>, typename Compare = std::less<T>, std::size_t Arity = 4>
+class priority_queue {
+    using Index = HeapIndex<Arity>;
+
+public:
+    using container_type  = Container;
+    using value_compare   = Compare;
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using reference       = T&;
+    using const_reference = const T&;
+
+    static constexpr std::size_t arity = Arity;
+
+    priority_queue() : priority_queue(Compare()) {}
+
+    explicit priority_queue(const Compare& comp) : c_(), comp_(comp) {}
+
+    priority_queue(const Compare& comp, const Container& c) : c_(c), comp_(comp) {
+        heapify();
+    }
+
+    priority_queue(const Compare& comp, Container&& c) : c_(std::move(c)), comp_(comp) {
+        heapify();
+    }
+
+    template<typename InputIter, typename = std::void_t<
+        decltype(*std::declval<InputIter>()),
+        decltype(++std::declval<InputIter&>())
+    >>
+    priority_queue(InputIter first, InputIter last, const Compare& comp = Compare()) : c_(), comp_(comp) {
+        for (; first != last; ++first) {
+            c_.push_back(*first);
+        }
+        heapify();
+    }
+
+    const_reference top() const {
+        return c_[0];
+    }
+
+    bool empty() const {
+        return c_.empty();
+    }
+
+    size_type size() const {
+        return c_.size();
+    }
+
+    void reserve(size_type n) {
+        c_.reserve(n);
+    }
+
+    void push(const T& value) {
+        c_.push_back(value);
+        sift_up(c_.size() - 1);
+    }
+
+    void push(T&& value) {
+        c_.push_back(std::move(value));
+        sift_up(c_.size() - 1);
+    }
+
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        c_.emplace_back(std::forward<Args>(args)...);
+        sift_up(c_.size() - 1);
+    }
+
+    //批量加入：加入的元素多于已有元素时整体重新建堆比逐个上浮便宜
+    template<typename InputIter>
+    void push_range(InputIter first, InputIter last) {
+        size_type old_size = c_.size();
+        for (; first != last; ++first) {
+            c_.push_back(*first);
+        }
+        if (c_.size() - old_size > old_size) {
+            heapify();
+        } else {
+            for (size_type i = old_size; i != c_.size(); ++i) {
+                sift_up(i);
+            }
+        }
+    }
+
+    //末尾元素来自最底层，几乎总要沉到底，所以先把空位一路沉到叶子再让它上浮，每层省一次比较
+    void pop() {
+        T value = std::move(c_.back());
+        c_.pop_back();
+        if (!c_.empty()) {
+            sift_up(sift_hole_to_leaf(0), std::move(value));
+        }
+    }
+
+    //取出堆顶，省去一次top()的拷贝
+    T take() {
+        T result = std::move(c_[0]);
+        pop();
+        return result;
+    }
+
+    void clear() {
+        c_.clear();
+    }
+
+    void swap(priority_queue& other) noexcept {
+        using std::swap;
+        swap(c_, other.c_);
+        swap(comp_, other.comp_);
+    }
+
+    const Container& container() const noexcept {
+        return c_;
+    }
+
+private:
+    //自底向上建堆，最后一个非叶子节点往前逐个下沉
+    void heapify() {
+        size_type n = c_.size();
+        if (n < 2) {
+            return;
+        }
+        for (size_type i = Index::parent(n - 1) + 1; i-- != 0;) {
+            sift_down(i, std::move(c_[i]));
+        }
+    }
+
+    void sift_up(size_type i) {
+        sift_up(i, std::move(c_[i]));
+    }
+
+    //空位从i往上走，父节点优先级更低就把父节点挪下来
+    void sift_up(size_type i, T value) {
+        while (0 != i) {
+            size_type parent = Index::parent(i);
+            if (!comp_(c_[parent], value)) {
+                break;
+            }
+            c_[i] = std::move(c_[parent]);
+            i = parent;
+        }
+        c_[i] = std::move(value);
+    }
+
+    //在child开始的孩子里选优先级最高的；孩子齐全时循环次数是常量，编译器可以展开
+    size_type best_child(size_type child, size_type n) const {
+        size_type best = child;
+        if (child + Arity <= n) {
+            for (size_type k = 1; k != Arity; ++k) {
+                best = comp_(c_[best], c_[child + k]) ? child + k : best;
+            }
+        } else {
+            for (size_type k = child + 1; k < n; ++k) {
+                best = comp_(c_[best], c_[k]) ? k : best;
+            }
+        }
+        return best;
+    }
+
+    //空位从hole一直沉到叶子，返回最后的位置
+    size_type sift_hole_to_leaf(size_type hole) {
+        size_type n = c_.size();
+        for (size_type child = Index::first_child(hole); child < n; child = Index::first_child(hole)) {
+            size_type best = best_child(child, n);
+            c_[hole] = std::move(c_[best]);
+            hole = best;
+        }
+        return hole;
+    }
+
+    //空位从hole往下走，value比最好的孩子优先级高时停下
+    void sift_down(size_type hole, T value) {
+        size_type n = c_.size();
+        for (;;) {
+            size_type child = Index::first_child(hole);
+            if (child >= n) {
+                break;
+            }
+            size_type best = best_child(child, n);
+            if (!comp_(value, c_[best])) {
+                break;
+            }
+            c_[hole] = std::move(c_[best]);
+            hole = best;
+        }
+        c_[hole] = std::move(value);
+    }
+
+private:
+    Container c_;
+    YCSTL_NO_UNIQUE_ADDRESS Compare comp_;
+};
+
+template<typename T, typename Container, typename Compare, std::size_t Arity>
+void swap(priority_queue<T, Container, Compare, Arity>& a, priority_queue<T, Container, Compare, Arity>& b) noexcept {
+    a.swap(b);
+}
+
+//带句柄的Arity叉堆：pos_[handle]记录元素在堆中的下标，元素移动时同步更新；
+//句柄在元素被pop或erase后回收，之后push可能复用
+template<typename T, typename Compare = std::less<T>, std::size_t Arity = 4>
+class indexed_priority_queue {
+    using Index = HeapIndex<Arity>;
+
+public:
+    using value_type      = T;
+    using value_compare   = Compare;
+    using size_type       = std::size_t;
+    using handle          = std::size_t;
+    using const_reference = const T&;
+
+    static constexpr std::size_t arity = Arity;
+    static constexpr size_type npos = size_type(-1);
+
+    indexed_priority_queue() : indexed_priority_queue(Compare()) {}
+
+    explicit indexed_priority_queue(const Compare& comp) : comp_(comp) {}
+
+    const_reference top() const {
+        return heap_[0].value;
+    }
+
+    handle top_handle() const {
+        return heap_[0].id;
+    }
+
+    bool empty() const {
+        return heap_.empty();
+    }
+
+    size_type size() const {
+        return heap_.size();
+    }
+
+    void reserve(size_type n) {
+        heap_.reserve(n);
+        pos_.reserve(n);
+    }
+
+    bool contains(handle h) const {
+        return h < pos_.size() && npos != pos_[h];
+    }
+
+    const_reference value(handle h) const {
+        return heap_[pos_[h]].value;
+    }
+
+    handle push(T value) {
+        handle h;
+        if (free_.empty()) {
+            h = pos_.size();
+            pos_.push_back(npos);
+        } else {
+            h = free_.back();
+            free_.pop_back();
+        }
+        heap_.push_back(Entry{std::move(value), h});
+        sift_up(heap_.size() - 1);
+        return h;
+    }
+
+    void pop() {
+        erase(heap_[0].id);
+    }
+
+    //优先级升高时上浮，降低时下沉；Compare为std::greater时就是decrease-key
+    void update(handle h, T value) {
+        size_type i = pos_[h];
+        bool raise = comp_(heap_[i].value, value);
+        heap_[i].value = std::move(value);
+        if (raise) {
+            sift_up(i);
+        } else {
+            sift_down(i);
+        }
+    }
+
+    void erase(handle h) {
+        size_type i = pos_[h];
+        pos_[h] = npos;
+        free_.push_back(h);
+        if (i + 1 == heap_.size()) {
+            heap_.pop_back();
+            return;
+        }
+        heap_[i] = std::move(heap_.back());
+        heap_.pop_back();
+        pos_[heap_[i].id] = i;
+        if (0 != i && comp_(heap_[Index::parent(i)].value, heap_[i].value)) {
+            sift_up(i);
+        } else {
+            sift_down(i);
+        }
+    }
+
+    //清空元素，所有句柄失效
+    void clear() {
+        heap_.clear();
+        pos_.clear();
+        free_.clear();
+    }
+
+private:
+    struct Entry {
+        T value;
+        handle id;
+    };
+
+    void place(size_type i, Entry&& e) {
+        pos_[e.id] = i;
+        heap_[i] = std::move(e);
+    }
+
+    void sift_up(size_type i) {
+        Entry e = std::move(heap_[i]);
+        while (0 != i) {
+            size_type parent = Index::parent(i);
+            if (!comp_(heap_[parent].value, e.value)) {
+                break;
+            }
+            place(i, std::move(heap_[parent]));
+            i = parent;
+        }
+        place(i, std::move(e));
+    }
+
+    void sift_down(size_type hole) {
+        Entry e = std::move(heap_[hole]);
+        size_type n = heap_.size();
+        for (;;) {
+            size_type child = Index::first_child(hole);
+            if (child >= n) {
+                break;
+            }
+            size_type best = child;
+            size_type last = std::min(child + Arity, n);
+            for (size_type k = child + 1; k < last; ++k) {
+                if (comp_(heap_[best].value, heap_[k].value)) {
+                    best = k;
+                }
+            }
+            if (!comp_(e.value, heap_[best].value)) {
+                break;
+            }
+            place(hole, std::move(heap_[best]));
+            hole = best;
+        }
+        place(hole, std::move(e));
+    }
+
+private:
+    vector<Entry> heap_;
+    vector<size_type> pos_;            // 句柄 -> 堆中下标，已回收的为npos
+    vector<handle> free_;
+    YCSTL_NO_UNIQUE_ADDRESS Compare comp_;
+};
+
+//单调的最小堆：第i个桶放与last_最高的不同位在第i-1位的key，0号桶放等于last_的key；
+//top/pop发现0号桶为空时才把最低的非空桶按新的last_重新分配，每个元素最多被搬动位数次
+//使用前应当保证push的key不小于最近一次top/pop看到的key，否则是ub
+template<typename Key, typename Value>
+class radix_heap {
+    static_assert(std::is_unsigned_v<Key>, "radix_heap needs an unsigned integer key");
+
+    static constexpr std::size_t kBuckets = std::numeric_limits<Key>::digits + 1;
+
+public:
+    using key_type   = Key;
+    using value_type = std::pair<Key, Value>;
+    using size_type  = std::size_t;
+
+    radix_heap() = default;
+
+    bool empty() const noexcept {
+        return 0 == size_;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    //重新分配不改变堆里的内容，所以top仍然是const
+    const value_type& top() const {
+        pull();
+        return buckets_[0].back();
+    }
+
+    Key top_key() const {
+        pull();
+        return last_;
+    }
+
+    void push(Key key, Value value) {
+        buckets_[bucket(key)].push_back(value_type(key, std::move(value)));
+        ++size_;
+    }
+
+    void pop() {
+        pull();
+        buckets_[0].pop_back();
+        --size_;
+    }
+
+    //清空元素，桶的容量保留
+    void clear() {
+        for (auto& b : buckets_) {
+            b.clear();
+        }
+        size_ = 0;
+        last_ = 0;
+    }
+
+private:
+    size_type bucket(Key key) const noexcept {
+        return static_cast<size_type>(std::bit_width(static_cast<Key>(key ^ last_)));
+    }
+
+    void pull() const {
+        if (!buckets_[0].empty()) {
+            return;
+        }
+        size_type i = 1;
+        while (buckets_[i].empty()) {
+            ++i;
+        }
+        vector<value_type>& from = buckets_[i];
+        Key smallest = from[0].first;
+        for (size_type k = 1; k != from.size(); ++k) {
+            smallest = std::min(smallest, from[k].first);
+        }
+        last_ = smallest;
+        //新的last_与这些key的最高不同位都低于i-1，一定落到更低的桶里
+        for (size_type k = 0; k != from.size(); ++k) {
+            buckets_[bucket(from[k].first)].push_back(std::move(from[k]));
+        }
+        from.clear();
+    }
+
+private:
+    mutable vector<value_type> buckets_[kBuckets];
+    mutable Key last_ = 0;
+    size_type size_ = 0;
+};
+
+}   //ycstl
+
+#endif
@@ -0,0 +1,769 @@
+/**
+ * 实现ranges
+ * subrange / filter_view / transform_view / take_view / drop_view
+ * chunk_view / zip_view / enumerate_view
+ * views::all / filter / transform / take / drop / chunk / zip / enumerate
+ * to<C>()
+ *
+ * 视图只保存底层范围和参数，遍历时才逐个计算元素，串起来的管道不产生中间容器；
+ * 左值容器按引用保存，右值容器移动进视图；
+ * v | views::filter(p) | views::transform(f) | to<vector>()，知道长度时to会先reserve
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef RANGES_HPP_
+#define RANGES_HPP_
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ycstl {
+
+//所有视图的基类，用来区分视图和容器
+struct view_base {};
+
+template<typename R>
+inline constexpr bool kRangeIsView = std::is_base_of_v<view_base, std::remove_cv_t<std::remove_reference_t<R>>>;
+
+template<typename R>
+using RangeIterator = decltype(std::declval<R&>().begin());
+
+template<typename R>
+using RangeReference = decltype(*std::declval<RangeIterator<R>&>());
+
+template<typename R, typename = void>
+struct RangeHasSize : std::false_type {};
+
+template<typename R>
+struct RangeHasSize<R, std::void_t<decltype(std::declval<const R&>().size())>> : std::true_type {};
+
+template<typename R>
+inline constexpr bool kRangeSized = RangeHasSize<R>::value;
+
+template<typename R, typename = void>
+struct RangeIsRange : std::false_type {};
+
+template<typename R>
+struct RangeIsRange<R, std::void_t<RangeIterator<R>, decltype(std::declval<R&>().end())>> : std::true_type {};
+
+template<typename R>
+inline constexpr bool kRangeIsRange = RangeIsRange<std::remove_reference_t<R>>::value;
+
+template<typename It>
+inline constexpr bool kRangeRandomAccess = std::is_base_of_v<std::random_access_iterator_tag,
+    typename std::iterator_traits<It>::iterator_category>;
+
+//最多前进n步，不越过last
+template<typename It>
+constexpr It range_next(It it, std::size_t n, const It& last) {
+    if constexpr (kRangeRandomAccess<It>) {
+        std::size_t left = static_cast<std::size_t>(last - it);
+        return it + static_cast<std::ptrdiff_t>(n < left ? n : left);
+    } else {
+        for (; n != 0 && it != last; --n) {
+            ++it;
+        }
+        return it;
+    }
+}
+
+//有size()用size()，随机访问迭代器用end() - begin()
+template<typename R>
+constexpr std::size_t range_size(const R& r) {
+    if constexpr (kRangeSized<R>) {
+        return static_cast<std::size_t>(r.size());
+    } else {
+        return static_cast<std::size_t>(r.end() - r.begin());
+    }
+}
+
+//一对迭代器
+template<typename It>
+class subrange : public view_base {
+public:
+    using iterator = It;
+
+    constexpr subrange() = default;
+
+    constexpr subrange(It first, It last) : first_(first), last_(last) {}
+
+    constexpr It begin() const {
+        return first_;
+    }
+
+    constexpr It end() const {
+        return last_;
+    }
+
+    constexpr bool empty() const {
+        return first_ == last_;
+    }
+
+    constexpr std::size_t size() const {
+        return static_cast<std::size_t>(std::distance(first_, last_));
+    }
+
+private:
+    It first_{};
+    It last_{};
+};
+
+//左值容器：只保存指针
+template<typename R>
+class RangeRef : public view_base {
+public:
+    constexpr explicit RangeRef(R& r) noexcept : r_(&r) {}
+
+    constexpr auto begin() const {
+        return r_->begin();
+    }
+
+    constexpr auto end() const {
+        return r_->end();
+    }
+
+    template<typename B = R, typename = std::enable_if_t<kRangeSized<B>>>
+    constexpr std::size_t size() const {
+        return static_cast<std::size_t>(r_->size());
+    }
+
+private:
+    R* r_;
+};
+
+//右值容器：移动进来，由视图持有
+template<typename R>
+class RangeOwn : public view_base {
+public:
+    constexpr explicit RangeOwn(R&& r) : r_(std::move(r)) {}
+
+    constexpr auto begin() {
+        return r_.begin();
+    }
+
+    constexpr auto end() {
+        return r_.end();
+    }
+
+    constexpr auto begin() const {
+        return r_.begin();
+    }
+
+    constexpr auto end() const {
+        return r_.end();
+    }
+
+    template<typename B = R, typename = std::enable_if_t<kRangeSized<B>>>
+    constexpr std::size_t size() const {
+        return static_cast<std::size_t>(r_.size());
+    }
+
+private:
+    R r_;
+};
+
+namespace views {
+
+template<typename R, typename = std::enable_if_t<kRangeIsRange<R>>>
+constexpr auto all(R&& r) {
+    if constexpr (kRangeIsView<R>) {
+        return std::decay_t<R>(std::forward<R>(r));
+    } else if constexpr (std::is_lvalue_reference_v<R>) {
+        return RangeRef<std::remove_reference_t<R>>(r);
+    } else {
+        return RangeOwn<std::remove_cv_t<R>>(std::move(r));
+    }
+}
+
+}
+
+template<typename R>
+using RangeAll = decltype(views::all(std::declval<R>()));
+
+//管道右边的适配器，r | closure 等价于 closure(r)
+template<typename Fn>
+class RangeAdaptorClosure {
+public:
+    constexpr explicit RangeAdaptorClosure(Fn fn) : fn_(std::move(fn)) {}
+
+    template<typename R, typename = std::enable_if_t<kRangeIsRange<R>>>
+    constexpr auto operator()(R&& r) const {
+        return fn_(std::forward<R>(r));
+    }
+
+private:
+    Fn fn_;
+};
+
+template<typename T>
+struct RangeIsClosure : std::false_type {};
+
+template<typename Fn>
+struct RangeIsClosure<RangeAdaptorClosure<Fn>> : std::true_type {};
+
+template<typename R, typename Fn, typename = std::enable_if_t<kRangeIsRange<R>>>
+constexpr auto operator|(R&& r, const RangeAdaptorClosure<Fn>& closure) {
+    return closure(std::forward<R>(r));
+}
+
+//两个适配器先组合起来，之后再作用到范围上
+template<typename Fn1, typename Fn2>
+constexpr auto operator|(const RangeAdaptorClosure<Fn1>& first, const RangeAdaptorClosure<Fn2>& second) {
+    return RangeAdaptorClosure([first, second](auto&& r) {
+        return second(first(std::forward<decltype(r)>(r)));
+    });
+}
+
+//只保留pred为真的元素，没有长度
+template<typename V, typename Pred>
+class filter_view : public view_base {
+    using BaseIterator = decltype(std::declval<const V&>().begin());
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename std::iterator_traits<BaseIterator>::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = decltype(*std::declval<const BaseIterator&>());
+        using pointer = void;
+
+        constexpr iterator() = default;
+
+        constexpr iterator(BaseIterator cur, const filter_view* parent) : cur_(cur), parent_(parent) {
+            satisfy();
+        }
+
+        constexpr reference operator*() const {
+            return *cur_;
+        }
+
+        constexpr iterator& operator++() {
+            ++cur_;
+            satisfy();
+            return *this;
+        }
+
+        constexpr iterator operator++(int) {
+            iterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        constexpr bool operator==(const iterator& it) const {
+            return cur_ == it.cur_;
+        }
+
+        constexpr bool operator!=(const iterator& it) const {
+            return !(cur_ == it.cur_);
+        }
+
+    private:
+        constexpr void satisfy() {
+            BaseIterator last = parent_->base_.end();
+            while (cur_ != last && !std::invoke(parent_->pred_, *cur_)) {
+                ++cur_;
+            }
+        }
+
+        BaseIterator cur_{};
+        const filter_view* parent_ = nullptr;
+    };
+
+    constexpr filter_view(V base, Pred pred) : base_(std::move(base)), pred_(std::move(pred)) {}
+
+    constexpr iterator begin() const {
+        return iterator(base_.begin(), this);
+    }
+
+    constexpr iterator end() const {
+        return iterator(base_.end(), this);
+    }
+
+private:
+    V base_;
+    Pred pred_;
+};
+
+//对每个元素调用f，长度和底层相同
+template<typename V, typename F>
+class transform_view : public view_base {
+    using BaseIterator = decltype(std::declval<const V&>().begin());
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::invoke_result_t<const F&, decltype(*std::declval<const BaseIterator&>())>;
+        using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+
+        constexpr iterator() = default;
+
+        constexpr iterator(BaseIterator cur, const F* f) : cur_(cur), f_(f) {}
+
+        constexpr reference operator*() const {
+            return std::invoke(*f_, *cur_);
+        }
+
+        constexpr iterator& operator++() {
+            ++cur_;
+            return *this;
+        }
+
+        constexpr iterator operator++(int) {
+            iterator it(*this);
+            ++cur_;
+            return it;
+        }
+
+        constexpr bool operator==(const iterator& it) const {
+            return cur_ == it.cur_;
+        }
+
+        constexpr bool operator!=(const iterator& it) const {
+            return !(cur_ == it.cur_);
+        }
+
+    private:
+        BaseIterator cur_{};
+        const F* f_ = nullptr;
+    };
+
+    constexpr transform_view(V base, F f) : base_(std::move(base)), f_(std::move(f)) {}
+
+    constexpr iterator begin() const {
+        return iterator(base_.begin(), &f_);
+    }
+
+    constexpr iterator end() const {
+        return iterator(base_.end(), &f_);
+    }
+
+    template<typename B = V, typename = std::enable_if_t<kRangeSized<B>>>
+    constexpr std::size_t size() const {
+        return range_size(base_);
+    }
+
+private:
+    V base_;
+    F f_;
+};
+
+//前n个元素，迭代器带着剩余个数，剩余为0或到达底层末尾即结束
+template<typename V>
+class take_view : public view_base {
+    using BaseIterator = decltype(std::declval<const V&>().begin());
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename std::iterator_traits<BaseIterator>::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = decltype(*std::declval<const BaseIterator&>());
+        using pointer = void;
+
+        constexpr iterator() = default;
+
+        constexpr iterator(BaseIterator cur, std::size_t left) : cur_(cur), left_(left) {}
+
+        constexpr reference operator*() const {
+            return *cur_;
+        }
+
+        constexpr iterator& operator++() {
+            ++cur_;
+            --left_;
+            return *this;
+        }
+
+        constexpr iterator operator++(int) {
+            iterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        constexpr bool operator==(const iterator& it) const {
+            return (0 == left_ && 0 == it.left_) || cur_ == it.cur_;
+        }
+
+        constexpr bool operator!=(const iterator& it) const {
+            return !(*this == it);
+        }
+
+    private:
+        BaseIterator cur_{};
+        std::size_t left_ = 0;
+    };
+
+    constexpr take_view(V base, std::size_t n) : base_(std::move(base)), n_(n) {}
+
+    constexpr iterator begin() const {
+        return iterator(base_.begin(), n_);
+    }
+
+    constexpr iterator end() const {
+        return iterator(base_.end(), 0);
+    }
+
+    template<typename B = V, typename = std::enable_if_t<kRangeSized<B>>>
+    constexpr std::size_t size() const {
+        std::size_t n = range_size(base_);
+        return n < n_ ? n : n_;
+    }
+
+private:
+    V base_;
+    std::size_t n_;
+};
+
+//跳过前n个元素，迭代器就是底层迭代器
+template<typename V>
+class drop_view : public view_base {
+public:
+    using iterator = decltype(std::declval<const V&>().begin());
+
+    constexpr drop_view(V base, std::size_t n) : base_(std::move(base)), n_(n) {}
+
+    constexpr iterator begin() const {
+        return range_next(base_.begin(), n_, base_.end());
+    }
+
+    constexpr iterator end() const {
+        return base_.end();
+    }
+
+    template<typename B = V, typename = std::enable_if_t<kRangeSized<B>>>
+    constexpr std::size_t size() const {
+        std::size_t n = range_size(base_);
+        return n > n_ ? n - n_ : 0;
+    }
+
+private:
+    V base_;
+    std::size_t n_;
+};
+
+//每n个元素一组，每组是一个subrange，最后一组可能不满
+template<typename V>
+class chunk_view : public view_base {
+    using BaseIterator = decltype(std::declval<const V&>().begin());
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = subrange<BaseIterator>;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+        using pointer = void;
+
+        constexpr iterator() = default;
+
+        constexpr iterator(BaseIterator cur, BaseIterator last, std::size_t n) : cur_(cur), last_(last), n_(n) {}
+
+        constexpr value_type operator*() const {
+            return value_type(cur_, range_next(cur_, n_, last_));
+        }
+
+        constexpr iterator& operator++() {
+            cur_ = range_next(cur_, n_, last_);
+            return *this;
+        }
+
+        constexpr iterator operator++(int) {
+            iterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        constexpr bool operator==(const iterator& it) const {
+            return cur_ == it.cur_;
+        }
+
+        constexpr bool operator!=(const iterator& it) const {
+            return !(cur_ == it.cur_);
+        }
+
+    private:
+        BaseIterator cur_{};
+        BaseIterator last_{};
+        std::size_t n_ = 1;
+    };
+
+    constexpr chunk_view(V base, std::size_t n) : base_(std::move(base)), n_(n) {}
+
+    constexpr iterator begin() const {
+        return iterator(base_.begin(), base_.end(), n_);
+    }
+
+    constexpr iterator end() const {
+        return iterator(base_.end(), base_.end(), n_);
+    }
+
+    template<typename B = V, typename = std::enable_if_t<kRangeSized<B>>>
+    constexpr std::size_t size() const {
+        return (range_size(base_) + n_ - 1) / n_;
+    }
+
+private:
+    V base_;
+    std::size_t n_;
+};
+
+//多个范围同步前进，任何一个到达末尾就结束，元素是引用组成的tuple
+template<typename... Vs>
+class zip_view : public view_base {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::tuple<decltype(*std::declval<const decltype(std::declval<const Vs&>().begin())&>())...>;
+        using value_type = reference;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+
+        constexpr iterator() = default;
+
+        constexpr explicit iterator(std::tuple<decltype(std::declval<const Vs&>().begin())...> cur) : cur_(cur) {}
+
+        constexpr reference operator*() const {
+            return std::apply([](const auto&... it) { return reference(*it...); }, cur_);
+        }
+
+        constexpr iterator& operator++() {
+            std::apply([](auto&... it) { (++it, ...); }, cur_);
+            return *this;
+        }
+
+        constexpr iterator operator++(int) {
+            iterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        //和end比较时任一分量相等即结束，所以长度取最短的那个
+        constexpr bool operator==(const iterator& it) const {
+            return any_equal(it, std::index_sequence_for<Vs...>());
+        }
+
+        constexpr bool operator!=(const iterator& it) const {
+            return !(*this == it);
+        }
+
+    private:
+        template<std::size_t... Is>
+        constexpr bool any_equal(const iterator& it, std::index_sequence<Is...>) const {
+            return ((std::get<Is>(cur_) == std::get<Is>(it.cur_)) || ...);
+        }
+
+        std::tuple<decltype(std::declval<const Vs&>().begin())...> cur_;
+    };
+
+    constexpr explicit zip_view(Vs... bases) : bases_(std::move(bases)...) {}
+
+    constexpr iterator begin() const {
+        return iterator(std::apply([](const auto&... b) { return std::make_tuple(b.begin()...); }, bases_));
+    }
+
+    constexpr iterator end() const {
+        return iterator(std::apply([](const auto&... b) { return std::make_tuple(b.end()...); }, bases_));
+    }
+
+    template<typename B = std::tuple<Vs...>, typename = std::enable_if_t<(kRangeSized<Vs> && ...)>>
+    constexpr std::size_t size() const {
+        return std::apply([](const auto&... b) {
+            std::size_t n = std::size_t(-1);
+            ((n = range_size(b) < n ? range_size(b) : n), ...);
+            return n;
+        }, bases_);
+    }
+
+private:
+    std::tuple<Vs...> bases_;
+};
+
+//元素是(下标, 引用)
+template<typename V>
+class enumerate_view : public view_base {
+    using BaseIterator = decltype(std::declval<const V&>().begin());
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::pair<std::size_t, decltype(*std::declval<const BaseIterator&>())>;
+        using value_type = reference;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+
+        constexpr iterator() = default;
+
+        constexpr iterator(BaseIterator cur, std::size_t index) : cur_(cur), index_(index) {}
+
+        constexpr reference operator*() const {
+            return reference(index_, *cur_);
+        }
+
+        constexpr iterator& operator++() {
+            ++cur_;
+            ++index_;
+            return *this;
+        }
+
+        constexpr iterator operator++(int) {
+            iterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        constexpr bool operator==(const iterator& it) const {
+            return cur_ == it.cur_;
+        }
+
+        constexpr bool operator!=(const iterator& it) const {
+            return !(cur_ == it.cur_);
+        }
+
+    private:
+        BaseIterator cur_{};
+        std::size_t index_ = 0;
+    };
+
+    constexpr explicit enumerate_view(V base) : base_(std::move(base)) {}
+
+    constexpr iterator begin() const {
+        return iterator(base_.begin(), 0);
+    }
+
+    constexpr iterator end() const {
+        return iterator(base_.end(), 0);
+    }
+
+    template<typename B = V, typename = std::enable_if_t<kRangeSized<B>>>
+    constexpr std::size_t size() const {
+        return range_size(base_);
+    }
+
+private:
+    V base_;
+};
+
+namespace views {
+
+template<typename R, typename Pred, typename = std::enable_if_t<kRangeIsRange<R>>>
+constexpr auto filter(R&& r, Pred pred) {
+    return filter_view<RangeAll<R>, Pred>(all(std::forward<R>(r)), std::move(pred));
+}
+
+template<typename Pred>
+constexpr auto filter(Pred pred) {
+    return RangeAdaptorClosure([pred](auto&& r) { return views::filter(std::forward<decltype(r)>(r), pred); });
+}
+
+template<typename R, typename F, typename = std::enable_if_t<kRangeIsRange<R>>>
+constexpr auto transform(R&& r, F f) {
+    return transform_view<RangeAll<R>, F>(all(std::forward<R>(r)), std::move(f));
+}
+
+template<typename F>
+constexpr auto transform(F f) {
+    return RangeAdaptorClosure([f](auto&& r) { return views::transform(std::forward<decltype(r)>(r), f); });
+}
+
+template<typename R, typename = std::enable_if_t<kRangeIsRange<R>>>
+constexpr auto take(R&& r, std::size_t n) {
+    return take_view<RangeAll<R>>(all(std::forward<R>(r)), n);
+}
+
+constexpr auto take(std::size_t n) {
+    return RangeAdaptorClosure([n](auto&& r) { return views::take(std::forward<decltype(r)>(r), n); });
+}
+
+template<typename R, typename = std::enable_if_t<kRangeIsRange<R>>>
+constexpr auto drop(R&& r, std::size_t n) {
+    return drop_view<RangeAll<R>>(all(std::forward<R>(r)), n);
+}
+
+constexpr auto drop(std::size_t n) {
+    return RangeAdaptorClosure([n](auto&& r) { return views::drop(std::forward<decltype(r)>(r), n); });
+}
+
+//n必须大于0
+template<typename R, typename = std::enable_if_t<kRangeIsRange<R>>>
+constexpr auto chunk(R&& r, std::size_t n) {
+    return chunk_view<RangeAll<R>>(all(std::forward<R>(r)), n);
+}
+
+constexpr auto chunk(std::size_t n) {
+    return RangeAdaptorClosure([n](auto&& r) { return views::chunk(std::forward<decltype(r)>(r), n); });
+}
+
+template<typename... Rs, typename = std::enable_if_t<(sizeof...(Rs) > 0) && (kRangeIsRange<Rs> && ...)>>
+constexpr auto zip(Rs&&... rs) {
+    return zip_view<RangeAll<Rs>...>(all(std::forward<Rs>(rs))...);
+}
+
+//r | views::enumerate 或 views::enumerate(r)
+inline constexpr RangeAdaptorClosure enumerate([](auto&& r) {
+    return enumerate_view<RangeAll<decltype(r)>>(all(std::forward<decltype(r)>(r)));
+});
+
+}
+
+//容器元素的类型：去掉引用，pair/tuple中的引用也去掉，zip和enumerate的结果可以直接存
+template<typename T>
+struct RangeStored {
+    using type = std::remove_cv_t<std::remove_reference_t<T>>;
+};
+
+template<typename A, typename B>
+struct RangeStored<std::pair<A, B>> {
+    using type = std::pair<typename RangeStored<A>::type, typename RangeStored<B>::type>;
+};
+
+template<typename... Ts>
+struct RangeStored<std::tuple<Ts...>> {
+    using type = std::tuple<typename RangeStored<Ts>::type...>;
+};
+
+template<typename R>
+using RangeValue = typename RangeStored<std::remove_cv_t<std::remove_reference_t<RangeReference<R>>>>::type;
+
+template<typename C, typename = void>
+struct RangeHasReserve : std::false_type {};
+
+template<typename C>
+struct RangeHasReserve<C, std::void_t<decltype(std::declval<C&>().reserve(std::size_t(0)))>> : std::true_type {};
+
+//把范围物化成容器C<元素类型>，长度已知并且C支持reserve时只分配一次
+template<template<typename...> class C, typename R, typename = std::enable_if_t<kRangeIsRange<R>>>
+constexpr auto to(R&& r) {
+    using Container = C<RangeValue<std::remove_reference_t<R>>>;
+    Container c;
+    if constexpr (RangeHasReserve<Container>::value && kRangeSized<std::remove_reference_t<R>>) {
+        c.reserve(range_size(r));
+    }
+    for (auto it = r.begin(), last = r.end(); it != last; ++it) {
+        c.push_back(*it);
+    }
+    return c;
+}
+
+template<template<typename...> class C>
+constexpr auto to() {
+    return RangeAdaptorClosure([](auto&& r) { return ycstl::to<C>(std::forward<decltype(r)>(r)); });
+}
+
+}   //ycstl
+
+#endif
@@ -0,0 +1,143 @@
+/**
+ * 实现rcu_vector
+ *
+ * 读多写少的vector：读者通过read()拿到当前版本的只读视图，不加锁也不修改任何共享计数；
+ * 写者拷贝当前版本、修改后整体发布，旧版本交给epoch_domain延迟释放
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef RCU_VECTOR_HPP_
+#define RCU_VECTOR_HPP_
+
+#include "epoch.hpp"
+#include "vector.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace ycstl {
+
+template<typename T>
+class rcu_vector {
+public:
+    using vector_type     = ycstl::vector<T>;
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using const_reference = const T&;
+    using const_iterator  = const T*;
+
+    //只读视图，存活期间对应的版本不会被释放
+    class read_view {
+    public:
+        read_view(epoch_domain::guard guard, const vector_type* v) noexcept
+            : guard_(std::move(guard)), v_(v) {}
+
+        const vector_type& get() const noexcept {
+            return *v_;
+        }
+
+        const vector_type& operator*() const noexcept {
+            return *v_;
+        }
+
+        const vector_type* operator->() const noexcept {
+            return v_;
+        }
+
+        size_type size() const noexcept {
+            return v_->size();
+        }
+
+        bool empty() const noexcept {
+            return v_->empty();
+        }
+
+        const_reference operator[](size_type pos) const {
+            return (*v_)[pos];
+        }
+
+        const T* data() const noexcept {
+            return v_->data();
+        }
+
+        const_iterator begin() const noexcept {
+            return v_->data();
+        }
+
+        const_iterator end() const noexcept {
+            return v_->data() + v_->size();
+        }
+
+    private:
+        epoch_domain::guard guard_;
+        const vector_type* v_;
+    };
+
+    explicit rcu_vector(epoch_domain& domain = epoch_domain::global())
+        : domain_(domain), current_(new vector_type()) {}
+
+    explicit rcu_vector(vector_type initial, epoch_domain& domain = epoch_domain::global())
+        : domain_(domain), current_(new vector_type(std::move(initial))) {}
+
+    //析构时不能再有读者持有视图
+    ~rcu_vector() {
+        delete current_.load(std::memory_order_relaxed);
+    }
+
+    rcu_vector(const rcu_vector&) = delete;
+    rcu_vector& operator=(const rcu_vector&) = delete;
+
+    read_view read() const {
+        epoch_domain::guard guard = domain_.pin();
+        const vector_type* v = current_.load(std::memory_order_acquire);
+        return read_view(std::move(guard), v);
+    }
+
+    //当前版本的拷贝
+    vector_type snapshot() const {
+        read_view view = read();
+        return vector_type(view.get());
+    }
+
+    //在当前版本的拷贝上调用f(vector_type&)，然后发布；写者之间互斥
+    template<typename Function, typename = std::enable_if_t<
+        std::is_invocable_v<Function, vector_type&>
+    >>
+    void update(Function f) {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        vector_type* next = new vector_type(*current_.load(std::memory_order_relaxed));
+        try {
+            f(*next);
+        } catch (...) {
+            delete next;
+            throw;
+        }
+        publish(next);
+    }
+
+    void store(vector_type v) {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        publish(new vector_type(std::move(v)));
+    }
+
+    epoch_domain& domain() const noexcept {
+        return domain_;
+    }
+
+private:
+    void publish(vector_type* next) {
+        vector_type* old = current_.exchange(next, std::memory_order_acq_rel);
+        domain_.template retire<vector_type>(old);
+    }
+
+    epoch_domain& domain_;
+    std::atomic<vector_type*> current_;
+    std::mutex writer_mutex_;
+};
+
+}   //ycstl
+
+#endif
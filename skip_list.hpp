@@ -0,0 +1,522 @@
+/**
+ * 实现skip_list
+ * SkipListNode
+ * skip_list
+ *
+ * 有序容器，skip_list<Key>为集合，skip_list<Key, T>为映射
+ * 节点沿用ListNode的next_链接方式，并扩展为一座高度可变的指针塔，节点与塔在同一块内存中分配
+ *
+ * 并发约定：insert/emplace/find/lower_bound/upper_bound/遍历 之间可以任意并发，插入是无锁的(CAS)；
+ *           erase/clear/赋值/析构 需要独占访问
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef SKIP_LIST_HPP_
+#define SKIP_LIST_HPP_
+
+#include "memory.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ycstl {
+
+template<typename V>
+struct SkipListNode {
+    V value_;
+    int height_;
+    std::atomic<SkipListNode*> next_[1];     // 实际长度为height_，与节点一起分配
+};
+
+template<typename Key, typename T = void, typename Compare = std::less<Key>,
+         typename Allocator = std::allocator<std::conditional_t<std::is_void_v<T>, Key, std::pair<const Key, T>>>>
+class skip_list {
+    static constexpr bool is_set = std::is_void_v<T>;
+
+    using Node = SkipListNode<std::conditional_t<is_set, Key, std::pair<const Key, T>>>;
+    using NodePtr = Node*;
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using NodeAllocator = typename AllocTraits::template rebind_alloc<Node>;
+
+    static constexpr int kMaxHeight = 20;       // 每层晋升概率1/4，足够容纳4^20个元素
+
+    template<bool Const>
+    class Iterator;
+
+public:
+    using key_type               = Key;
+    using mapped_type            = T;
+    using value_type             = std::conditional_t<is_set, Key, std::pair<const Key, T>>;
+    using key_compare            = Compare;
+    using allocator_type         = Allocator;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using iterator               = Iterator<is_set>;        // 集合的元素不能修改
+    using const_iterator         = Iterator<true>;
+
+    skip_list() : skip_list(Compare(), Allocator()) {}
+
+    explicit skip_list(const Compare& comp, const Allocator& alloc = Allocator())
+        : comp_(comp), alloc_(alloc), max_height_(1), size_(0) {
+        head_ = allocate_node(kMaxHeight);
+    }
+
+    template<typename InputIter, typename = std::void_t<
+        decltype(*std::declval<InputIter>()),
+        decltype(++std::declval<InputIter&>())
+    >>
+    skip_list(InputIter first, InputIter last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : skip_list(comp, alloc) {
+        for (InputIter it = first; it != last; ++it) {
+            insert(*it);
+        }
+    }
+
+    skip_list(std::initializer_list<value_type> il, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : skip_list(il.begin(), il.end(), comp, alloc) {}
+
+    //拷贝构造，分配器由select_on_container_copy_construction决定
+    skip_list(const skip_list& x)
+        : skip_list(x.begin(), x.end(), x.comp_, AllocTraits::select_on_container_copy_construction(x.alloc_)) {}
+
+    skip_list(skip_list&& x) : skip_list(x.comp_, x.alloc_) {
+        swap(x);
+    }
+
+    ~skip_list() {
+        clear();
+        deallocate_node(head_);
+    }
+
+    skip_list& operator=(const skip_list& other) {
+        if (&other == this) {
+            return *this;
+        }
+        clear();
+        for (const_iterator it = other.begin(); it != other.end(); ++it) {
+            insert(*it);
+        }
+        return *this;
+    }
+
+    //分配器传播或相等时直接接管other的节点，否则只能逐个移动元素
+    skip_list& operator=(skip_list&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value ||
+                                                   AllocTraits::is_always_equal::value) {
+        if (&other == this) {
+            return *this;
+        }
+        clear();
+        comp_ = other.comp_;
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            //空的head_随旧分配器一起交给other，由它释放
+            using std::swap;
+            swap(alloc_, other.alloc_);
+            swap_nodes(other);
+            return *this;
+        } else if (alloc_ == other.alloc_) {
+            swap_nodes(other);
+            return *this;
+        }
+        for (NodePtr node = next_of(other.head_, 0); nullptr != node; node = next_of(node, 0)) {
+            emplace(std::move(node->value_));
+        }
+        other.clear();
+        return *this;
+    }
+
+    iterator begin() noexcept {
+        return iterator(next_of(head_, 0));
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(next_of(head_, 0));
+    }
+
+    iterator end() noexcept {
+        return iterator(nullptr);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(nullptr);
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    bool empty() const noexcept {
+        return nullptr == next_of(head_, 0);
+    }
+
+    // 并发插入时只是近似值
+    size_type size() const noexcept {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        NodePtr node = create_node(random_height(), std::forward<Args>(args)...);
+        NodePtr existing = link_node(node);
+        if (nullptr != existing) {
+            destroy_node(node);
+            return {iterator(existing), false};
+        }
+        return {iterator(node), true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return emplace(value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return emplace(std::move(value));
+    }
+
+    template<typename U = T, typename = std::enable_if_t<!std::is_void_v<U>>>
+    U& operator[](const Key& key) {
+        NodePtr node = find_node(key);
+        if (nullptr != node) {
+            return node->value_.second;
+        }
+        return emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first->second;
+    }
+
+    template<typename U = T, typename = std::enable_if_t<!std::is_void_v<U>>>
+    U& at(const Key& key) {
+        NodePtr node = find_node(key);
+        if (nullptr == node) {
+            throw std::out_of_range("key not found");
+        }
+        return node->value_.second;
+    }
+
+    iterator find(const Key& key) {
+        return iterator(find_node(key));
+    }
+
+    const_iterator find(const Key& key) const {
+        return const_iterator(find_node(key));
+    }
+
+    bool contains(const Key& key) const {
+        return nullptr != find_node(key);
+    }
+
+    size_type count(const Key& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    // 第一个不小于key的元素
+    iterator lower_bound(const Key& key) {
+        return iterator(lower_bound_node(key));
+    }
+
+    const_iterator lower_bound(const Key& key) const {
+        return const_iterator(lower_bound_node(key));
+    }
+
+    // 第一个大于key的元素
+    iterator upper_bound(const Key& key) {
+        NodePtr node = lower_bound_node(key);
+        if (nullptr != node && !comp_(key, key_of(node->value_))) {
+            node = next_of(node, 0);
+        }
+        return iterator(node);
+    }
+
+    const_iterator upper_bound(const Key& key) const {
+        return const_cast<skip_list*>(this)->upper_bound(key);
+    }
+
+    // 区间扫描，对[first_key, last_key)内的元素依次调用f
+    template<typename Function>
+    void for_each_in_range(const Key& first_key, const Key& last_key, Function f) const {
+        for (NodePtr node = lower_bound_node(first_key);
+             nullptr != node && comp_(key_of(node->value_), last_key);
+             node = next_of(node, 0)) {
+            f(static_cast<const value_type&>(node->value_));
+        }
+    }
+
+    // 需要独占访问
+    size_type erase(const Key& key) {
+        NodePtr preds[kMaxHeight];
+        NodePtr node = find_splice(key, preds, nullptr);
+        if (nullptr == node || comp_(key, key_of(node->value_))) {
+            return 0;
+        }
+        for (int level = 0; level != node->height_; ++level) {
+            preds[level]->next_[level].store(next_of(node, level), std::memory_order_relaxed);
+        }
+        destroy_node(node);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return 1;
+    }
+
+    iterator erase(const_iterator position) {
+        NodePtr next = next_of(position.cur_, 0);
+        erase(key_of(position.cur_->value_));
+        return iterator(next);
+    }
+
+    // 需要独占访问
+    void clear() noexcept {
+        NodePtr node = next_of(head_, 0);
+        while (nullptr != node) {
+            NodePtr next = next_of(node, 0);
+            destroy_node(node);
+            node = next;
+        }
+        for (int level = 0; level != kMaxHeight; ++level) {
+            head_->next_[level].store(nullptr, std::memory_order_relaxed);
+        }
+        max_height_.store(1, std::memory_order_relaxed);
+        size_.store(0, std::memory_order_relaxed);
+    }
+
+    //propagate_on_container_swap为false时两个分配器必须相等
+    void swap(skip_list& x) noexcept(AllocTraits::is_always_equal::value) {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc_, x.alloc_);
+        }
+        std::swap(comp_, x.comp_);
+        swap_nodes(x);
+    }
+
+    key_compare key_comp() const {
+        return comp_;
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return alloc_;
+    }
+
+private:
+    //只交换头节点和计数，分配器由调用方处理
+    void swap_nodes(skip_list& x) noexcept {
+        std::swap(head_, x.head_);
+        int height = max_height_.load(std::memory_order_relaxed);
+        max_height_.store(x.max_height_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        x.max_height_.store(height, std::memory_order_relaxed);
+        size_type n = size_.load(std::memory_order_relaxed);
+        size_.store(x.size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        x.size_.store(n, std::memory_order_relaxed);
+    }
+
+    static const Key& key_of(const value_type& value) noexcept {
+        if constexpr (is_set) {
+            return value;
+        } else {
+            return value.first;
+        }
+    }
+
+    static NodePtr next_of(NodePtr node, int level) noexcept {
+        return node->next_[level].load(std::memory_order_acquire);
+    }
+
+    //高度为height的节点需要多少个Node大小的单元
+    static std::size_t node_units(int height) noexcept {
+        std::size_t bytes = sizeof(Node) + (height - 1) * sizeof(std::atomic<NodePtr>);
+        return (bytes + sizeof(Node) - 1) / sizeof(Node);
+    }
+
+    NodePtr allocate_node(int height) {
+        NodeAllocator node_alloc{alloc_};
+        NodePtr node = node_alloc.allocate(node_units(height));
+        node->height_ = height;
+        for (int level = 0; level != height; ++level) {
+            std::construct_at(&node->next_[level], nullptr);
+        }
+        return node;
+    }
+
+    void deallocate_node(NodePtr node) noexcept {
+        NodeAllocator node_alloc{alloc_};
+        node_alloc.deallocate(node, node_units(node->height_));
+    }
+
+    template<typename... Args>
+    NodePtr create_node(int height, Args&&... args) {
+        NodePtr node = allocate_node(height);
+        try {
+            AllocTraits::construct(alloc_, &node->value_, std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate_node(node);
+            throw;
+        }
+        return node;
+    }
+
+    void destroy_node(NodePtr node) noexcept {
+        AllocTraits::destroy(alloc_, &node->value_);
+        deallocate_node(node);
+    }
+
+    //几何分布的随机高度，每个线程独立的xorshift状态
+    static int random_height() noexcept {
+        thread_local std::uint64_t state = reinterpret_cast<std::uintptr_t>(&state) | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        std::uint64_t r = state;
+        int height = 1;
+        while (height < kMaxHeight && 0 == (r & 3)) {
+            ++height;
+            r >>= 2;
+        }
+        return height;
+    }
+
+    //从x开始在level层向右走，直到下一个节点不小于key
+    NodePtr walk(NodePtr x, int level, const Key& key, NodePtr& next) const {
+        next = next_of(x, level);
+        while (nullptr != next && comp_(key_of(next->value_), key)) {
+            x = next;
+            next = next_of(x, level);
+        }
+        return x;
+    }
+
+    //记录每一层最后一个小于key的节点，返回第0层第一个不小于key的节点
+    NodePtr find_splice(const Key& key, NodePtr* preds, NodePtr* succs) const {
+        NodePtr x = head_;
+        NodePtr next = nullptr;
+        for (int level = max_height_.load(std::memory_order_acquire) - 1; level >= 0; --level) {
+            x = walk(x, level, key, next);
+            preds[level] = x;
+            if (nullptr != succs) {
+                succs[level] = next;
+            }
+        }
+        return next;
+    }
+
+    NodePtr lower_bound_node(const Key& key) const {
+        NodePtr x = head_;
+        NodePtr next = nullptr;
+        for (int level = max_height_.load(std::memory_order_acquire) - 1; level >= 0; --level) {
+            x = walk(x, level, key, next);
+        }
+        return next;
+    }
+
+    NodePtr find_node(const Key& key) const {
+        NodePtr node = lower_bound_node(key);
+        if (nullptr != node && !comp_(key, key_of(node->value_))) {
+            return node;
+        }
+        return nullptr;
+    }
+
+    // 无锁插入：自底向上逐层CAS，第0层成功即对读者可见；key已存在时返回已有节点
+    NodePtr link_node(NodePtr node) {
+        const Key& key = key_of(node->value_);
+        NodePtr preds[kMaxHeight];
+        NodePtr succs[kMaxHeight];
+        int height = node->height_;
+
+        // 先抬高max_height_，随后的定位会覆盖到新节点的每一层
+        int cur_height = max_height_.load(std::memory_order_acquire);
+        while (height > cur_height &&
+               !max_height_.compare_exchange_weak(cur_height, height, std::memory_order_acq_rel)) {
+        }
+
+        NodePtr first = find_splice(key, preds, succs);
+        if (nullptr != first && !comp_(key, key_of(first->value_))) {
+            return first;
+        }
+        for (int level = 0; level != height; ++level) {
+            while (true) {
+                node->next_[level].store(succs[level], std::memory_order_relaxed);
+                if (preds[level]->next_[level].compare_exchange_strong(
+                        succs[level], node, std::memory_order_release, std::memory_order_acquire)) {
+                    break;
+                }
+                // 其他线程在pred之后插入了节点，从pred继续向右定位
+                preds[level] = walk(preds[level], level, key, succs[level]);
+                if (0 == level && nullptr != succs[0] && !comp_(key, key_of(succs[0]->value_))) {
+                    return succs[0];
+                }
+            }
+        }
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+private:
+    NodePtr head_;
+    YCSTL_NO_UNIQUE_ADDRESS Compare comp_;
+    YCSTL_NO_UNIQUE_ADDRESS Allocator alloc_;
+    std::atomic<int> max_height_;
+    std::atomic<size_type> size_;
+
+    template<bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = skip_list::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+        Iterator() : cur_(nullptr) {}
+
+        explicit Iterator(NodePtr cur) : cur_(cur) {}
+
+        template<bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& it) : cur_(it.cur_) {} // 允许从 iterator 转换成 const_iterator
+
+        reference operator*() const {
+            return cur_->value_;
+        }
+
+        pointer operator->() const {
+            return &(cur_->value_);
+        }
+
+        Iterator& operator++() {
+            cur_ = next_of(cur_, 0);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator it(cur_);
+            cur_ = next_of(cur_, 0);
+            return it;
+        }
+
+        bool operator==(const Iterator& it) const {
+            return cur_ == it.cur_;
+        }
+
+        bool operator!=(const Iterator& it) const {
+            return cur_ != it.cur_;
+        }
+
+    private:
+        NodePtr cur_;
+        friend class skip_list;
+        template<bool>
+        friend class Iterator;
+    };
+};
+
+}   //ycstl
+
+#endif
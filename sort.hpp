@@ -0,0 +1,658 @@
+/**
+ * 实现sort
+ * sort / sort_branchless / stable_sort / radix_sort / stable_radix_sort
+ *
+ * sort是pattern-defeating quicksort：小区间插入排序，大区间用ninther选轴；
+ * 划分后发现序列本来就有序时用有限次数的插入排序直接收尾，两侧极不平衡时打乱选轴，
+ * 坏划分次数超过log(n)退化为堆排序，保证O(n log n)；
+ * 算术类型配合std::less / std::greater时用分块的无分支划分，先把比较结果写进偏移量缓冲再批量交换，
+ * 不再依赖分支预测；
+ * stable_sort是归并排序，需要n/2个元素的临时空间；
+ * radix_sort按字节从高到低原地分桶(American flag sort)，stable_radix_sort按字节从低到高，
+ * 需要n个元素的临时空间，两者的key都由取key的函数对象给出，可以是整数或浮点数；
+ * 临时空间可以由调用方传入已构造好的元素，反复排序时避免每次分配
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef SORT_HPP_
+#define SORT_HPP_
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace ycstl {
+
+inline constexpr std::size_t kSortInsertionThreshold = 24;
+inline constexpr std::size_t kSortNintherThreshold = 128;
+inline constexpr std::size_t kSortPartialInsertionLimit = 8;
+inline constexpr std::size_t kSortBlockSize = 64;
+inline constexpr std::size_t kSortMergeThreshold = 32;
+inline constexpr std::size_t kRadixSortThreshold = 64;
+
+//取key的默认函数对象，元素本身就是key
+struct identity_key {
+    template<typename T>
+    constexpr const T& operator()(const T& value) const noexcept {
+        return value;
+    }
+};
+
+template<typename Compare, typename T>
+struct SortIsDefaultCompare : std::false_type {};
+
+template<typename T>
+struct SortIsDefaultCompare<std::less<T>, T> : std::true_type {};
+
+template<typename T>
+struct SortIsDefaultCompare<std::less<>, T> : std::true_type {};
+
+template<typename T>
+struct SortIsDefaultCompare<std::greater<T>, T> : std::true_type {};
+
+template<typename T>
+struct SortIsDefaultCompare<std::greater<>, T> : std::true_type {};
+
+//比较便宜、没有副作用时才值得用无分支划分
+template<typename Compare, typename T>
+inline constexpr bool kSortUseBranchless = SortIsDefaultCompare<Compare, T>::value && std::is_arithmetic_v<T>;
+
+template<typename Iter, typename Compare>
+void insertion_sort(Iter begin, Iter end, Compare& comp) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    if (begin == end) {
+        return;
+    }
+    for (Iter cur = begin + 1; cur != end; ++cur) {
+        Iter sift = cur;
+        Iter sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (sift != begin && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+//调用方保证*(begin - 1)不大于区间内任何元素，内层循环省去边界判断
+template<typename Iter, typename Compare>
+void unguarded_insertion_sort(Iter begin, Iter end, Compare& comp) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    if (begin == end) {
+        return;
+    }
+    for (Iter cur = begin + 1; cur != end; ++cur) {
+        Iter sift = cur;
+        Iter sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+//移动次数超过kSortPartialInsertionLimit就放弃并返回false，区间处于中间状态但元素不丢失
+template<typename Iter, typename Compare>
+bool partial_insertion_sort(Iter begin, Iter end, Compare& comp) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    if (begin == end) {
+        return true;
+    }
+    std::size_t moved = 0;
+    for (Iter cur = begin + 1; cur != end; ++cur) {
+        Iter sift = cur;
+        Iter sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (sift != begin && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+            moved += cur - sift;
+        }
+        if (moved > kSortPartialInsertionLimit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Iter, typename Compare>
+void sort2(Iter a, Iter b, Compare& comp) {
+    if (comp(*b, *a)) {
+        std::iter_swap(a, b);
+    }
+}
+
+template<typename Iter, typename Compare>
+void sort3(Iter a, Iter b, Iter c, Compare& comp) {
+    sort2(a, b, comp);
+    sort2(b, c, comp);
+    sort2(a, b, comp);
+}
+
+//把左侧偏移处的元素与右侧偏移处的元素成对交换；两边数量相等时用swap，否则轮转一圈少一半移动
+template<typename Iter>
+void swap_offsets(Iter first, Iter last, const unsigned char* offsets_l, const unsigned char* offsets_r,
+                  std::size_t num, bool use_swaps) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    if (use_swaps) {
+        for (std::size_t i = 0; i != num; ++i) {
+            std::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+        }
+    } else if (0 != num) {
+        Iter l = first + offsets_l[0];
+        Iter r = last - offsets_r[0];
+        T tmp(std::move(*l));
+        *l = std::move(*r);
+        for (std::size_t i = 1; i != num; ++i) {
+            l = first + offsets_l[i];
+            *r = std::move(*l);
+            r = last - offsets_r[i];
+            *l = std::move(*r);
+        }
+        *r = std::move(tmp);
+    }
+}
+
+//以*begin为轴划分，等于轴的元素放到右边；返回轴的最终位置，以及划分前是否已经分好
+template<typename Iter, typename Compare>
+std::pair<Iter, bool> partition_right(Iter begin, Iter end, Compare& comp) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    T pivot(std::move(*begin));
+    Iter first = begin;
+    Iter last = end;
+    //轴是三数取中，左边一定有不小于轴的元素，右边一定有小于轴的元素，除非是第一次往右找
+    while (comp(*++first, pivot)) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {
+        }
+    } else {
+        while (!comp(*--last, pivot)) {
+        }
+    }
+    bool already_partitioned = first >= last;
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (comp(*++first, pivot)) {
+        }
+        while (!comp(*--last, pivot)) {
+        }
+    }
+    Iter pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return std::make_pair(pivot_pos, already_partitioned);
+}
+
+//与partition_right相同，但每次取kSortBlockSize个元素，先无分支地记下需要交换的偏移量
+template<typename Iter, typename Compare>
+std::pair<Iter, bool> partition_right_branchless(Iter begin, Iter end, Compare& comp) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    T pivot(std::move(*begin));
+    Iter first = begin;
+    Iter last = end;
+    while (comp(*++first, pivot)) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {
+        }
+    } else {
+        while (!comp(*--last, pivot)) {
+        }
+    }
+    bool already_partitioned = first >= last;
+    if (!already_partitioned) {
+        std::iter_swap(first, last);
+        ++first;
+
+        alignas(64) unsigned char offsets_l[kSortBlockSize];
+        alignas(64) unsigned char offsets_r[kSortBlockSize];
+        Iter offsets_l_base = first;
+        Iter offsets_r_base = last;
+        std::size_t num_l = 0;
+        std::size_t num_r = 0;
+        std::size_t start_l = 0;
+        std::size_t start_r = 0;
+        while (first < last) {
+            //剩下的不足两块时，把未知部分分给偏移量已经用完的一侧
+            std::size_t num_unknown = last - first;
+            std::size_t left_split = 0 == num_l ? (0 == num_r ? num_unknown / 2 : num_unknown) : 0;
+            std::size_t right_split = 0 == num_r ? num_unknown - left_split : 0;
+
+            if (left_split >= kSortBlockSize) {
+                for (std::size_t i = 0; i != kSortBlockSize; ++i) {
+                    offsets_l[num_l] = static_cast<unsigned char>(i);
+                    num_l += !comp(*first, pivot);
+                    ++first;
+                }
+            } else {
+                for (std::size_t i = 0; i != left_split; ++i) {
+                    offsets_l[num_l] = static_cast<unsigned char>(i);
+                    num_l += !comp(*first, pivot);
+                    ++first;
+                }
+            }
+
+            if (right_split >= kSortBlockSize) {
+                for (std::size_t i = 1; i <= kSortBlockSize; ++i) {
+                    offsets_r[num_r] = static_cast<unsigned char>(i);
+                    num_r += comp(*--last, pivot);
+                }
+            } else {
+                for (std::size_t i = 1; i <= right_split; ++i) {
+                    offsets_r[num_r] = static_cast<unsigned char>(i);
+                    num_r += comp(*--last, pivot);
+                }
+            }
+
+            std::size_t num = std::min(num_l, num_r);
+            swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if (0 == num_l) {
+                start_l = 0;
+                offsets_l_base = first;
+            }
+            if (0 == num_r) {
+                start_r = 0;
+                offsets_r_base = last;
+            }
+        }
+
+        //一侧还有没交换出去的元素，逐个换到分界处
+        if (0 != num_l) {
+            while (0 != num_l--) {
+                std::iter_swap(offsets_l_base + offsets_l[start_l + num_l], --last);
+            }
+            first = last;
+        }
+        if (0 != num_r) {
+            while (0 != num_r--) {
+                std::iter_swap(offsets_r_base - offsets_r[start_r + num_r], first);
+                ++first;
+            }
+            last = first;
+        }
+    }
+    Iter pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return std::make_pair(pivot_pos, already_partitioned);
+}
+
+//等于轴的元素放到左边，用于左邻元素等于轴的情况：左边整段都等于轴，不需要再排
+template<typename Iter, typename Compare>
+Iter partition_left(Iter begin, Iter end, Compare& comp) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    T pivot(std::move(*begin));
+    Iter first = begin;
+    Iter last = end;
+    while (comp(pivot, *--last)) {
+    }
+    if (last + 1 == end) {
+        while (first < last && !comp(pivot, *++first)) {
+        }
+    } else {
+        while (!comp(pivot, *++first)) {
+        }
+    }
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (comp(pivot, *--last)) {
+        }
+        while (!comp(pivot, *++first)) {
+        }
+    }
+    Iter pivot_pos = last;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+//bad_allowed为还允许的坏划分次数；leftmost为false时*(begin - 1)是左侧区间的最大元素
+template<bool Branchless, typename Iter, typename Compare>
+void pdqsort_loop(Iter begin, Iter end, Compare& comp, int bad_allowed, bool leftmost = true) {
+    using Diff = typename std::iterator_traits<Iter>::difference_type;
+    for (;;) {
+        Diff size = end - begin;
+        if (size < Diff(kSortInsertionThreshold)) {
+            if (leftmost) {
+                insertion_sort(begin, end, comp);
+            } else {
+                unguarded_insertion_sort(begin, end, comp);
+            }
+            return;
+        }
+
+        //选出的轴放到*begin
+        Diff s2 = size / 2;
+        if (size > Diff(kSortNintherThreshold)) {
+            sort3(begin, begin + s2, end - 1, comp);
+            sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+            sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+            sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+            std::iter_swap(begin, begin + s2);
+        } else {
+            sort3(begin + s2, begin, end - 1, comp);
+        }
+
+        //轴等于左侧区间的最大元素，说明有大量重复，等于轴的一段直接跳过
+        if (!leftmost && !comp(*(begin - 1), *begin)) {
+            begin = partition_left(begin, end, comp) + 1;
+            continue;
+        }
+
+        std::pair<Iter, bool> part;
+        if constexpr (Branchless) {
+            part = partition_right_branchless(begin, end, comp);
+        } else {
+            part = partition_right(begin, end, comp);
+        }
+        Iter pivot_pos = part.first;
+        bool already_partitioned = part.second;
+
+        Diff l_size = pivot_pos - begin;
+        Diff r_size = end - (pivot_pos + 1);
+        bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+        if (highly_unbalanced) {
+            if (0 == --bad_allowed) {
+                std::make_heap(begin, end, comp);
+                std::sort_heap(begin, end, comp);
+                return;
+            }
+            //把两侧的若干元素换一换，打破让选轴失效的模式
+            if (l_size >= Diff(kSortInsertionThreshold)) {
+                std::iter_swap(begin, begin + l_size / 4);
+                std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                if (l_size > Diff(kSortNintherThreshold)) {
+                    std::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+                    std::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+                    std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+            if (r_size >= Diff(kSortInsertionThreshold)) {
+                std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                std::iter_swap(end - 1, end - r_size / 4);
+                if (r_size > Diff(kSortNintherThreshold)) {
+                    std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    std::iter_swap(end - 2, end - (1 + r_size / 4));
+                    std::iter_swap(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        } else if (already_partitioned && partial_insertion_sort(begin, pivot_pos, comp) &&
+                   partial_insertion_sort(pivot_pos + 1, end, comp)) {
+            //划分前就已经分好，并且两侧都几乎有序
+            return;
+        }
+
+        //递归较左的一侧，右侧继续循环
+        pdqsort_loop<Branchless>(begin, pivot_pos, comp, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+template<bool Branchless, typename Iter, typename Compare>
+void pdqsort(Iter first, Iter last, Compare& comp) {
+    if (last - first < 2) {
+        return;
+    }
+    int bad_allowed = std::bit_width(static_cast<std::size_t>(last - first));
+    pdqsort_loop<Branchless>(first, last, comp, bad_allowed);
+}
+
+//不稳定排序，最坏O(n log n)
+template<typename RandomIt, typename Compare = std::less<>>
+void sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    pdqsort<kSortUseBranchless<Compare, T>>(first, last, comp);
+}
+
+//强制使用无分支划分，比较很便宜但不是默认比较器时使用，例如按pair的first比较
+template<typename RandomIt, typename Compare = std::less<>>
+void sort_branchless(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    pdqsort<true>(first, last, comp);
+}
+
+template<typename T, typename Allocator, typename Compare = std::less<>>
+void sort(vector<T, Allocator>& v, Compare comp = Compare()) {
+    ycstl::sort(v.data(), v.data() + v.size(), comp);
+}
+
+template<typename T, typename Allocator, typename Compare = std::less<>>
+void sort_branchless(vector<T, Allocator>& v, Compare comp = Compare()) {
+    ycstl::sort_branchless(v.data(), v.data() + v.size(), comp);
+}
+
+//两半分别排好后，左半搬到buffer里再合并回来；左半最后一个不大于右半第一个时不用合并
+template<typename Iter, typename T, typename Compare>
+void merge_sort(Iter first, Iter last, T* buffer, Compare& comp) {
+    auto n = last - first;
+    if (n <= decltype(n)(kSortMergeThreshold)) {
+        insertion_sort(first, last, comp);
+        return;
+    }
+    Iter middle = first + n / 2;
+    merge_sort(first, middle, buffer, comp);
+    merge_sort(middle, last, buffer, comp);
+    if (!comp(*middle, *(middle - 1))) {
+        return;
+    }
+    T* buffer_end = std::move(first, middle, buffer);
+    T* left = buffer;
+    Iter right = middle;
+    Iter out = first;
+    while (left != buffer_end && right != last) {
+        if (comp(*right, *left)) {
+            *out++ = std::move(*right++);
+        } else {
+            *out++ = std::move(*left++);
+        }
+    }
+    std::move(left, buffer_end, out);
+}
+
+//稳定排序；buffer为至少(last - first) / 2个已构造的元素，为nullptr时内部分配，此时T需要可默认构造
+template<typename RandomIt, typename Compare = std::less<>>
+void stable_sort(RandomIt first, RandomIt last, Compare comp = Compare(),
+                 typename std::iterator_traits<RandomIt>::value_type* buffer = nullptr) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    if (last - first < 2) {
+        return;
+    }
+    if (nullptr != buffer) {
+        merge_sort(first, last, buffer, comp);
+        return;
+    }
+    vector<T> scratch(static_cast<std::size_t>(last - first) / 2);
+    merge_sort(first, last, scratch.data(), comp);
+}
+
+template<typename T, typename Allocator, typename Compare = std::less<>>
+void stable_sort(vector<T, Allocator>& v, Compare comp = Compare(), T* buffer = nullptr) {
+    ycstl::stable_sort(v.data(), v.data() + v.size(), comp, buffer);
+}
+
+//把key映射成同样宽度的无符号整数，保持大小顺序：有符号数翻转符号位，
+//浮点数为负时所有位取反、为正时只翻转符号位；-0.0排在+0.0之前，NaN按位模式排在两端
+template<typename Key>
+constexpr auto radix_bits(Key key) noexcept {
+    static_assert(std::is_arithmetic_v<Key> && !std::is_same_v<Key, bool>, "radix key must be an integer or floating point number");
+    if constexpr (std::is_unsigned_v<Key>) {
+        return key;
+    } else if constexpr (std::is_integral_v<Key>) {
+        using U = std::make_unsigned_t<Key>;
+        return static_cast<U>(static_cast<U>(key) ^ (U(1) << (std::numeric_limits<U>::digits - 1)));
+    } else {
+        static_assert(sizeof(Key) == 4 || sizeof(Key) == 8, "only float and double keys are supported");
+        using U = std::conditional_t<sizeof(Key) == 4, std::uint32_t, std::uint64_t>;
+        U bits = std::bit_cast<U>(key);
+        U sign = U(1) << (std::numeric_limits<U>::digits - 1);
+        return static_cast<U>(0 != (bits & sign) ? ~bits : (bits | sign));
+    }
+}
+
+template<typename T, typename KeyFn>
+using RadixBits = decltype(radix_bits(std::declval<KeyFn&>()(std::declval<const T&>())));
+
+template<typename T, typename KeyFn>
+struct RadixLess {
+    KeyFn& key;
+
+    bool operator()(const T& a, const T& b) const {
+        return radix_bits(key(a)) < radix_bits(key(b));
+    }
+};
+
+//American flag sort：按shift处的字节计数，原地循环交换到各自的桶里，再对每个桶处理下一个字节
+template<typename T, typename KeyFn>
+void radix_sort_msd(T* first, T* last, KeyFn& key, int shift) {
+    std::size_t n = last - first;
+    if (n <= kRadixSortThreshold) {
+        RadixLess<T, KeyFn> less{key};
+        pdqsort<true>(first, last, less);
+        return;
+    }
+    auto digit = [&](const T& value) {
+        return static_cast<std::size_t>((radix_bits(key(value)) >> shift) & 0xff);
+    };
+    std::size_t counts[256] = {};
+    for (T* p = first; p != last; ++p) {
+        ++counts[digit(*p)];
+    }
+    //这个字节全都相同，直接看下一个字节
+    if (counts[digit(*first)] == n) {
+        if (0 != shift) {
+            radix_sort_msd(first, last, key, shift - 8);
+        }
+        return;
+    }
+    std::size_t heads[256];
+    std::size_t tails[256];
+    std::size_t sum = 0;
+    for (std::size_t b = 0; b != 256; ++b) {
+        heads[b] = sum;
+        sum += counts[b];
+        tails[b] = sum;
+    }
+    for (std::size_t b = 0; b != 256; ++b) {
+        while (heads[b] != tails[b]) {
+            std::size_t d = digit(first[heads[b]]);
+            if (d == b) {
+                ++heads[b];
+            } else {
+                std::swap(first[heads[b]], first[heads[d]++]);
+            }
+        }
+    }
+    if (0 == shift) {
+        return;
+    }
+    std::size_t begin = 0;
+    for (std::size_t b = 0; b != 256; ++b) {
+        if (counts[b] > 1) {
+            radix_sort_msd(first + begin, first + begin + counts[b], key, shift - 8);
+        }
+        begin += counts[b];
+    }
+}
+
+//原地、不稳定的基数排序，key(element)返回整数或浮点数
+template<typename T, typename KeyFn = identity_key>
+void radix_sort(T* first, T* last, KeyFn key = KeyFn()) {
+    if (last - first < 2 || std::is_sorted(first, last, RadixLess<T, KeyFn>{key})) {
+        return;
+    }
+    constexpr int kTopShift = int(sizeof(RadixBits<T, KeyFn>) * 8) - 8;
+    radix_sort_msd(first, last, key, kTopShift);
+}
+
+template<typename T, typename Allocator, typename KeyFn = identity_key>
+void radix_sort(vector<T, Allocator>& v, KeyFn key = KeyFn()) {
+    ycstl::radix_sort(v.data(), v.data() + v.size(), key);
+}
+
+//稳定的基数排序：一遍统计所有字节的直方图，再从低字节到高字节在原数组与buffer之间来回分发，
+//所有元素在某个字节上都相同时跳过这一遍；buffer为至少last - first个已构造的元素，
+//为nullptr时内部分配，此时T需要可默认构造
+template<typename T, typename KeyFn = identity_key>
+void stable_radix_sort(T* first, T* last, KeyFn key = KeyFn(), T* buffer = nullptr) {
+    using U = RadixBits<T, KeyFn>;
+    constexpr std::size_t kPasses = sizeof(U);
+    std::size_t n = last - first;
+    if (n < 2) {
+        return;
+    }
+    //已经有序时直接返回，通常在前几个元素就能发现无序
+    RadixLess<T, KeyFn> less{key};
+    if (n <= kRadixSortThreshold || std::is_sorted(first, last, less)) {
+        insertion_sort(first, last, less);
+        return;
+    }
+    vector<T> scratch;
+    if (nullptr == buffer) {
+        scratch.resize(n);
+        buffer = scratch.data();
+    }
+
+    std::size_t counts[kPasses][256] = {};
+    for (T* p = first; p != last; ++p) {
+        U bits = radix_bits(key(*p));
+        for (std::size_t pass = 0; pass != kPasses; ++pass) {
+            ++counts[pass][(bits >> (pass * 8)) & 0xff];
+        }
+    }
+
+    U first_bits = radix_bits(key(*first));
+    T* src = first;
+    T* dst = buffer;
+    for (std::size_t pass = 0; pass != kPasses; ++pass) {
+        std::size_t* count = counts[pass];
+        std::size_t shift = pass * 8;
+        if (count[(first_bits >> shift) & 0xff] == n) {
+            continue;
+        }
+        std::size_t offsets[256];
+        std::size_t sum = 0;
+        for (std::size_t b = 0; b != 256; ++b) {
+            offsets[b] = sum;
+            sum += count[b];
+        }
+        for (T* p = src; p != src + n; ++p) {
+            dst[offsets[(radix_bits(key(*p)) >> shift) & 0xff]++] = std::move(*p);
+        }
+        std::swap(src, dst);
+    }
+    if (src != first) {
+        std::move(src, src + n, first);
+    }
+}
+
+template<typename T, typename Allocator, typename KeyFn = identity_key>
+void stable_radix_sort(vector<T, Allocator>& v, KeyFn key = KeyFn(), T* buffer = nullptr) {
+    ycstl::stable_radix_sort(v.data(), v.data() + v.size(), key, buffer);
+}
+
+}   //ycstl
+
+#endif
@@ -0,0 +1,919 @@
+/**
+ * 实现string
+ * basic_string / string / small_string<N>
+ *
+ * 短字符串直接存放在对象内部，InlineCapacity可配置，默认23个char，对象仍然是24字节；
+ * 内部模式下最后一个字符位存放剩余容量，字符串写满时它恰好为0，兼作结尾的'\0'；
+ * 堆模式下这个位置写成全1作为标记，与容量字段重叠时容量只用剩下的位；
+ * 移动只是按字节拷贝对象本身，不分配也不逐个拷贝字符；
+ * resize_for_overwrite只改长度不初始化新字符，调用方随后通过data()写入；
+ * char版本的find和比较在有SSE2时每次比较16个字节，长范围交给memchr/memcmp
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef STRING_HPP_
+#define STRING_HPP_
+
+#include "memory.hpp"
+#include "memory_resource.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ycstl {
+
+//更长的范围交给libc的memchr/memcmp，它们按运行时的CPU选用更宽的向量指令；
+//内联的SSE2循环省掉的是短字符串上的函数调用
+constexpr std::size_t kStringLibcThreshold = 64;
+
+//第一个不同字符的下标，全部相同时返回n
+inline std::size_t string_mismatch(const char* a, const char* b, std::size_t n) noexcept {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^ 0xffffu;
+        if (0 != mask) {
+            return i + std::countr_zero(mask);
+        }
+    }
+#endif
+    for (; i != n && a[i] == b[i]; ++i) {
+    }
+    return i;
+}
+
+//按unsigned char比较，与std::char_traits<char>::compare一致
+inline int string_compare(const char* a, const char* b, std::size_t n) noexcept {
+    if (n >= kStringLibcThreshold) {
+        return std::memcmp(a, b, n);
+    }
+    std::size_t i = string_mismatch(a, b, n);
+    if (i == n) {
+        return 0;
+    }
+    return static_cast<unsigned char>(a[i]) < static_cast<unsigned char>(b[i]) ? -1 : 1;
+}
+
+//在s[0, n)中找字符c，找不到时返回n
+inline std::size_t string_find_char(const char* s, std::size_t n, char c) noexcept {
+    if (n >= kStringLibcThreshold) {
+        const void* p = std::memchr(s, c, n);
+        return nullptr == p ? n : static_cast<const char*>(p) - s;
+    }
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    __m128i target = _mm_set1_epi8(c);
+    for (; i + 16 <= n; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, target)));
+        if (0 != mask) {
+            return i + std::countr_zero(mask);
+        }
+    }
+#endif
+    for (; i != n && s[i] != c; ++i) {
+    }
+    return i;
+}
+
+//在s[0, n)中找长度为m(m >= 2)的needle，找不到时返回n；
+//每次取16个起点，同时比较needle的首尾字符，两者都相等的起点才逐字节比较中间部分
+inline std::size_t string_find(const char* s, std::size_t n, const char* needle, std::size_t m) noexcept {
+    if (m > n) {
+        return n;
+    }
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    __m128i first = _mm_set1_epi8(needle[0]);
+    __m128i last = _mm_set1_epi8(needle[m - 1]);
+    for (; i + m + 15 <= n; i += 16) {
+        __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+        __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(eq));
+        while (0 != mask) {
+            std::size_t offset = std::countr_zero(mask);
+            if (0 == std::memcmp(s + i + offset + 1, needle + 1, m - 2)) {
+                return i + offset;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i + m <= n; ++i) {
+        if (s[i] == needle[0] && s[i + m - 1] == needle[m - 1] && 0 == std::memcmp(s + i + 1, needle + 1, m - 2)) {
+            return i;
+        }
+    }
+    return n;
+}
+
+template<typename CharT, typename Traits = std::char_traits<CharT>, typename Allocator = std::allocator<CharT>,
+         std::size_t InlineCapacity = 24 / sizeof(CharT) - 1>
+class basic_string {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using UChar = std::make_unsigned_t<CharT>;
+
+    //char且使用默认traits时走上面的SSE2函数
+    static constexpr bool kByteString = std::is_same_v<CharT, char> && std::is_same_v<Traits, std::char_traits<char>>;
+
+    //堆模式：指针、长度、容量三个字
+    static_assert(sizeof(CharT*) == sizeof(std::size_t), "heap layout assumes pointer-sized words");
+    static constexpr std::size_t kWord = sizeof(std::size_t);
+    static constexpr std::size_t kHeapBytes = 3 * kWord;
+    static constexpr std::size_t kStorageBytes =
+        (std::max((InlineCapacity + 1) * sizeof(CharT), kHeapBytes) + kWord - 1) / kWord * kWord;
+    static constexpr std::size_t kStorageChars = kStorageBytes / sizeof(CharT);
+    static constexpr UChar kHeapMarker = UChar(~UChar(0));
+
+    //标记位与容量字段重叠时，容量只用剩下的位
+    static constexpr bool kMarkerInCapacity = kStorageBytes == kHeapBytes;
+    static constexpr int kMarkerShift = kMarkerInCapacity ? int(8 * sizeof(CharT)) : 0;
+
+public:
+    using traits_type            = Traits;
+    using value_type             = CharT;
+    using allocator_type         = Allocator;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using pointer                = CharT*;
+    using const_pointer          = const CharT*;
+    using iterator               = CharT*;
+    using const_iterator         = const CharT*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using view_type              = std::basic_string_view<CharT, Traits>;
+
+    static constexpr size_type npos = size_type(-1);
+
+    //对齐补齐后的实际内部容量，不小于InlineCapacity
+    static constexpr size_type inline_capacity = kStorageChars - 1;
+
+    static_assert(inline_capacity < size_type(kHeapMarker), "inline capacity must fit in the marker character");
+
+    basic_string() noexcept : basic_string(Allocator()) {}
+
+    explicit basic_string(const Allocator& alloc) noexcept : alloc_(alloc) {
+        set_inline_empty();
+    }
+
+    basic_string(const CharT* s, const Allocator& alloc = Allocator()) : basic_string(s, Traits::length(s), alloc) {}
+
+    basic_string(const CharT* s, size_type n, const Allocator& alloc = Allocator()) : basic_string(alloc) {
+        assign(s, n);
+    }
+
+    basic_string(size_type n, CharT c, const Allocator& alloc = Allocator()) : basic_string(alloc) {
+        assign(n, c);
+    }
+
+    //string_view等可以转换成view_type、但不是const CharT*的类型，显式构造
+    template<typename View, typename = std::enable_if_t<
+        std::is_convertible_v<const View&, view_type> && !std::is_convertible_v<const View&, const CharT*>
+    >>
+    explicit basic_string(const View& v, const Allocator& alloc = Allocator()) : basic_string(alloc) {
+        view_type sv = v;
+        assign(sv.data(), sv.size());
+    }
+
+    template<typename InputIter, typename = std::void_t<
+        decltype(*std::declval<InputIter>()),
+        decltype(++std::declval<InputIter&>())
+    >>
+    basic_string(InputIter first, InputIter last, const Allocator& alloc = Allocator()) : basic_string(alloc) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    basic_string(std::initializer_list<CharT> il, const Allocator& alloc = Allocator()) :
+    basic_string(il.begin(), il.size(), alloc) {}
+
+    //拷贝构造，分配器由select_on_container_copy_construction决定
+    basic_string(const basic_string& s) :
+    basic_string(s, AllocTraits::select_on_container_copy_construction(s.alloc_)) {}
+
+    basic_string(const basic_string& s, const Allocator& alloc) : basic_string(alloc) {
+        assign(s.data(), s.size());
+    }
+
+    basic_string(basic_string&& s) noexcept : alloc_(std::move(s.alloc_)) {
+        steal(s);
+    }
+
+    //分配器不相等时不能接管s的内存，只能拷贝字符
+    basic_string(basic_string&& s, const Allocator& alloc) : basic_string(alloc) {
+        if (alloc_ == s.alloc_) {
+            steal(s);
+        } else {
+            assign(s.data(), s.size());
+        }
+    }
+
+    ~basic_string() {
+        release_storage();
+    }
+
+    basic_string& operator=(const basic_string& s) {
+        if (this == &s) {
+            return *this;
+        }
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+            if (!(alloc_ == s.alloc_)) {
+                release_storage();
+                set_inline_empty();
+            }
+            alloc_ = s.alloc_;
+        }
+        return assign(s.data(), s.size());
+    }
+
+    //分配器传播或相等时直接接管s的内存，否则只能拷贝字符
+    basic_string& operator=(basic_string&& s) noexcept(AllocTraits::propagate_on_container_move_assignment::value ||
+                                                       AllocTraits::is_always_equal::value) {
+        if (this == &s) {
+            return *this;
+        }
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            release_storage();
+            alloc_ = std::move(s.alloc_);
+        } else if (!(alloc_ == s.alloc_)) {
+            return assign(s.data(), s.size());
+        } else {
+            release_storage();
+        }
+        steal(s);
+        return *this;
+    }
+
+    basic_string& operator=(const CharT* s) {
+        return assign(s, Traits::length(s));
+    }
+
+    basic_string& operator=(view_type v) {
+        return assign(v.data(), v.size());
+    }
+
+    basic_string& operator=(CharT c) {
+        return assign(1, c);
+    }
+
+    basic_string& operator=(std::initializer_list<CharT> il) {
+        return assign(il.begin(), il.size());
+    }
+
+    //s可以指向自己内部
+    basic_string& assign(const CharT* s, size_type n) {
+        if (n <= capacity()) {
+            Traits::move(data(), s, n);
+            set_size(n);
+            return *this;
+        }
+        CharT* p = allocate(n);
+        Traits::copy(p, s, n);
+        release_storage();
+        set_heap(p, n, n);
+        set_size(n);
+        return *this;
+    }
+
+    basic_string& assign(size_type n, CharT c) {
+        clear();
+        return append(n, c);
+    }
+
+    basic_string& assign(view_type v) {
+        return assign(v.data(), v.size());
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return alloc_;
+    }
+
+    reference at(size_type pos) {
+        if (pos >= size()) {
+            throw std::out_of_range("index out of range");
+        }
+        return data()[pos];
+    }
+
+    const_reference at(size_type pos) const {
+        if (pos >= size()) {
+            throw std::out_of_range("index out of range");
+        }
+        return data()[pos];
+    }
+
+    reference operator[](size_type pos) {
+        return data()[pos];
+    }
+
+    const_reference operator[](size_type pos) const {
+        return data()[pos];
+    }
+
+    reference front() {
+        return data()[0];
+    }
+
+    const_reference front() const {
+        return data()[0];
+    }
+
+    reference back() {
+        return data()[size() - 1];
+    }
+
+    const_reference back() const {
+        return data()[size() - 1];
+    }
+
+    CharT* data() noexcept {
+        return is_inline() ? inline_data() : heap_data();
+    }
+
+    const CharT* data() const noexcept {
+        return is_inline() ? inline_data() : heap_data();
+    }
+
+    const CharT* c_str() const noexcept {
+        return data();
+    }
+
+    operator view_type() const noexcept {
+        return view_type(data(), size());
+    }
+
+    iterator begin() noexcept {
+        return data();
+    }
+
+    const_iterator begin() const noexcept {
+        return data();
+    }
+
+    iterator end() noexcept {
+        return data() + size();
+    }
+
+    const_iterator end() const noexcept {
+        return data() + size();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    bool empty() const noexcept {
+        return 0 == size();
+    }
+
+    size_type size() const noexcept {
+        return is_inline() ? inline_capacity - marker() : load_word(1);
+    }
+
+    size_type length() const noexcept {
+        return size();
+    }
+
+    //容量不含结尾的'\0'
+    size_type capacity() const noexcept {
+        return is_inline() ? inline_capacity : heap_capacity();
+    }
+
+    size_type max_size() const noexcept {
+        size_type by_layout = ~size_type(0) >> (kMarkerShift + 1);
+        return std::min<size_type>(AllocTraits::max_size(alloc_) - 1, by_layout);
+    }
+
+    bool is_inline() const noexcept {
+        return kHeapMarker != marker();
+    }
+
+    void reserve(size_type new_cap) {
+        if (new_cap > capacity()) {
+            reallocate(new_cap);
+        }
+    }
+
+    //能放进内部时搬回内部，否则缩小到刚好
+    void shrink_to_fit() {
+        if (is_inline() || heap_capacity() == size()) {
+            return;
+        }
+        size_type n = size();
+        CharT* old = heap_data();
+        size_type old_cap = heap_capacity();
+        if (n <= inline_capacity) {
+            set_inline_empty();
+            Traits::copy(inline_data(), old, n);
+            set_size(n);
+        } else {
+            CharT* p = allocate(n);
+            Traits::copy(p, old, n);
+            set_heap(p, n, n);
+            set_size(n);
+        }
+        deallocate(old, old_cap);
+    }
+
+    void resize(size_type n) {
+        resize(n, CharT());
+    }
+
+    void resize(size_type n, CharT c) {
+        size_type old = size();
+        if (n > old) {
+            append(n - old, c);
+        } else {
+            set_size(n);
+        }
+    }
+
+    //只改变长度，新增的字符不初始化，调用方随后通过data()写入
+    void resize_for_overwrite(size_type n) {
+        reserve(n);
+        set_size(n);
+    }
+
+    void clear() noexcept {
+        set_size(0);
+    }
+
+    void push_back(CharT c) {
+        size_type n = size();
+        if (n == capacity()) {
+            reallocate(grow_capacity(n + 1));
+        }
+        data()[n] = c;
+        set_size(n + 1);
+    }
+
+    void pop_back() {
+        set_size(size() - 1);
+    }
+
+    //s可以指向自己内部：扩容时先拷贝再释放旧内存
+    basic_string& append(const CharT* s, size_type n) {
+        size_type old = size();
+        if (old + n <= capacity()) {
+            Traits::copy(data() + old, s, n);
+            set_size(old + n);
+            return *this;
+        }
+        size_type new_cap = grow_capacity(old + n);
+        CharT* p = allocate(new_cap);
+        Traits::copy(p, data(), old);
+        Traits::copy(p + old, s, n);
+        release_storage();
+        set_heap(p, old + n, new_cap);
+        set_size(old + n);
+        return *this;
+    }
+
+    basic_string& append(size_type n, CharT c) {
+        size_type old = size();
+        reserve_for(old + n);
+        Traits::assign(data() + old, n, c);
+        set_size(old + n);
+        return *this;
+    }
+
+    basic_string& append(view_type v) {
+        return append(v.data(), v.size());
+    }
+
+    basic_string& append(const CharT* s) {
+        return append(s, Traits::length(s));
+    }
+
+    basic_string& operator+=(view_type v) {
+        return append(v.data(), v.size());
+    }
+
+    basic_string& operator+=(const CharT* s) {
+        return append(s, Traits::length(s));
+    }
+
+    basic_string& operator+=(CharT c) {
+        push_back(c);
+        return *this;
+    }
+
+    basic_string& insert(size_type pos, const CharT* s, size_type n) {
+        size_type old = size();
+        if (pos > old) {
+            throw std::out_of_range("index out of range");
+        }
+        std::less<const CharT*> less;
+        if (!less(s, data()) && less(s, data() + old)) {
+            basic_string copy(s, n, alloc_);
+            return insert(pos, copy.data(), n);
+        }
+        reserve_for(old + n);
+        CharT* p = data();
+        Traits::move(p + pos + n, p + pos, old - pos);
+        Traits::copy(p + pos, s, n);
+        set_size(old + n);
+        return *this;
+    }
+
+    basic_string& insert(size_type pos, view_type v) {
+        return insert(pos, v.data(), v.size());
+    }
+
+    basic_string& erase(size_type pos = 0, size_type n = npos) {
+        size_type old = size();
+        if (pos > old) {
+            throw std::out_of_range("index out of range");
+        }
+        n = std::min(n, old - pos);
+        CharT* p = data();
+        Traits::move(p + pos, p + pos + n, old - pos - n);
+        set_size(old - n);
+        return *this;
+    }
+
+    void swap(basic_string& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        }
+        alignas(kWord) unsigned char tmp[kStorageBytes];
+        std::memcpy(tmp, raw_, kStorageBytes);
+        std::memcpy(raw_, other.raw_, kStorageBytes);
+        std::memcpy(other.raw_, tmp, kStorageBytes);
+    }
+
+    basic_string substr(size_type pos = 0, size_type n = npos) const {
+        size_type len = size();
+        if (pos > len) {
+            throw std::out_of_range("index out of range");
+        }
+        return basic_string(data() + pos, std::min(n, len - pos), alloc_);
+    }
+
+    size_type find(CharT c, size_type pos = 0) const noexcept {
+        size_type len = size();
+        if (pos >= len) {
+            return npos;
+        }
+        if constexpr (kByteString) {
+            size_type i = string_find_char(data() + pos, len - pos, c);
+            return i == len - pos ? npos : pos + i;
+        } else {
+            const CharT* p = Traits::find(data() + pos, len - pos, c);
+            return nullptr == p ? npos : size_type(p - data());
+        }
+    }
+
+    size_type find(view_type v, size_type pos = 0) const noexcept {
+        size_type len = size();
+        if (pos > len || v.size() > len - pos) {
+            return npos;
+        }
+        if (v.empty()) {
+            return pos;
+        }
+        if (1 == v.size()) {
+            return find(v[0], pos);
+        }
+        if constexpr (kByteString) {
+            size_type i = string_find(data() + pos, len - pos, v.data(), v.size());
+            return i == len - pos ? npos : pos + i;
+        } else {
+            return view_type(*this).find(v, pos);
+        }
+    }
+
+    size_type find(const CharT* s, size_type pos = 0) const noexcept {
+        return find(view_type(s), pos);
+    }
+
+    size_type rfind(CharT c, size_type pos = npos) const noexcept {
+        return view_type(*this).rfind(c, pos);
+    }
+
+    size_type rfind(view_type v, size_type pos = npos) const noexcept {
+        return view_type(*this).rfind(v, pos);
+    }
+
+    bool contains(view_type v) const noexcept {
+        return npos != find(v);
+    }
+
+    bool contains(CharT c) const noexcept {
+        return npos != find(c);
+    }
+
+    bool starts_with(view_type v) const noexcept {
+        return size() >= v.size() && equal_chars(data(), v.data(), v.size());
+    }
+
+    bool ends_with(view_type v) const noexcept {
+        size_type len = size();
+        return len >= v.size() && equal_chars(data() + len - v.size(), v.data(), v.size());
+    }
+
+    //小于0、等于0、大于0分别表示小于、等于、大于v
+    int compare(view_type v) const noexcept {
+        size_type len = size();
+        size_type n = std::min(len, v.size());
+        int r;
+        if constexpr (kByteString) {
+            r = string_compare(data(), v.data(), n);
+        } else {
+            r = Traits::compare(data(), v.data(), n);
+        }
+        if (0 != r) {
+            return r;
+        }
+        return len < v.size() ? -1 : (len > v.size() ? 1 : 0);
+    }
+
+    friend bool operator==(const basic_string& a, const basic_string& b) noexcept {
+        return a.size() == b.size() && equal_chars(a.data(), b.data(), a.size());
+    }
+
+    friend bool operator==(const basic_string& a, view_type b) noexcept {
+        return a.size() == b.size() && equal_chars(a.data(), b.data(), a.size());
+    }
+
+    friend bool operator==(const basic_string& a, const CharT* b) noexcept {
+        return a == view_type(b);
+    }
+
+    friend bool operator<(const basic_string& a, const basic_string& b) noexcept {
+        return a.compare(b) < 0;
+    }
+
+    friend bool operator>(const basic_string& a, const basic_string& b) noexcept {
+        return b < a;
+    }
+
+    friend bool operator<=(const basic_string& a, const basic_string& b) noexcept {
+        return !(b < a);
+    }
+
+    friend bool operator>=(const basic_string& a, const basic_string& b) noexcept {
+        return !(a < b);
+    }
+
+    friend basic_string operator+(const basic_string& a, const basic_string& b) {
+        basic_string result(AllocTraits::select_on_container_copy_construction(a.alloc_));
+        result.reserve(a.size() + b.size());
+        result.append(a.data(), a.size());
+        result.append(b.data(), b.size());
+        return result;
+    }
+
+    friend basic_string operator+(basic_string&& a, const basic_string& b) {
+        a.append(b.data(), b.size());
+        return std::move(a);
+    }
+
+    friend basic_string operator+(basic_string&& a, const CharT* b) {
+        a.append(b);
+        return std::move(a);
+    }
+
+    friend basic_string operator+(basic_string&& a, CharT b) {
+        a.push_back(b);
+        return std::move(a);
+    }
+
+    friend basic_string operator+(const basic_string& a, const CharT* b) {
+        return basic_string(a) + b;
+    }
+
+    friend basic_string operator+(const basic_string& a, CharT b) {
+        return basic_string(a) + b;
+    }
+
+    friend basic_string operator+(const CharT* a, const basic_string& b) {
+        basic_string result(a, AllocTraits::select_on_container_copy_construction(b.alloc_));
+        result.append(b.data(), b.size());
+        return result;
+    }
+
+private:
+    static bool equal_chars(const CharT* a, const CharT* b, size_type n) noexcept {
+        if constexpr (kByteString) {
+            return 0 == string_compare(a, b, n);
+        } else {
+            return 0 == Traits::compare(a, b, n);
+        }
+    }
+
+    CharT* inline_data() noexcept {
+        return reinterpret_cast<CharT*>(raw_);
+    }
+
+    const CharT* inline_data() const noexcept {
+        return reinterpret_cast<const CharT*>(raw_);
+    }
+
+    //最后一个字符位：内部模式下是剩余容量，堆模式下是kHeapMarker
+    UChar marker() const noexcept {
+        UChar m;
+        std::memcpy(&m, raw_ + kStorageBytes - sizeof(CharT), sizeof(CharT));
+        return m;
+    }
+
+    void set_marker(UChar m) noexcept {
+        std::memcpy(raw_ + kStorageBytes - sizeof(CharT), &m, sizeof(CharT));
+    }
+
+    std::size_t load_word(std::size_t i) const noexcept {
+        std::size_t w;
+        std::memcpy(&w, raw_ + i * kWord, kWord);
+        return w;
+    }
+
+    void store_word(std::size_t i, std::size_t w) noexcept {
+        std::memcpy(raw_ + i * kWord, &w, kWord);
+    }
+
+    CharT* heap_data() const noexcept {
+        CharT* p;
+        std::memcpy(&p, raw_, sizeof(p));
+        return p;
+    }
+
+    size_type heap_capacity() const noexcept {
+        size_type c = load_word(2);
+        if constexpr (kMarkerInCapacity) {
+            if constexpr (std::endian::native == std::endian::little) {
+                c &= ~size_type(0) >> kMarkerShift;
+            } else {
+                c >>= kMarkerShift;
+            }
+        }
+        return c;
+    }
+
+    void set_heap(CharT* p, size_type n, size_type cap) noexcept {
+        std::memcpy(raw_, &p, sizeof(p));
+        store_word(1, n);
+        if constexpr (kMarkerInCapacity && std::endian::native == std::endian::big) {
+            cap <<= kMarkerShift;
+        }
+        store_word(2, cap);
+        set_marker(kHeapMarker);
+    }
+
+    void set_inline_empty() noexcept {
+        std::memset(raw_, 0, kStorageBytes);
+        set_marker(UChar(inline_capacity));
+    }
+
+    //同时写入结尾的'\0'；内部模式下写满时'\0'就是值为0的标记
+    void set_size(size_type n) noexcept {
+        if (is_inline()) {
+            set_marker(UChar(inline_capacity - n));
+            inline_data()[n] = CharT();
+        } else {
+            store_word(1, n);
+            heap_data()[n] = CharT();
+        }
+    }
+
+    size_type grow_capacity(size_type needed) const {
+        if (needed > max_size()) {
+            throw std::length_error("string too long");
+        }
+        size_type doubled = capacity() > max_size() / 2 ? max_size() : 2 * capacity();
+        return std::max(needed, doubled);
+    }
+
+    void reserve_for(size_type needed) {
+        if (needed > capacity()) {
+            reallocate(grow_capacity(needed));
+        }
+    }
+
+    //多分配一个位置放'\0'
+    CharT* allocate(size_type cap) {
+        if (cap > max_size()) {
+            throw std::length_error("string too long");
+        }
+        return AllocTraits::allocate(alloc_, cap + 1);
+    }
+
+    void deallocate(CharT* p, size_type cap) noexcept {
+        AllocTraits::deallocate(alloc_, p, cap + 1);
+    }
+
+    void reallocate(size_type new_cap) {
+        size_type n = size();
+        CharT* p = allocate(new_cap);
+        Traits::copy(p, data(), n);
+        release_storage();
+        set_heap(p, n, new_cap);
+        set_size(n);
+    }
+
+    //只释放堆内存，对象处于需要重新设置的状态
+    void release_storage() noexcept {
+        if (!is_inline()) {
+            deallocate(heap_data(), heap_capacity());
+            set_inline_empty();
+        }
+    }
+
+    void steal(basic_string& s) noexcept {
+        std::memcpy(raw_, s.raw_, kStorageBytes);
+        s.set_inline_empty();
+    }
+
+private:
+    alignas(kWord) unsigned char raw_[kStorageBytes];
+    YCSTL_NO_UNIQUE_ADDRESS Allocator alloc_;
+};
+
+using string = basic_string<char>;
+using wstring = basic_string<wchar_t>;
+
+//内部容量至少为N个char的string
+template<std::size_t N>
+using small_string = basic_string<char, std::char_traits<char>, std::allocator<char>, N>;
+
+static_assert(sizeof(string) == 3 * sizeof(void*), "string must stay three words with a stateless allocator");
+static_assert(string::inline_capacity == 23, "string keeps 23 chars inline");
+
+namespace pmr {
+using string = ycstl::basic_string<char, std::char_traits<char>, polymorphic_allocator<char>>;
+}
+
+template<typename CharT, typename Traits, typename Allocator, std::size_t N>
+void swap(basic_string<CharT, Traits, Allocator, N>& a, basic_string<CharT, Traits, Allocator, N>& b) noexcept {
+    a.swap(b);
+}
+
+template<typename CharT, typename Traits, typename Allocator, std::size_t N>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os,
+                                              const basic_string<CharT, Traits, Allocator, N>& s) {
+    return os << std::basic_string_view<CharT, Traits>(s);
+}
+
+}   //ycstl
+
+//与std::basic_string_view的哈希一致，可以用string_view做异构查找
+namespace std {
+template<typename CharT, typename Traits, typename Allocator, std::size_t N>
+struct hash<ycstl::basic_string<CharT, Traits, Allocator, N>> {
+    std::size_t operator()(const ycstl::basic_string<CharT, Traits, Allocator, N>& s) const noexcept {
+        return hash<basic_string_view<CharT, Traits>>()(s);
+    }
+};
+}
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * arena的回归测试
+ *
+ * @author YC奕晨
+ * */
+
+#include "check.hpp"
+
+#include "arena.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+//256字节的块去掉16字节的块头后可用240字节
+constexpr std::size_t kBlock = 256;
+constexpr std::size_t kUsable = 240;
+
+//块里只剩4个字节时按128对齐分配，补齐越过块尾时曾经算出负的剩余空间，返回块外的地址而不申请新块
+template<typename Arena>
+void padding_past_end() {
+    Arena a(kBlock);
+    char* begin = static_cast<char*>(a.allocate(kUsable - 4, 1));
+    YCSTL_CHECK(kBlock == a.capacity());
+    char* p = static_cast<char*>(a.allocate(1, 128));
+    YCSTL_CHECK(0 == reinterpret_cast<std::uintptr_t>(p) % 128);
+    YCSTL_CHECK(a.capacity() > kBlock || p + 1 <= begin + kUsable);
+    std::memset(p, 0xab, 1);
+}
+
+}
+
+int main() {
+    padding_past_end<ycstl::arena>();
+    padding_past_end<ycstl::monotonic_arena>();
+    return ycstl::test::result();
+}
@@ -0,0 +1,39 @@
+/**
+ * 回归测试用的检查宏
+ *
+ * YCSTL_CHECK失败时打印文件、行号和表达式并记下失败，继续执行后面的检查；
+ * 每个*_test.cpp的main最后返回ycstl::test::result()，有失败时为1
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef TEST_CHECK_HPP_
+#define TEST_CHECK_HPP_
+
+#include <iostream>
+
+namespace ycstl {
+namespace test {
+
+inline int g_failures = 0;
+
+inline void report_failure(const char* file, int line, const char* expr) {
+    std::cerr << file << ":" << line << ": check failed: " << expr << "\n";
+    ++g_failures;
+}
+
+inline int result() {
+    if (0 != g_failures) {
+        std::cerr << g_failures << " check(s) failed\n";
+        return 1;
+    }
+    return 0;
+}
+
+}   //test
+}   //ycstl
+
+#define YCSTL_CHECK(expr) \
+    ((expr) ? (void)0 : ::ycstl::test::report_failure(__FILE__, __LINE__, #expr))
+
+#endif
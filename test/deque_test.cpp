@@ -0,0 +1,32 @@
+/**
+ * deque的回归测试
+ *
+ * @author YC奕晨
+ * */
+
+#include "check.hpp"
+
+#include "deque.hpp"
+
+namespace {
+
+//从未分配过的deque上做迭代器运算、erase和insert，node_为空时曾经崩溃
+void empty_deque() {
+    ycstl::deque<int> q;
+    q.erase(q.begin(), q.end());
+    YCSTL_CHECK(q.begin() + 0 == q.end());
+    YCSTL_CHECK(0 == q.end() - q.begin());
+    q.insert(q.begin(), 1);
+    YCSTL_CHECK(1 == q.size() && 1 == q.front());
+    q.erase(q.begin(), q.end());
+    q.clear();
+    q.erase(q.begin(), q.end());
+    YCSTL_CHECK(q.empty());
+}
+
+}
+
+int main() {
+    empty_deque();
+    return ycstl::test::result();
+}
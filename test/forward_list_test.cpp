@@ -0,0 +1,35 @@
+/**
+ * forward_list的回归测试
+ *
+ * @author YC奕晨
+ * */
+
+#include "check.hpp"
+
+#include "forward_list.hpp"
+#include "list.hpp"
+#include "vector.hpp"
+
+namespace {
+
+//元素经AllocTraits::construct构造，pmr元素拿到的是容器的资源而不是默认资源
+void uses_allocator_construction() {
+    ycstl::monotonic_buffer_resource resource;
+    ycstl::pmr::forward_list<ycstl::pmr::vector<int>> fl{ycstl::polymorphic_allocator<int>(&resource)};
+    fl.emplace_front();
+    fl.emplace_front(3, 7);
+    for (auto it = fl.begin(); it != fl.end(); ++it) {
+        YCSTL_CHECK(&resource == it->get_allocator().resource());
+    }
+
+    ycstl::pmr::list<ycstl::pmr::vector<int>> l{ycstl::polymorphic_allocator<int>(&resource)};
+    l.emplace_back();
+    YCSTL_CHECK(&resource == l.begin()->get_allocator().resource());
+}
+
+}
+
+int main() {
+    uses_allocator_construction();
+    return ycstl::test::result();
+}
@@ -0,0 +1,161 @@
+/**
+ * list的回归测试
+ *
+ * @author YC奕晨
+ * */
+
+#include "check.hpp"
+
+#include "list.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+//第fail_at次分配抛std::bad_alloc，之前的分配正常进行
+struct FailState {
+    std::size_t allocations = 0;
+    std::size_t fail_at = std::size_t(-1);
+};
+
+template<typename T>
+struct failing_allocator {
+    using value_type = T;
+
+    explicit failing_allocator(FailState* state) noexcept : state_(state) {}
+
+    template<typename U>
+    failing_allocator(const failing_allocator<U>& other) noexcept : state_(other.state_) {}
+
+    T* allocate(std::size_t n) {
+        if (++state_->allocations == state_->fail_at) {
+            throw std::bad_alloc();
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U>
+    bool operator==(const failing_allocator<U>& other) const noexcept {
+        return state_ == other.state_;
+    }
+
+    FailState* state_;
+};
+
+//拷贝构造在第fail_at次时抛异常，移动构造可能抛异常，relinearize会改用拷贝
+struct ThrowingCopy {
+    static inline int copies = 0;
+    static inline int fail_at = -1;
+
+    //list的哨兵节点需要默认构造
+    ThrowingCopy() = default;
+
+    explicit ThrowingCopy(std::string value) : value_(std::move(value)) {}
+
+    ThrowingCopy(const ThrowingCopy& other) : value_(other.value_) {
+        if (++copies == fail_at) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+
+    ThrowingCopy(ThrowingCopy&& other) : value_(std::move(other.value_)) {}
+
+    std::string value_;
+};
+
+std::vector<std::string> make_values() {
+    std::vector<std::string> values;
+    for (char c = 'a'; c != 'f'; ++c) {
+        values.push_back(std::string(32, c));
+    }
+    return values;
+}
+
+//值可以无异常移动时，曾经先移动了前几个值再在分配新节点时失败，这些值随新节点一起丢失
+void relinearize_allocation_failure() {
+    std::vector<std::string> values = make_values();
+    FailState state;
+    using List = ycstl::list<std::string, failing_allocator<std::string>>;
+    List l{failing_allocator<std::string>(&state)};
+    for (const std::string& value : values) {
+        l.push_back(value);
+    }
+    state.allocations = 0;
+    state.fail_at = 4;
+    bool thrown = false;
+    try {
+        l.relinearize();
+    } catch (const std::bad_alloc&) {
+        thrown = true;
+    }
+    YCSTL_CHECK(thrown);
+    YCSTL_CHECK(values.size() == l.size());
+    std::size_t i = 0;
+    for (auto it = l.begin(); it != l.end() && i != values.size(); ++it, ++i) {
+        YCSTL_CHECK(*it == values[i]);
+    }
+
+    state.fail_at = std::size_t(-1);
+    l.relinearize();
+    i = 0;
+    for (auto it = l.begin(); it != l.end() && i != values.size(); ++it, ++i) {
+        YCSTL_CHECK(*it == values[i]);
+    }
+}
+
+void relinearize_copy_failure() {
+    std::vector<std::string> values = make_values();
+    ycstl::list<ThrowingCopy> l;
+    for (const std::string& value : values) {
+        l.emplace_back(value);
+    }
+    ThrowingCopy::copies = 0;
+    ThrowingCopy::fail_at = 3;
+    bool thrown = false;
+    try {
+        l.relinearize();
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    ThrowingCopy::fail_at = -1;
+    YCSTL_CHECK(thrown);
+    YCSTL_CHECK(values.size() == l.size());
+    std::size_t i = 0;
+    for (auto it = l.begin(); it != l.end() && i != values.size(); ++it, ++i) {
+        YCSTL_CHECK(it->value_ == values[i]);
+    }
+}
+
+//remap按遍历顺序收到每一对新旧位置
+void relinearize_remap() {
+    ycstl::list<int> l;
+    for (int i = 0; i != 8; ++i) {
+        l.push_back(i);
+    }
+    int expected = 0;
+    bool ordered = true;
+    l.relinearize([&](ycstl::list<int>::const_iterator, ycstl::list<int>::iterator now) {
+        ordered = ordered && *now == expected;
+        ++expected;
+    });
+    YCSTL_CHECK(ordered);
+    YCSTL_CHECK(8 == expected);
+}
+
+}
+
+int main() {
+    relinearize_allocation_failure();
+    relinearize_copy_failure();
+    relinearize_remap();
+    return ycstl::test::result();
+}
@@ -0,0 +1,63 @@
+/**
+ * lru_cache的回归测试
+ *
+ * @author YC奕晨
+ * */
+
+#include "check.hpp"
+
+#include "lru_cache.hpp"
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+//第fail_at次调用时抛异常，模拟index_插入时失败
+struct FailingHash {
+    static inline int calls = 0;
+    static inline int fail_at = -1;
+
+    std::size_t operator()(int key) const {
+        if (++calls == fail_at) {
+            throw std::runtime_error("hash failed");
+        }
+        return std::hash<int>()(key);
+    }
+};
+
+//index_插入抛异常时，新条目曾经已经接到items_里，既不在index_中也没有计入weight_
+void put_index_failure() {
+    ycstl::lru_cache<int, std::string, FailingHash> cache(4);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    FailingHash::calls = 0;
+    FailingHash::fail_at = 2;        // put先find一次，第二次是index_的插入
+    bool thrown = false;
+    try {
+        cache.put(3, "three");
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    FailingHash::fail_at = -1;
+    YCSTL_CHECK(thrown);
+    YCSTL_CHECK(2 == cache.size());
+    YCSTL_CHECK(2 == cache.weight());
+    YCSTL_CHECK(!cache.contains(3));
+
+    //失败留下的空节点可以正常复用，淘汰顺序不受影响
+    cache.put(3, "three");
+    cache.put(4, "four");
+    cache.put(5, "five");
+    YCSTL_CHECK(4 == cache.size());
+    YCSTL_CHECK(!cache.contains(1));
+    YCSTL_CHECK(cache.get(5) && "five" == *cache.get(5));
+}
+
+}
+
+int main() {
+    put_index_failure();
+    return ycstl::test::result();
+}
@@ -0,0 +1,56 @@
+/**
+ * memory_resource的回归测试
+ *
+ * @author YC奕晨
+ * */
+
+#include "check.hpp"
+
+#include "memory_resource.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace {
+
+//记录从上游申请的次数
+class counting_resource : public ycstl::memory_resource {
+public:
+    std::size_t allocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        ++allocations;
+        return ycstl::new_delete_resource()->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        ycstl::new_delete_resource()->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const ycstl::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+//用户缓冲区只剩3个字节时按16对齐分配，补齐越过缓冲区末尾时曾经返回缓冲区外的地址
+void monotonic_padding_past_end() {
+    constexpr std::size_t kBuffer = 100;
+    std::unique_ptr<char[]> buffer(new char[kBuffer]);
+    counting_resource upstream;
+    ycstl::monotonic_buffer_resource resource(buffer.get(), kBuffer, &upstream);
+    char* a = static_cast<char*>(resource.allocate(97, 1));
+    YCSTL_CHECK(a == buffer.get());
+    char* b = static_cast<char*>(resource.allocate(8, 16));
+    YCSTL_CHECK(0 == reinterpret_cast<std::uintptr_t>(b) % 16);
+    YCSTL_CHECK(1 == upstream.allocations);
+    std::memset(b, 0xab, 8);
+}
+
+}
+
+int main() {
+    monotonic_padding_past_end();
+    return ycstl::test::result();
+}
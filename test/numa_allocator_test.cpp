@@ -0,0 +1,57 @@
+/**
+ * numa_resource的回归测试
+ *
+ * @author YC奕晨
+ * */
+
+#include "check.hpp"
+
+#include "list.hpp"
+#include "numa_allocator.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+//把一个区域切到只剩16个字节后按远大于区域对齐的64MiB对齐分配，补齐越过区域末尾时曾经返回区域外的地址
+void padding_past_region_end() {
+    constexpr std::size_t kAlign = std::size_t(64) << 20;
+    ycstl::numa_resource resource;
+    //区域头占16字节，16字节的块紧接其后
+    char* begin = static_cast<char*>(resource.allocate(16, 16)) - 16;
+    std::size_t mappings = resource.stats().mappings;
+    std::size_t length = resource.stats().bytes_mapped;
+    for (std::size_t i = 0; i != (length - 48) / 16; ++i) {
+        resource.allocate(16, 16);
+    }
+    YCSTL_CHECK(mappings == resource.stats().mappings);
+    char* p = static_cast<char*>(resource.allocate(8, kAlign));
+    YCSTL_CHECK(0 == reinterpret_cast<std::uintptr_t>(p) % kAlign);
+    YCSTL_CHECK(resource.stats().mappings > mappings || p + 8 <= begin + length);
+    std::memset(p, 0xab, 8);
+}
+
+//反复erase和插入的链表曾经每个新节点都切新内存，区域数随操作次数增长
+void churning_list_reuses_blocks() {
+    ycstl::numa_resource resource;
+    using Alloc = ycstl::numa_allocator<std::uint64_t>;
+    ycstl::list<std::uint64_t, Alloc> l{Alloc(&resource)};
+    for (std::uint64_t i = 0; i != 1024; ++i) {
+        l.push_back(i);
+    }
+    std::size_t mapped = resource.stats().bytes_mapped;
+    for (std::uint64_t i = 0; i != std::uint64_t(1) << 20; ++i) {
+        l.pop_front();
+        l.push_back(i);
+    }
+    YCSTL_CHECK(mapped == resource.stats().bytes_mapped);
+}
+
+}
+
+int main() {
+    padding_past_region_end();
+    churning_list_reuses_blocks();
+    return ycstl::test::result();
+}
@@ -0,0 +1,82 @@
+/**
+ * skip_list的回归测试
+ *
+ * @author YC奕晨
+ * */
+
+#include "check.hpp"
+
+#include "skip_list.hpp"
+
+#include <memory>
+#include <utility>
+
+namespace {
+
+//记录construct/destroy的调用次数；拷贝容器时select_on_container_copy_construction给出新的编号
+template<typename T>
+struct tracking_allocator {
+    using value_type = T;
+
+    explicit tracking_allocator(int id = 0) noexcept : id_(id) {}
+
+    template<typename U>
+    tracking_allocator(const tracking_allocator<U>& other) noexcept : id_(other.id_) {}
+
+    T* allocate(std::size_t n) {
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        ++constructed;
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    template<typename U>
+    void destroy(U* p) noexcept {
+        ++destroyed;
+        p->~U();
+    }
+
+    tracking_allocator select_on_container_copy_construction() const noexcept {
+        return tracking_allocator(id_ + 1);
+    }
+
+    template<typename U>
+    bool operator==(const tracking_allocator<U>&) const noexcept {
+        return true;
+    }
+
+    static inline int constructed = 0;
+    static inline int destroyed = 0;
+
+    int id_;
+};
+
+void allocator_construction() {
+    using Alloc = tracking_allocator<int>;
+    {
+        ycstl::skip_list<int, void, std::less<int>, Alloc> s;
+        for (int i = 0; i != 16; ++i) {
+            s.insert(i);
+        }
+        YCSTL_CHECK(16 == Alloc::constructed);
+
+        ycstl::skip_list<int, void, std::less<int>, Alloc> copy(s);
+        YCSTL_CHECK(1 == copy.get_allocator().id_);
+        YCSTL_CHECK(32 == Alloc::constructed);
+    }
+    YCSTL_CHECK(Alloc::constructed == Alloc::destroyed);
+}
+
+}
+
+int main() {
+    allocator_construction();
+    return ycstl::test::result();
+}
@@ -0,0 +1,58 @@
+/**
+ * ThreadRecordList的回归测试
+ *
+ * @author YC奕晨
+ * */
+
+#include "check.hpp"
+
+#include "epoch.hpp"
+#include "object_pool.hpp"
+#include "thread_record.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace {
+
+struct TestRecord {
+    std::atomic<bool> in_use_{true};
+    TestRecord* next_ = nullptr;
+};
+
+//反复创建销毁所有者时，本线程缓存里的条目曾经只增不减
+void cache_drops_dead_owners() {
+    std::thread([] {
+        for (int i = 0; i != 1000; ++i) {
+            ycstl::object_pool<int> pool;
+            pool.make(i);
+            ycstl::epoch_domain domain;
+            domain.pin();
+        }
+        YCSTL_CHECK(ycstl::thread_record_cache().entries_.size() <= 4);
+    }).join();
+}
+
+//交替访问两个所有者，各自拿到自己的记录，且每次都是同一条
+void alternating_owners() {
+    ycstl::ThreadRecordList<TestRecord> a;
+    ycstl::ThreadRecordList<TestRecord> b;
+    TestRecord* ra = a.local();
+    TestRecord* rb = b.local();
+    YCSTL_CHECK(ra != rb);
+    bool stable = true;
+    for (int i = 0; i != 100; ++i) {
+        stable = stable && a.local() == ra && b.local() == rb;
+    }
+    YCSTL_CHECK(stable);
+    YCSTL_CHECK(a.head() == ra && b.head() == rb);
+}
+
+}
+
+int main() {
+    cache_drops_dead_owners();
+    alternating_owners();
+    return ycstl::test::result();
+}
@@ -0,0 +1,203 @@
+/**
+ * 实现按线程分配的记录
+ * ThreadRecordList
+ *
+ * epoch_domain和object_pool共用：每个线程在每个所有者中一条记录，记录挂在所有者的无锁链表上；
+ * 线程第一次访问某个所有者时复用已退出线程留下的记录或新建一条，之后通过thread_local缓存找到它；
+ * 缓存按所有者id放在一张表里，前面有一个按id直接映射的小数组，交替访问几个所有者时也不用查表；
+ * 所有者销毁后，各线程在下一次查表未命中时清掉它的条目，缓存只随存活的所有者增长；
+ * 线程退出时只对仍然存活的所有者调用退出回调，已销毁的所有者直接跳过
+ *
+ * @author YC奕晨
+ * */
+
+#ifndef THREAD_RECORD_HPP_
+#define THREAD_RECORD_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ycstl {
+
+//记录存活的所有者，线程退出时只处理仍存活的所有者中的记录
+inline std::mutex& thread_record_registry_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline std::unordered_set<std::uint64_t>& thread_record_registry() {
+    static std::unordered_set<std::uint64_t> live;
+    return live;
+}
+
+//已关闭的所有者数，各线程据此判断缓存里是否有需要清理的条目
+inline std::atomic<std::uint64_t>& thread_record_closed() {
+    static std::atomic<std::uint64_t> closed(0);
+    return closed;
+}
+
+//本线程在各个所有者中的记录，所有Record类型共用一份
+struct ThreadRecordCache {
+    struct Entry {
+        void* owner_;
+        void* record_;
+        void (*on_exit_)(void* owner, void* record);
+    };
+
+    ~ThreadRecordCache() {
+        std::lock_guard<std::mutex> lock(thread_record_registry_mutex());
+        for (const auto& [id, entry] : entries_) {
+            if (thread_record_registry().count(id) != 0) {
+                entry.on_exit_(entry.owner_, entry.record_);
+            }
+        }
+    }
+
+    //有所有者关闭过时去掉已销毁所有者的条目
+    void prune() {
+        std::uint64_t closed = thread_record_closed().load(std::memory_order_acquire);
+        if (closed == seen_closed_) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(thread_record_registry_mutex());
+        for (auto it = entries_.begin(); it != entries_.end(); ) {
+            if (thread_record_registry().count(it->first) == 0) {
+                it = entries_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        seen_closed_ = closed;
+    }
+
+    std::unordered_map<std::uint64_t, Entry> entries_;
+    std::uint64_t seen_closed_ = 0;
+};
+
+//所有Record类型共用一个计数器，缓存里的id不会重复
+inline std::uint64_t thread_record_next_id() noexcept {
+    static std::atomic<std::uint64_t> id(0);
+    return id.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline ThreadRecordCache& thread_record_cache() {
+    thread_local ThreadRecordCache cache;
+    return cache;
+}
+
+//按id直接映射的快速路径，平凡类型的thread_local不需要初始化检查；
+//id不会复用，已销毁所有者留下的槽位不会再被命中
+struct ThreadRecordSlot {
+    std::uint64_t id_;
+    void* record_;
+};
+
+constexpr std::size_t kThreadRecordSlots = 8;
+
+inline ThreadRecordSlot& thread_record_slot(std::uint64_t id) noexcept {
+    thread_local ThreadRecordSlot slots[kThreadRecordSlots] = {
+        {~std::uint64_t(0), nullptr}, {~std::uint64_t(0), nullptr}, {~std::uint64_t(0), nullptr}, {~std::uint64_t(0), nullptr},
+        {~std::uint64_t(0), nullptr}, {~std::uint64_t(0), nullptr}, {~std::uint64_t(0), nullptr}, {~std::uint64_t(0), nullptr}};
+    return slots[id & (kThreadRecordSlots - 1)];
+}
+
+// Record需要有 std::atomic<bool> in_use_{true} 和 Record* next_ 两个成员
+template<typename Record>
+class ThreadRecordList {
+public:
+    //线程退出时在注册表的锁内调用，默认只把记录标记为空闲留给之后的线程
+    using exit_hook = void (*)(void* owner, void* record);
+
+    explicit ThreadRecordList(void* owner = nullptr, exit_hook on_exit = &release_record)
+        : head_(nullptr), id_(thread_record_next_id()), owner_(owner), on_exit_(on_exit) {
+        std::lock_guard<std::mutex> lock(thread_record_registry_mutex());
+        thread_record_registry().insert(id_);
+    }
+
+    ~ThreadRecordList() {
+        close();
+        Record* record = head_.load(std::memory_order_acquire);
+        while (nullptr != record) {
+            Record* next = record->next_;
+            delete record;
+            record = next;
+        }
+    }
+
+    ThreadRecordList(const ThreadRecordList&) = delete;
+    ThreadRecordList& operator=(const ThreadRecordList&) = delete;
+
+    //从注册表中移除，之后退出的线程不再回调；所有者析构时先调用，再处理记录中的数据
+    void close() noexcept {
+        std::lock_guard<std::mutex> lock(thread_record_registry_mutex());
+        if (0 != thread_record_registry().erase(id_)) {
+            thread_record_closed().fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    //遍历用，记录只增不减
+    Record* head() const noexcept {
+        return head_.load(std::memory_order_acquire);
+    }
+
+    //本线程的记录，命中直接映射的槽位时只比较一次id
+    Record* local() {
+        ThreadRecordSlot& slot = thread_record_slot(id_);
+        if (slot.id_ == id_) {
+            return static_cast<Record*>(slot.record_);
+        }
+        ThreadRecordCache& cache = thread_record_cache();
+        Record* record = nullptr;
+        auto it = cache.entries_.find(id_);
+        if (cache.entries_.end() != it) {
+            record = static_cast<Record*>(it->second.record_);
+        } else {
+            cache.prune();
+            record = acquire();
+            try {
+                cache.entries_.emplace(id_, ThreadRecordCache::Entry{owner_, record, on_exit_});
+            } catch (...) {
+                release_record(owner_, record);
+                throw;
+            }
+        }
+        slot.id_ = id_;
+        slot.record_ = record;
+        return record;
+    }
+
+private:
+    static void release_record(void*, void* record) noexcept {
+        static_cast<Record*>(record)->in_use_.store(false, std::memory_order_release);
+    }
+
+    //优先复用已退出线程留下的记录，否则新建并挂到链表头
+    Record* acquire() {
+        for (Record* record = head_.load(std::memory_order_acquire); nullptr != record; record = record->next_) {
+            bool expected = false;
+            if (!record->in_use_.load(std::memory_order_relaxed) &&
+                record->in_use_.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return record;
+            }
+        }
+        Record* record = new Record();
+        Record* head = head_.load(std::memory_order_relaxed);
+        do {
+            record->next_ = head;
+        } while (!head_.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+        return record;
+    }
+
+    std::atomic<Record*> head_;
+    std::uint64_t id_;
+    void* owner_;
+    exit_hook on_exit_;
+};
+
+}   //ycstl
+
+#endif
@@ -7,14 +7,22 @@
  #ifndef VECTOR_HPP_
  #define VECTOR_HPP_
  
+ #include "memory.hpp"
+ #include "memory_resource.hpp"
+ 
  #include <memory>
  #include <stdexcept>
  #include <type_traits>
  
  namespace ycstl {
  
+ template<typename E>
+ struct vector_expression;
+ 
  template<class T, class Allocator = std::allocator<T>>
  class vector{
+     using AllocTraits = std::allocator_traits<Allocator>;
+ 
  public:
      // 类型
      using value_type             = T;
@@ -31,23 +39,26 @@
      using const_reverse_iterator = std::reverse_iterator<const_iterator>;
   
      //构造
-     vector() noexcept : data_(nullptr), size_(0), capacity_(0 ) {
+     constexpr vector() noexcept : data_(nullptr), size_(0), capacity_(0 ) {
+     }
+ 
+     constexpr explicit vector(const Allocator& alloc) noexcept : data_(nullptr), size_(0), capacity_(0), alloc_(alloc) {
      }
      
-     vector(std::size_t n, const Allocator& alloc = Allocator()) : 
+     constexpr vector(std::size_t n, const Allocator& alloc = Allocator()) : 
      size_(n), capacity_(n), alloc_(std::move(alloc)) {
          data_ = alloc_.allocate(capacity_);
          for(size_t i = 0; i != n; i++) {
-             std::construct_at(&data_[i]);   //c++20
+             AllocTraits::construct(alloc_, &data_[i]);
          }
      }   
  
-     vector(std::size_t n, const T& value, const Allocator& alloc = Allocator()) : 
+     constexpr vector(std::size_t n, const T& value, const Allocator& alloc = Allocator()) : 
      size_(n), capacity_(n), alloc_(std::move(alloc)) {
          data_ = alloc_.allocate(capacity_);
          for (size_t i = 0; i != n; i++) {
              //new(&data_[i]) T(value);
-             std::construct_at(&data_[i],value); //c++20
+             AllocTraits::construct(alloc_, &data_[i],value);
          }
      }
  
@@ -55,118 +66,141 @@
          decltype(*std::declval<InputIt>()),
          decltype(++std::declval<InputIt&>())
      >>
-     vector(InputIt first, InputIt last, const Allocator& alloc = Allocator()) : 
+     constexpr vector(InputIt first, InputIt last, const Allocator& alloc = Allocator()) : 
      size_(last - first), capacity_(last - first), alloc_(std::move(alloc)) {
          data_ = alloc_.allocate(capacity_);
          std::size_t pos = 0;
          for (InputIt it = first; it != last; ++it, ++pos) {
-             std::construct_at(&data_[pos], *it);
+             AllocTraits::construct(alloc_, &data_[pos], *it);
          }
      }
  
-     vector( std::initializer_list<T> init, const Allocator& alloc = Allocator()) : 
+     constexpr vector( std::initializer_list<T> init, const Allocator& alloc = Allocator()) : 
      size_(init.size()), capacity_(init.size()), alloc_(std::move(alloc)) {
          data_ = alloc_.allocate(capacity_);
          std::size_t pos = 0;
          for (auto it = init.begin(); it != init.end(); ++it, ++pos) {
-             std::construct_at(&data_[pos],*it);
+             AllocTraits::construct(alloc_, &data_[pos],*it);
          }
      }
  
-     //拷贝构造
-     vector(const ycstl::vector<T>& v, const Allocator& alloc = Allocator()) : 
-     size_(v.size_), capacity_(v.capacity_), alloc_(std::move(alloc)) {
+     //numeric.hpp中的表达式，逐元素一次求值，不产生中间vector
+     template<typename E>
+     constexpr vector(const vector_expression<E>& e, const Allocator& alloc = Allocator()) : 
+     size_(e.size()), capacity_(e.size()), alloc_(alloc) {
+         data_ = 0 == capacity_ ? nullptr : alloc_.allocate(capacity_);
+         e.assign_to(data_);
+     }
+ 
+     //拷贝构造，分配器由select_on_container_copy_construction决定
+     constexpr vector(const vector& v) : vector(v, AllocTraits::select_on_container_copy_construction(v.alloc_)) {
+     }
+ 
+     constexpr vector(const vector& v, const Allocator& alloc) : 
+     size_(v.size_), capacity_(v.capacity_), alloc_(alloc) {
          data_ = alloc_.allocate(capacity_);
          for (std::size_t i = 0; i != size_; ++i) {
-             std::construct_at(&data_[i],v[i]);
+             AllocTraits::construct(alloc_, &data_[i],v[i]);
          }
      }
  
      //移动构造
-     vector(ycstl::vector<T>&& v, const Allocator& alloc = Allocator()) noexcept :
+     constexpr vector(vector&& v) noexcept :
      data_(v.data_), size_(v.size_), capacity_(v.capacity_), alloc_(std::move(v.alloc_)) {
          v.data_ = nullptr;
          v.size_ = 0;
          v.capacity_ = 0;
      }
  
-     ~vector(){
-         for (size_t i = 0; i != size_; ++i) {
-             std::destroy_at(&data_[i]);         //c++20
+     //分配器不相等时不能接管v的内存，逐个移动元素
+     constexpr vector(vector&& v, const Allocator& alloc) :
+     data_(nullptr), size_(0), capacity_(0), alloc_(alloc) {
+         if (alloc_ == v.alloc_) {
+             steal(v);
+         } else {
+             move_elements(v);
          }
-         alloc_.deallocate(data_, capacity_);
      }
  
-     vector<T>& operator=(const vector<T>& v) {
-         if (data_ == v.data_) {
+     constexpr ~vector(){
+         release_storage();
+     }
+ 
+     constexpr vector& operator=(const vector& v) {
+         if (this == &v) {
              return *this;
          }
-         if (this->data_) {
-             this->~vector();
+         release_storage();
+         if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+             alloc_ = v.alloc_;
          }
          size_ = v.size_;
          capacity_ = v.capacity_;
          data_ = alloc_.allocate(capacity_);
-         std::size_t pos = 0;
          for (std::size_t i = 0; i != size_; ++i) {
-             std::construct_at(&data_[i],v[i]);
+             AllocTraits::construct(alloc_, &data_[i],v[i]);
          }
          return *this;
      }
  
-     vector<T>& operator=(vector<T>&& v) {
-         if (data_ == v.data_) {
+     //分配器传播或相等时直接接管v的内存，否则只能在自己的分配器上逐个移动元素
+     constexpr vector& operator=(vector&& v) noexcept(AllocTraits::propagate_on_container_move_assignment::value ||
+                                            AllocTraits::is_always_equal::value) {
+         if (this == &v) {
              return *this;
          }
-         if (this->data_) {
-             this->~vector();
-         }
-         size_ = v.size_;
-         capacity_ = v.capacity_;
-         data_ = alloc_.allocate(capacity_);
-         std::size_t pos = 0;
-         for (std::size_t i = 0; i != size_; ++i) {
-             std::construct_at(&data_[i],v[i]);
+         release_storage();
+         if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+             alloc_ = std::move(v.alloc_);
+         } else if (!(alloc_ == v.alloc_)) {
+             move_elements(v);
+             v.release_storage();
+             return *this;
          }
-         v.size_ = v.capacity_ = 0;
-         v.data_ = nullptr;
+         steal(v);
          return *this;
      }
  
-     vector& operator=(std::initializer_list<value_type> ilist ){
-         if (this->data_) {
-             this->~vector();
-         }
+     constexpr vector& operator=(std::initializer_list<value_type> ilist ){
+         release_storage();
          size_ = capacity_ = ilist.size();
          data_ = alloc_.allocate(capacity_);
          std::size_t pos = 0;
          auto it = ilist.begin();
          for (std::size_t i = 0; i != size_; ++i, ++it) {
-             std::construct_at(&data_[i],*it);
+             AllocTraits::construct(alloc_, &data_[i],*it);
          }
          return *this;
      }
  
-     void assign(std::size_t n, const T& value) {
-         if (data_) {
-             this->~vector();
+     //长度不变时原地求值，表达式中出现*this也没关系，每个元素只读写同一下标
+     template<typename E>
+     constexpr vector& operator=(const vector_expression<E>& e) {
+         if (e.size() != size_) {
+             vector tmp(e, alloc_);
+             swap(tmp);
+             return *this;
          }
+         e.assign_to(data_);
+         return *this;
+     }
+ 
+     constexpr void assign(std::size_t n, const T& value) {
+         release_storage();
          size_ = capacity_ = n;
          data_ = alloc_.allocate(capacity_);
          for (std::size_t i = 0; i != size_; ++i) {
-             std::construct_at(&data_[i],value);
+             AllocTraits::construct(alloc_, &data_[i],value);
          }
      }
  
-     void assign(std::initializer_list<T> ilist) {
-         if (data_) {
-             this->~vector();
-         }
+     constexpr void assign(std::initializer_list<T> ilist) {
+         release_storage();
          size_ = capacity_ = ilist.size();
          data_ = alloc_.allocate(capacity_);
          std::size_t pos = 0;
          for (auto it = ilist.begin(); it != ilist.end(); ++it, ++pos) {
-             std::construct_at(&data_[pos],*it);
+             AllocTraits::construct(alloc_, &data_[pos],*it);
          }
      }
  
@@ -174,77 +208,75 @@
          decltype(*std::declval<InputIt>()),
          decltype(++std::declval<InputIt&>())
      >>
-     void assign(InputIt first, InputIt last) {
-         if (data_) {
-             this->~vector();
-         }
+     constexpr void assign(InputIt first, InputIt last) {
+         release_storage();
          size_ = capacity_ = last - first;
          data_ = alloc_.allocate(capacity_);
          std::size_t pos = 0;
          for (InputIt it = first; it != last; ++it, ++pos) {
-             std::construct_at(&data_[pos], *it);
+             AllocTraits::construct(alloc_, &data_[pos], *it);
          }
      }
  
-     T& operator[](const std::size_t& pos) {
+     constexpr T& operator[](const std::size_t& pos) {
          return data_[pos];
      }
  
-     const T& operator[](const std::size_t& pos) const {
+     constexpr const T& operator[](const std::size_t& pos) const {
          return data_[pos];
      }
  
-     T& at(const std::size_t& pos) {
+     constexpr T& at(const std::size_t& pos) {
          if (pos >= size_) {
              throw std::out_of_range("index out of range");
          }
          return data_[pos];
      }
  
-     const T& at(const std::size_t& pos) const {
+     constexpr const T& at(const std::size_t& pos) const {
          if (pos >= size_) {
              throw std::out_of_range("index out of range");
          }
          return data_[pos];
      }
  
-     T& front() {
+     constexpr T& front() {
          return data_[0];
      }
  
-     const T& front() const {
+     constexpr const T& front() const {
          return data_[0];
      }
  
-     T& back() {
+     constexpr T& back() {
          return data_[size_ - 1];
      }
  
-     const T& back() const {
+     constexpr const T& back() const {
          return data_[size_ - 1];
      }
  
-     T* data() {
+     constexpr T* data() {
          return data_;
      }
  
-     const T* data() const {
+     constexpr const T* data() const {
          return data_;
      }
  
-     std::size_t size() const {
+     constexpr std::size_t size() const {
          return size_;
      }
  
-     std::size_t capacity() const {
+     constexpr std::size_t capacity() const {
          return capacity_;
      }
  
-     bool empty() const {
+     constexpr bool empty() const {
          return size_ == 0;
      }
  
-     void reserve(std::size_t new_cap) {
+     constexpr void reserve(std::size_t new_cap) {
          if (new_cap <= capacity_) {
              return;
          }
@@ -253,7 +285,7 @@
          expand(new_cap);
      }
  
-     void shrink_to_fit() {
+     constexpr void shrink_to_fit() {
          if (size_ == capacity_) {
              return;
          }
@@ -261,100 +293,100 @@
  
          data_ = alloc_.allocate(size_);
          for (std::size_t i = 0; i != size_; ++i) {
-             std::construct_at(&data_[i], old_data[i]);
-             std::destroy_at(&old_data[i]);
+             AllocTraits::construct(alloc_, &data_[i], old_data[i]);
+             AllocTraits::destroy(alloc_, &old_data[i]);
          }
          alloc_.deallocate(old_data, capacity_);
          capacity_ = size_;
  
      }
  
-     T* begin() const {
+     constexpr T* begin() const {
          if (size_ == 0) {
              return nullptr;
          }
          return &data_[0];
      }
  
-     T* end() const {
+     constexpr T* end() const {
          if (size_ == 0) {
              return nullptr;
          }
          return &data_[size_];
      }
  
-     const T* cbegin() const {
+     constexpr const T* cbegin() const {
          if (size_ == 0) {
              return nullptr;
          }
          return &data_[0];
      }
  
-     const T* cend() const {
+     constexpr const T* cend() const {
          if (size_ == 0) {
              return nullptr;
          }
-         return std::reverse_iterator<iterator>(&data_[size_]);
+         return &data_[size_];
      }
  
-     reverse_iterator rbegin() {
+     constexpr reverse_iterator rbegin() {
          if (size_ == 0) {
              return std::reverse_iterator<iterator>(nullptr);
          }
          return std::reverse_iterator<iterator>(&data_[size_]);
      }
  
-     reverse_iterator rend() {
+     constexpr reverse_iterator rend() {
          if (size_ == 0) {
              return std::reverse_iterator<iterator>(nullptr);
          }
          return std::reverse_iterator<iterator>((&data_[0]));
      }
  
-     const_reverse_iterator rbegin() const {
+     constexpr const_reverse_iterator rbegin() const {
          if (size_ == 0) {
              return std::reverse_iterator<iterator>(nullptr);
          }
          return std::reverse_iterator<iterator>(&data_[size_]);
      }
  
-     const_reverse_iterator rend() const {
+     constexpr const_reverse_iterator rend() const {
          if (size_ == 0) {
              return std::reverse_iterator<iterator>(nullptr);
          }
          return std::reverse_iterator<iterator>((&data_[0]));
      }
  
-     const_reverse_iterator crbegin() const {
+     constexpr const_reverse_iterator crbegin() const {
          if (size_ == 0) {
              return std::reverse_iterator<iterator>(nullptr);
          }
          return std::reverse_iterator<const_iterator>(&data_[size_]);
      }
  
-     const_reverse_iterator crend() const {
+     constexpr const_reverse_iterator crend() const {
          if (size_ == 0) {
              return std::reverse_iterator<iterator>(nullptr);
          }
          return std::reverse_iterator<const_iterator>((&data_[0]));
      }
  
-     void clear() {
+     constexpr void clear() {
          for (size_t i = 0; i != size_; ++i) {
-             std::destroy_at(&data_[i]);         //c++20
+             AllocTraits::destroy(alloc_, &data_[i]);
          }
          size_ = 0;
      }
  
-     T* insert(const T* pos, const T& value) {
+     constexpr T* insert(const T* pos, const T& value) {
          std::size_t pos_i = pos - &data_[0];
          if (size_ == capacity_) {
              expand(2*capacity_);
          }
          if (pos_i == size_) {
-             std::construct_at(&data_[size_],value);
+             AllocTraits::construct(alloc_, &data_[size_],value);
          } else {
-             std::construct_at(&data_[size_],data_[size_-1]);
+             AllocTraits::construct(alloc_, &data_[size_],data_[size_-1]);
              std::size_t index = size_-1;
              for( ; index != pos_i; --index) {
                  data_[index] = data_[index-1];
@@ -365,15 +397,15 @@
          return &data_[pos_i];
      }
  
-     T* insert(const T* pos, T&& value) {
+     constexpr T* insert(const T* pos, T&& value) {
          std::size_t pos_i = pos - &data_[0];
          if (size_ == capacity_) {
              expand(2*capacity_);
          }
          if (pos_i == size_) {
-             std::construct_at(&data_[size_],value);
+             AllocTraits::construct(alloc_, &data_[size_],value);
          } else {
-             std::construct_at(&data_[size_],data_[size_-1]);
+             AllocTraits::construct(alloc_, &data_[size_],data_[size_-1]);
              std::size_t index = size_-1;
              for( ; index != pos_i; --index) {
                  data_[index] = data_[index-1];
@@ -384,7 +416,7 @@
          return &data_[pos_i];
      }
  
-     T* insert(const T* pos, std::size_t n, const T& value) {
+     constexpr T* insert(const T* pos, std::size_t n, const T& value) {
          std::size_t pos_i = pos - &data_[0];
          if (size_ + n > capacity_) {
              std::size_t new_cap = size_ + n > 2*capacity_ ? size_ + n : 2*capacity_;
@@ -392,20 +424,20 @@
          }
          if (pos_i == size_) {
              for (std::size_t i = 0; i < n; i++) {
-                 std::construct_at(&data_[size_ + i],value);
+                 AllocTraits::construct(alloc_, &data_[size_ + i],value);
              }
          } else {
              std::size_t index = size_ + n - 1;
              for ( ; index != pos_i + n - 1; --index) {
                  if (index >= size_) {
-                     std::construct_at(&data_[index],data_[index-n]);
+                     AllocTraits::construct(alloc_, &data_[index],data_[index-n]);
                  } else {
                      data_[index] = data_[index - n];
                  }
              }
              for (std::size_t i = pos_i; i <= index; ++i) {
                  if (i >= size_) {
-                     std::construct_at(&data_[i],value);
+                     AllocTraits::construct(alloc_, &data_[i],value);
                  } else {
                      data_[i] = value;
                  }
@@ -419,7 +451,7 @@
          decltype(*std::declval<InputIt>()),
          decltype(++std::declval<InputIt&>())
      >>
-     T* insert(const T* pos, InputIt first, InputIt last) {
+     constexpr T* insert(const T* pos, InputIt first, InputIt last) {
          std::size_t n = last - first;
          std::size_t pos_i = pos - &data_[0];
          if (size_ + n > capacity_) {
@@ -429,13 +461,13 @@
          if (pos_i == size_) {
              InputIt it = first;
              for (std::size_t i = 0; i < n; ++i, ++it) {
-                 std::construct_at(&data_[size_ + i],*it);
+                 AllocTraits::construct(alloc_, &data_[size_ + i],*it);
              }
          } else {
              std::size_t index = size_ + n - 1;
              for ( ; index != pos_i + n - 1; --index) {
                  if (index >= size_) {
-                     std::construct_at(&data_[index],data_[index-n]);
+                     AllocTraits::construct(alloc_, &data_[index],data_[index-n]);
                  } else {
                      data_[index] = data_[index - n];
                  }
@@ -443,7 +475,7 @@
              InputIt it = first;
              for (std::size_t i = pos_i; i <= index; ++i, ++it) {
                  if (i >= size_) {
-                     std::construct_at(&data_[i],*it);
+                     AllocTraits::construct(alloc_, &data_[i],*it);
                  } else {
                      data_[i] = *it;
                  }
@@ -453,20 +485,20 @@
          return &data_[pos_i]; 
      }
  
-     T* insert(const T* pos, std::initializer_list<T> ilist) {
+     constexpr T* insert(const T* pos, std::initializer_list<T> ilist) {
          return insert(pos, ilist.begin(), ilist.end()); 
      }
  
      template< class... Args >
-     T* emplace( const T* pos, Args&&... args) {
+     constexpr T* emplace( const T* pos, Args&&... args) {
          std::size_t pos_i = pos - &data_[0];
          if (size_ == capacity_) {
              expand(2*capacity_);
          }
          if (pos_i == size_) {
-             std::construct_at(&data_[size_],T(std::forward<Args>(args)...));
+             AllocTraits::construct(alloc_, &data_[size_],T(std::forward<Args>(args)...));
          } else {
-             std::construct_at(&data_[size_],data_[size_-1]);
+             AllocTraits::construct(alloc_, &data_[size_],data_[size_-1]);
              std::size_t index = size_-1;
              for( ; index != pos_i; --index) {
                  data_[index] = data_[index-1];
@@ -477,82 +509,82 @@
          return &data_[pos_i];
      } 
  
-     iterator erase(iterator pos ) {
+     constexpr iterator erase(iterator pos ) {
          for (auto it = pos; it != end()-1; ++it) {
              *it = *(it + 1);
          }
-         std::destroy_at(&data_[size_-1]);
+         AllocTraits::destroy(alloc_, &data_[size_-1]);
          size_--;
          return pos;
      }
  
-     iterator erase( const_iterator pos ) {
+     constexpr iterator erase( const_iterator pos ) {
          for (auto it = pos; it != end()-1; ++it) {
              *it = *(it + 1);
          }
-         std::destroy_at(&data_[size_-1]);
+         AllocTraits::destroy(alloc_, &data_[size_-1]);
          size_--;
          return pos;
      }
  
-     iterator erase( iterator first, iterator last ) {
+     constexpr iterator erase( iterator first, iterator last ) {
          T* start = first;
          T* it = last;
          for (; it != end(); ++it, ++start) {
              *start = *it;
          }
          for(; start != end(); ++start) {
-             std::destroy_at(start);
+             AllocTraits::destroy(alloc_, start);
          }
          size_ -= (last - first);
          return first;
      }
  
-     iterator erase( const_iterator first, const_iterator last ) {
+     constexpr iterator erase( const_iterator first, const_iterator last ) {
          T* start = first;
          T* it = last;
          for (; it != end(); ++it, ++start) {
              *start = *it;
          }
          for(; start != end(); ++start) {
-             std::destroy_at(start);
+             AllocTraits::destroy(alloc_, start);
          }
          size_ -= (last - first);
          return first;
      }
  
-     void push_back( const T& value ) {
+     constexpr void push_back( const T& value ) {
          if (size_ == capacity_) {
              expand(1 > 2*capacity_ ? 1 : 2*capacity_);
          }
-         std::construct_at(&data_[size_],value);
+         AllocTraits::construct(alloc_, &data_[size_],value);
          size_++;
      }
  
-     void push_back( T&& value ) {
+     constexpr void push_back( T&& value ) {
          if (size_ == capacity_) {
              expand(1 > 2*capacity_ ? 1 : 2*capacity_);
          }
-         std::construct_at(&data_[size_],std::move(value));
+         AllocTraits::construct(alloc_, &data_[size_],std::move(value));
          size_++;
      }
  
      template< class... Args >
-     void emplace_back( Args&&... args ) {
+     constexpr void emplace_back( Args&&... args ) {
          if (size_ == capacity_) {
              expand(1 > 2*capacity_ ? 1 : 2*capacity_);
          }
-         std::construct_at(&data_[size_],T(std::forward<Args>(args)...));
+         AllocTraits::construct(alloc_, &data_[size_],T(std::forward<Args>(args)...));
          size_++;
      }
  
-     void pop_back() {
-         std::destroy_at(&data_[size_ - 1]);
+     constexpr void pop_back() {
+         AllocTraits::destroy(alloc_, &data_[size_ - 1]);
          size_--;
      }
  
      
-     void resize(std::size_t count) {
+     constexpr void resize(std::size_t count) {
          if (count == size_) {
              return;
          } else if (count > size_) {
@@ -560,18 +592,18 @@
                  expand(count > 2*capacity_ ? count : 2*capacity_);
              }
              while (size_ != count) {
-                 std::construct_at(&data_[size_], T());
+                 AllocTraits::construct(alloc_, &data_[size_], T());
                  size_++;
              }
              return;
          }
          while (size_ != count) {
-             std::destroy_at(&data_[size_-1]);
+             AllocTraits::destroy(alloc_, &data_[size_-1]);
              size_--;
          }
      }
  
-     void resize(std::size_t count, const T& value) {
+     constexpr void resize(std::size_t count, const T& value) {
          if (count == size_) {
              return;
          } else if (count > size_) {
@@ -579,18 +611,26 @@
                  expand(count > 2*capacity_ ? count : 2*capacity_);
              }
              while (size_ != count) {
-                 std::construct_at(&data_[size_], value);
+                 AllocTraits::construct(alloc_, &data_[size_], value);
                  size_++;
              }
              return;
          }
          while (size_ != count) {
-             std::destroy_at(&data_[size_-1]);
+             AllocTraits::destroy(alloc_, &data_[size_-1]);
              size_--;
          }
      }
  
-     void swap(vector<T>& other) {
+     constexpr allocator_type get_allocator() const noexcept {
+         return alloc_;
+     }
+ 
+     //propagate_on_container_swap为false时两个分配器必须相等
+     constexpr void swap(vector& other) noexcept {
+         if constexpr (AllocTraits::propagate_on_container_swap::value) {
+             std::swap(alloc_, other.alloc_);
+         }
          auto old_data = data_;
          auto old_size = size_;
          auto old_cap = capacity_;
@@ -607,7 +647,7 @@
  
  private:
      //辅助扩容函数，扩容到指定大小
-     void expand(std::size_t new_cap) {
+     constexpr void expand(std::size_t new_cap) {
          if (new_cap <= capacity_) {
              return;
          }
@@ -617,18 +657,62 @@
  
          capacity_ = new_cap;
          for(std::size_t i = 0; i != size_; ++i) {
-             std::construct_at(&data_[i], old_data[i]);
-             std::destroy_at(&old_data[i]);
+             AllocTraits::construct(alloc_, &data_[i], old_data[i]);
+             AllocTraits::destroy(alloc_, &old_data[i]);
+         }
+         if (nullptr != old_data) {
+             alloc_.deallocate(old_data,old_cap);
+         }
+     }
+ 
+     //析构所有元素并归还内存，之后是一个空的vector
+     constexpr void release_storage() noexcept {
+         for (size_t i = 0; i != size_; ++i) {
+             AllocTraits::destroy(alloc_, &data_[i]);
+         }
+         if (nullptr != data_) {
+             alloc_.deallocate(data_, capacity_);
+         }
+         data_ = nullptr;
+         size_ = 0;
+         capacity_ = 0;
+     }
+ 
+     constexpr void steal(vector& v) noexcept {
+         data_ = v.data_;
+         size_ = v.size_;
+         capacity_ = v.capacity_;
+         v.data_ = nullptr;
+         v.size_ = 0;
+         v.capacity_ = 0;
+     }
+ 
+     //在自己的分配器上移动构造v的元素，v保留已被移动的元素
+     constexpr void move_elements(vector& v) {
+         if (0 == v.size_) {
+             return;
          }
-         alloc_.deallocate(old_data,old_cap);
+         data_ = alloc_.allocate(v.size_);
+         capacity_ = v.size_;
+         for (std::size_t i = 0; i != v.size_; ++i) {
+             AllocTraits::construct(alloc_, &data_[i], std::move(v.data_[i]));
+         }
+         size_ = v.size_;
      }
  
      T* data_;
      std::size_t size_;
      std::size_t capacity_;
-     Allocator alloc_;
+     YCSTL_NO_UNIQUE_ADDRESS Allocator alloc_;
  };
  
+ static_assert(sizeof(vector<int>) == 3 * sizeof(int*), "stateless allocator must not enlarge vector");
+ 
+ namespace pmr {
+ template<class T>
+ using vector = ycstl::vector<T, polymorphic_allocator<T>>;
+ }
+ 
  //输出vector，方便测试
  template <typename T>
  std::ostream& operator<<(std::ostream& os, const ycstl::vector<T>& v) {